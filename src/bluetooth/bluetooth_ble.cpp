@@ -28,6 +28,7 @@ extern "C" bool btInUse() { return true; }
 #include "nimble/nimble_port.h"
 #include "nimble/nimble_port_freertos.h"
 #include "host/ble_hs.h"
+#include "os/os_mbuf.h"
 #include "host/util/util.h"
 #include "store/config/ble_store_config.h"
 #include "services/gap/ble_svc_gap.h"
@@ -426,6 +427,14 @@ size_t BluetoothBLE::write(const uint8_t* data, size_t len) {
     return totalSent;
 }
 
+// Notify chunks come from the msys mbuf pool - write() stops short once it runs out.
+// Count two blocks per chunk: payload plus the ATT/L2CAP header leading space.
+size_t BluetoothBLE::availableForWrite() const {
+    if (!initialized || !connected || txAttrHandle == 0) return 0;
+    int freeBlocks = os_msys_num_free();
+    return (freeBlocks >= 2) ? (size_t)(freeBlocks / 2) * BLE_TX_MTU_SIZE : 0;
+}
+
 size_t BluetoothBLE::write(const char* str) {
     return write((const uint8_t*)str, strlen(str));
 }
@@ -38,6 +38,7 @@ public:
     // Data transmission (ESP → client via notify)
     size_t write(const uint8_t* data, size_t len);
     size_t write(const char* str);
+    size_t availableForWrite() const;  // Bytes write() can take now without a short count
 
     // Data reception (client → ESP)
     size_t available();
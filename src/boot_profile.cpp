@@ -0,0 +1,183 @@
+#include "boot_profile.h"
+#include "crashlog.h"
+#include "logging.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+
+#define BOOT_PROFILE_MAGIC  (0x42505246 ^ BOOT_PHASE_COUNT)   // "BPRF", changes with the phase list
+
+static const char* const PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "early", "littlefs", "crashlog", "config_snapshot", "config_json",
+    "devices", "pins", "wifi_detect", "bluetooth", "scheduler",
+    "wifi_start", "uart_dma", "usb", "uart_init", "udp", "web_server",
+    "tasks", "setup_done", "bridge_start", "buffers", "pipeline",
+};
+
+struct BootRecord {
+    uint32_t bootNumber;            // Counts up while the RTC history survives
+    uint8_t resetReason;            // esp_reset_reason_t
+    uint8_t reserved[3];
+    uint32_t endUs[BOOT_PHASE_COUNT];   // 0 = phase not reached this boot
+};
+
+struct BootHistory {
+    uint32_t magic;
+    uint32_t count;                 // Stored records (<= BOOT_PROFILE_HISTORY)
+    uint32_t next;                  // Ring slot for the next boot
+    BootRecord records[BOOT_PROFILE_HISTORY];
+    uint32_t crc;                   // CRC32 of everything above
+};
+
+// RTC memory (survives software reset, random after power-on - see magic/CRC)
+RTC_NOINIT_ATTR static BootHistory s_history;
+
+// This boot, kept in RAM until boot_profile_finish()
+static BootRecord s_current;
+static volatile bool s_finished = false;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t historyCrc() {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&s_history),
+                            offsetof(BootHistory, crc));
+}
+
+static bool historyValid() {
+    return s_history.magic == BOOT_PROFILE_MAGIC &&
+           s_history.count <= BOOT_PROFILE_HISTORY &&
+           s_history.next < BOOT_PROFILE_HISTORY &&
+           s_history.crc == historyCrc();
+}
+
+// Phases of a record in the order they ended
+static size_t sortedPhases(const BootRecord& r, uint8_t* order) {
+    size_t n = 0;
+    for (uint8_t p = 0; p < BOOT_PHASE_COUNT; p++) {
+        if (!r.endUs[p]) continue;
+        size_t pos = n++;
+        while (pos > 0 && r.endUs[order[pos - 1]] > r.endUs[p]) {
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = p;
+    }
+    return n;
+}
+
+void boot_profile_mark(BootPhase phase) {
+    if (s_finished || phase >= BOOT_PHASE_COUNT) return;
+
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    if (!s_current.endUs[phase]) {
+        s_current.endUs[phase] = now ? now : 1;
+    }
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void boot_profile_finish() {
+    if (s_finished) return;
+    boot_profile_mark(BOOT_PHASE_PIPELINE);
+
+    portENTER_CRITICAL(&s_mux);
+    s_finished = true;
+
+    if (!historyValid()) {
+        memset(&s_history, 0, sizeof(s_history));
+        s_history.magic = BOOT_PROFILE_MAGIC;
+    }
+
+    uint32_t lastNumber = 0;
+    if (s_history.count > 0) {
+        uint32_t last = (s_history.next + BOOT_PROFILE_HISTORY - 1) % BOOT_PROFILE_HISTORY;
+        lastNumber = s_history.records[last].bootNumber;
+    }
+    s_current.bootNumber = lastNumber + 1;
+    s_current.resetReason = (uint8_t)esp_reset_reason();
+
+    s_history.records[s_history.next] = s_current;
+    s_history.next = (s_history.next + 1) % BOOT_PROFILE_HISTORY;
+    if (s_history.count < BOOT_PROFILE_HISTORY) s_history.count++;
+    s_history.crc = historyCrc();
+    portEXIT_CRITICAL(&s_mux);
+
+    // Summary: total and the three slowest phases
+    uint8_t order[BOOT_PHASE_COUNT];
+    size_t n = sortedPhases(s_current, order);
+    uint8_t slowest[3] = {0, 0, 0};
+    uint32_t slowestUs[3] = {0, 0, 0};
+    uint32_t prev = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t us = s_current.endUs[order[i]] - prev;
+        prev = s_current.endUs[order[i]];
+        for (int k = 0; k < 3; k++) {
+            if (us <= slowestUs[k]) continue;
+            for (int m = 2; m > k; m--) {
+                slowestUs[m] = slowestUs[m - 1];
+                slowest[m] = slowest[m - 1];
+            }
+            slowestUs[k] = us;
+            slowest[k] = order[i];
+            break;
+        }
+    }
+
+    log_msg(LOG_INFO, "Boot #%u: bridge ready after %lu ms (slowest: %s %lu ms, %s %lu ms, %s %lu ms)",
+            (unsigned)s_current.bootNumber, (unsigned long)(prev / 1000),
+            PHASE_NAMES[slowest[0]], (unsigned long)(slowestUs[0] / 1000),
+            PHASE_NAMES[slowest[1]], (unsigned long)(slowestUs[1] / 1000),
+            PHASE_NAMES[slowest[2]], (unsigned long)(slowestUs[2] / 1000));
+}
+
+static void recordToJson(JsonObject obj, const BootRecord& r) {
+    uint8_t order[BOOT_PHASE_COUNT];
+    size_t n = sortedPhases(r, order);
+
+    obj["reset_reason"] = crashlog_get_reset_reason_string((esp_reset_reason_t)r.resetReason);
+    obj["total_us"] = n ? r.endUs[order[n - 1]] : 0;
+
+    JsonArray phases = obj["phases"].to<JsonArray>();
+    uint32_t prev = 0;
+    for (size_t i = 0; i < n; i++) {
+        JsonObject p = phases.add<JsonObject>();
+        p["name"] = PHASE_NAMES[order[i]];
+        p["end_us"] = r.endUs[order[i]];
+        p["us"] = r.endUs[order[i]] - prev;
+        prev = r.endUs[order[i]];
+    }
+}
+
+void boot_profile_to_json(JsonDocument& doc) {
+    BootRecord current;
+    BootRecord stored[BOOT_PROFILE_HISTORY];
+    size_t count = 0;
+    bool finished;
+
+    portENTER_CRITICAL(&s_mux);
+    finished = s_finished;
+    current = s_current;
+    if (finished) {
+        // Newest first; this boot is the newest stored record
+        for (size_t i = 0; i < s_history.count; i++) {
+            size_t slot = (s_history.next + BOOT_PROFILE_HISTORY - 1 - i) % BOOT_PROFILE_HISTORY;
+            stored[count++] = s_history.records[slot];
+        }
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    doc["complete"] = finished;
+    JsonArray boots = doc["boots"].to<JsonArray>();
+
+    if (!finished) {
+        // Still booting - history is only validated when this boot is stored
+        JsonObject obj = boots.add<JsonObject>();
+        obj["boot"] = nullptr;
+        recordToJson(obj, current);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        JsonObject obj = boots.add<JsonObject>();
+        obj["boot"] = stored[i].bootNumber;
+        recordToJson(obj, stored[i]);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Boot phase profiler
+// Each boot_profile_mark() records when a phase ended (esp_timer, us since app
+// start - ROM/bootloader time is not included). boot_profile_finish() is called
+// once the bridge task is ready to move data: the boot is then stored in RTC
+// memory (survives software resets, not power loss) next to the previous
+// BOOT_PROFILE_HISTORY - 1 boots, and marks become no-ops.
+
+// Phases in typical order (network mode starts WiFi before the common devices).
+// Append only - the value is stored in RTC memory across firmware updates.
+enum BootPhase : uint8_t {
+    BOOT_PHASE_EARLY = 0,       // setup() start to logging ready
+    BOOT_PHASE_LITTLEFS,        // Filesystem mount (incl. format)
+    BOOT_PHASE_CRASHLOG,        // Crash check
+    BOOT_PHASE_CONFIG_SNAPSHOT, // config_load() from the NVS snapshot
+    BOOT_PHASE_CONFIG_JSON,     // config_load() from /config.json
+    BOOT_PHASE_DEVICES,         // Config validation, device summary
+    BOOT_PHASE_PINS,            // Pins and LEDs
+    BOOT_PHASE_WIFI_DETECT,     // WiFi mode / quick reset detection
+    BOOT_PHASE_BLUETOOTH,       // Device5 SPP/BLE init
+    BOOT_PHASE_SCHEDULER,       // TaskScheduler init
+    BOOT_PHASE_WIFI_START,      // WiFi driver init and AP/client start
+    BOOT_PHASE_UART_DMA,        // Device1 UART DMA interface
+    BOOT_PHASE_USB,             // Device2 USB host/device
+    BOOT_PHASE_UART_INIT,       // Main UART driver configuration
+    BOOT_PHASE_UDP,             // Device4 UDP transport / TCP server
+    BOOT_PHASE_WEB_SERVER,      // Web server start
+    BOOT_PHASE_TASKS,           // FreeRTOS task creation
+    BOOT_PHASE_SETUP_DONE,      // End of setup()
+    BOOT_PHASE_BRIDGE_START,    // Bridge task start delay
+    BOOT_PHASE_BUFFERS,         // Bridge context and protocol buffers
+    BOOT_PHASE_PIPELINE,        // Protocol pipeline - bridge ready
+    BOOT_PHASE_COUNT
+};
+
+#define BOOT_PROFILE_HISTORY    4   // Boots kept in RTC memory (including this one)
+
+// Record the end of a phase (first call per phase counts, any task)
+void boot_profile_mark(BootPhase phase);
+
+// Mark BOOT_PHASE_PIPELINE, store this boot in RTC memory and log a summary
+void boot_profile_finish();
+
+// This boot and the stored history, newest first (GET /api/boot)
+void boot_profile_to_json(JsonDocument& doc);
+
+#endif // BOOT_PROFILE_H
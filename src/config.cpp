@@ -1,6 +1,11 @@
 #include "config.h"
+#include "config_snapshot.h"
+#include "boot_profile.h"
 #include "logging.h"
 #include "defines.h"
+#include "protocols/sbus_common.h"
+#include "protocols/sbus_udp_envelope.h"
+#include "protocols/rc_text_format.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 #include <Preferences.h>
@@ -129,6 +134,11 @@ void config_init(Config* config) {
     config->device4_config.udpSourceTimeout = 1000;  // Default 1 second
     config->device4_config.udpSendRate = 50;  // Default 50 Hz
     config->device4_config.crsfFilter = CRSF_FILTER_ALL;
+    config->device4_config.sbusEnvelope = false;
+    config->device4_config.sbusRedundancy = 0;
+    config->device4_config.learn_peers = false;
+    config->device4_config.transport = D4_TRANSPORT_UDP;
+    config->device4_config.tcpSlowPolicy = 0;  // TCP_SLOW_DROP
 
     // Log levels defaults
     config->log_level_web = LOG_WARNING;
@@ -144,9 +154,14 @@ void config_init(Config* config) {
     // MAVLink routing default
     config->mavlinkRouting = false;
     config->terminalAnsi = false;
+    config->terminalFlushMs = 50;
+    config->terminalTriggers = "";
 
     // SBUS settings defaults
     config->sbusTimingKeeper = false;  // Disabled by default
+    config->sbusOutputPeriod = 0;      // Write on frame arrival
+    config->rcTextFormat = RC_TEXT_ESP_BRIDGE;
+    memset(config->crsfBinaryRate, 0, sizeof(config->crsfBinaryRate));  // Unlimited
 
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
     // Device 5 (Bluetooth) defaults
@@ -171,6 +186,41 @@ void config_reset_wifi(Config* config) {
     config->wifi_tx_power = DEFAULT_WIFI_TX_POWER;
 }
 
+// True if before -> after changes anything that is only applied at boot.
+// Everything not copied back here needs a restart (UART, USB mode, device roles,
+// WiFi, protocol, SBUS timing); the copied fields are applied live by the web API.
+bool config_requires_reboot(const Config* before, const Config* after) {
+    Config boot = *after;
+
+    // Read live from config or applied by ProtocolPipeline::requestReconfigure()
+    boot.log_level_web = before->log_level_web;
+    boot.log_level_uart = before->log_level_uart;
+    boot.log_level_network = before->log_level_network;
+    boot.udpBatchingEnabled = before->udpBatchingEnabled;
+    boot.mavlinkRouting = before->mavlinkRouting;
+    boot.terminalAnsi = before->terminalAnsi;
+    boot.terminalTriggers = before->terminalTriggers;
+    boot.rcTextFormat = before->rcTextFormat;
+
+    boot.device2.outRate = before->device2.outRate;
+    boot.device2.crsfFilter = before->device2.crsfFilter;
+
+    memcpy(boot.device4_config.target_ip, before->device4_config.target_ip,
+           sizeof(boot.device4_config.target_ip));
+    boot.device4_config.udpSourceTimeout = before->device4_config.udpSourceTimeout;
+    boot.device4_config.udpSendRate = before->device4_config.udpSendRate;
+    boot.device4_config.crsfFilter = before->device4_config.crsfFilter;
+    boot.device4_config.sbusEnvelope = before->device4_config.sbusEnvelope;
+    boot.device4_config.sbusRedundancy = before->device4_config.sbusRedundancy;
+
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    boot.device5_config.btSendRate = before->device5_config.btSendRate;
+    boot.device5_config.crsfFilter = before->device5_config.crsfFilter;
+#endif
+
+    return !config_snapshot_equal(before, &boot);
+}
+
 // Migrate configuration from old versions
 // Note: Versions 1-8 were alpha/internal, first public release was v2.18.7 with config v9
 void config_migrate(Config* config) {
@@ -205,14 +255,26 @@ void config_load(Config* config) {
     String jsonString = file.readString();
     file.close();
 
+    // Fast path: binary snapshot made from this exact file
+    uint32_t jsonCrc = config_snapshot_json_crc(jsonString);
+    if (config_snapshot_load(config, jsonCrc)) {
+        boot_profile_mark(BOOT_PHASE_CONFIG_SNAPSHOT);
+        return;
+    }
+
     uint16_t oldVersion = config->config_version;
-    config_load_from_json(config, jsonString);
+    if (!config_load_from_json(config, jsonString)) {
+        return;
+    }
 
-    // Save config if migration occurred (version changed)
+    // Save config if migration occurred (version changed) - also refreshes the snapshot
     if (config->config_version != oldVersion) {
         log_msg(LOG_INFO, "Config migrated from v%d to v%d, saving...", oldVersion, config->config_version);
         config_save(config);
+    } else {
+        config_snapshot_save(config, jsonCrc);
     }
+    boot_profile_mark(BOOT_PHASE_CONFIG_JSON);
 }
 
 // Load configuration from JSON string
@@ -373,6 +435,17 @@ bool config_load_from_json(Config* config, const String& jsonString) {
         config->device4_config.udpSourceTimeout = doc["device4"]["udp_timeout"] | 1000;
         config->device4_config.udpSendRate = doc["device4"]["send_rate"] | 50;
         config->device4_config.crsfFilter = doc["device4"]["crsf_filter"] | CRSF_FILTER_ALL;
+        config->device4_config.sbusEnvelope = doc["device4"]["sbus_envelope"] | false;
+        config->device4_config.sbusRedundancy = doc["device4"]["sbus_redundancy"] | 0;
+        if (config->device4_config.sbusRedundancy > SBUS_UDP_MAX_REDUNDANCY) {
+            config->device4_config.sbusRedundancy = 0;
+        }
+        config->device4_config.learn_peers = doc["device4"]["learn_peers"] | false;
+        config->device4_config.transport = doc["device4"]["transport"] | D4_TRANSPORT_UDP;
+        if (config->device4_config.transport > D4_TRANSPORT_TCP) {
+            config->device4_config.transport = D4_TRANSPORT_UDP;
+        }
+        config->device4_config.tcpSlowPolicy = doc["device4"]["tcp_slow_policy"] | 0;
     }
 
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
@@ -398,7 +471,25 @@ bool config_load_from_json(Config* config, const String& jsonString) {
         config->udpBatchingEnabled = doc["protocol"]["udp_batching"] | true;
         config->mavlinkRouting = doc["protocol"]["mavlink_routing"] | false;
         config->terminalAnsi = doc["protocol"]["terminal_ansi"] | false;
+        config->terminalFlushMs = doc["protocol"]["terminal_flush_ms"] | 50;
+        if (config->terminalFlushMs < 10 || config->terminalFlushMs > 200) {
+            config->terminalFlushMs = 50;
+        }
+        config->terminalTriggers = doc["protocol"]["terminal_triggers"] | "";
         config->sbusTimingKeeper = doc["protocol"]["sbus_timing_keeper"] | false;
+        config->sbusOutputPeriod = doc["protocol"]["sbus_output_period"] | 0;
+        if (!isValidSbusOutputPeriod(config->sbusOutputPeriod)) {
+            config->sbusOutputPeriod = 0;
+        }
+        config->rcTextFormat = doc["protocol"]["rc_text_format"] | RC_TEXT_ESP_BRIDGE;
+        if (config->rcTextFormat > RC_TEXT_R2D2) {
+            config->rcTextFormat = RC_TEXT_ESP_BRIDGE;
+        }
+        for (int i = 0; i < CRSF_RATE_GROUPS; i++) {
+            // Clamp, don't zero: 0 means unlimited, the opposite of a too-high limit
+            int hz = doc["protocol"]["crsf_binary_rates"][i] | 0;
+            config->crsfBinaryRate[i] = (uint8_t)constrain(hz, 0, 100);
+        }
     }
 
     // System settings like device_version and device_name are NOT loaded from file
@@ -481,6 +572,11 @@ static void populateConfigExportJson(JsonDocument& doc, const Config* config) {
     doc["device4"]["udp_timeout"] = config->device4_config.udpSourceTimeout;
     doc["device4"]["send_rate"] = config->device4_config.udpSendRate;
     doc["device4"]["crsf_filter"] = config->device4_config.crsfFilter;
+    doc["device4"]["sbus_envelope"] = config->device4_config.sbusEnvelope;
+    doc["device4"]["sbus_redundancy"] = config->device4_config.sbusRedundancy;
+    doc["device4"]["learn_peers"] = config->device4_config.learn_peers;
+    doc["device4"]["transport"] = config->device4_config.transport;
+    doc["device4"]["tcp_slow_policy"] = config->device4_config.tcpSlowPolicy;
 
     // Log levels
     doc["logging"]["web"] = config->log_level_web;
@@ -492,7 +588,15 @@ static void populateConfigExportJson(JsonDocument& doc, const Config* config) {
     doc["protocol"]["udp_batching"] = config->udpBatchingEnabled;
     doc["protocol"]["mavlink_routing"] = config->mavlinkRouting;
     doc["protocol"]["terminal_ansi"] = config->terminalAnsi;
+    doc["protocol"]["terminal_flush_ms"] = config->terminalFlushMs;
+    doc["protocol"]["terminal_triggers"] = config->terminalTriggers;
     doc["protocol"]["sbus_timing_keeper"] = config->sbusTimingKeeper;
+    doc["protocol"]["sbus_output_period"] = config->sbusOutputPeriod;
+    doc["protocol"]["rc_text_format"] = config->rcTextFormat;
+    JsonArray crsfRates = doc["protocol"]["crsf_binary_rates"].to<JsonArray>();
+    for (int i = 0; i < CRSF_RATE_GROUPS; i++) {
+        crsfRates.add(config->crsfBinaryRate[i]);
+    }
 
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
     // Device 5 (Bluetooth) configuration
@@ -537,20 +641,25 @@ void config_save(Config* config) {
     // Get configuration JSON
     String jsonString = config_to_json(config);
 
+    // Snapshot of the old file must not outlive it (reset before the new snapshot is written)
+    config_snapshot_clear();
+
     File file = LittleFS.open("/config.json", "w");
     if (!file) {
         log_msg(LOG_ERROR, "Failed to create config file");
         return;
     }
 
-    if (file.print(jsonString) == 0) {
+    size_t written = file.print(jsonString);
+    file.close();
+
+    if (written != jsonString.length()) {
         log_msg(LOG_ERROR, "Failed to write config file");
     } else {
         log_msg(LOG_INFO, "Configuration saved successfully");
+        config_snapshot_save(config, config_snapshot_json_crc(jsonString));
     }
 
-    file.close();
-
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
     // Duplicate D5 config to Preferences for btInUse()/bleInUse() early access
     // Called by Arduino before LittleFS is mounted
@@ -19,6 +19,7 @@ void config_reset_wifi(Config* config);  // Reset WiFi settings to defaults (AP
 bool config_load_from_json(Config* config, const String& jsonString);
 String config_to_json(Config* config);
 void config_to_json_stream(Print& output, const Config* config);
+bool config_requires_reboot(const Config* before, const Config* after);  // Any boot-time setting changed
 
 // Helper functions for string conversion
 const char* parity_to_string(uart_parity_t parity);
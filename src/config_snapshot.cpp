@@ -0,0 +1,330 @@
+#include "config_snapshot.h"
+#include "config.h"
+#include "logging.h"
+#include "defines.h"
+#include <Preferences.h>
+#include "esp_rom_crc.h"
+
+#define SNAPSHOT_NAMESPACE  "cfgsnap"
+#define SNAPSHOT_KEY        "blob"
+#define SNAPSHOT_MAGIC      0x50534643      // "CFSP"
+#define SNAPSHOT_MAX_SIZE   8192
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint16_t layout;            // CONFIG_SNAPSHOT_LAYOUT
+    uint16_t configSize;        // sizeof(Config) - catches struct changes without a layout bump
+    char firmware[16];          // DEVICE_VERSION - defaults/migrations may differ between builds
+    uint32_t jsonCrc;           // CRC32 of the /config.json the snapshot was made from
+    uint32_t payloadSize;
+    uint32_t crc;               // CRC32 of payload
+};
+
+// Writes the visited fields (buf nullptr = count only)
+class SnapshotWriter {
+public:
+    SnapshotWriter(uint8_t* buffer, size_t capacity) : buf(buffer), cap(capacity), len(0) {}
+
+    template<typename T> void field(const T& value) { bytes(&value, sizeof(T)); }
+    void str(const String& s) {
+        uint16_t n = s.length();
+        field(n);
+        bytes(s.c_str(), n);
+    }
+    // Fixed char buffer: only the bytes up to the NUL, garbage after it must not count
+    template<size_t N> void cstr(const char (&s)[N]) {
+        uint16_t n = strnlen(s, N - 1);
+        field(n);
+        bytes(s, n);
+    }
+    size_t length() const { return len; }
+
+private:
+    uint8_t* buf;
+    size_t cap;
+    size_t len;
+
+    void bytes(const void* data, size_t n) {
+        if (buf && len + n <= cap) memcpy(buf + len, data, n);
+        len += n;
+    }
+};
+
+// Reads the visited fields back, ok() false on any overrun
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* buffer, size_t length) : buf(buffer), len(length), pos(0), valid(true) {}
+
+    template<typename T> void field(T& value) { bytes(&value, sizeof(T)); }
+    void str(String& s) {
+        uint16_t n = 0;
+        field(n);
+        if (!valid || pos + n > len) {
+            valid = false;
+            return;
+        }
+        s = String(reinterpret_cast<const char*>(buf + pos), n);
+        pos += n;
+    }
+    template<size_t N> void cstr(char (&s)[N]) {
+        uint16_t n = 0;
+        field(n);
+        if (!valid || n >= N || pos + n > len) {
+            valid = false;
+            return;
+        }
+        memcpy(s, buf + pos, n);
+        memset(s + n, 0, N - n);
+        pos += n;
+    }
+    bool ok() const { return valid && pos == len; }
+
+private:
+    const uint8_t* buf;
+    size_t len;
+    size_t pos;
+    bool valid;
+
+    void bytes(void* data, size_t n) {
+        if (!valid || pos + n > len) {
+            valid = false;
+            return;
+        }
+        memcpy(data, buf + pos, n);
+        pos += n;
+    }
+};
+
+// Structs are visited member by member: whole-struct copies would carry padding
+// bytes, which config_snapshot_equal() would then compare
+template<typename IO, typename D>
+static void visitDevice(IO& io, D* d) {
+    io.field(d->role);
+    io.field(d->sbusOutputFormat);
+    io.field(d->outRate);
+    io.field(d->crsfFilter);
+}
+
+template<typename IO, typename D>
+static void visitDevice4(IO& io, D* d) {
+    io.cstr(d->target_ip);
+    io.field(d->port);
+    io.field(d->role);
+    io.field(d->auto_broadcast);
+    io.field(d->sbusOutputFormat);
+    io.field(d->udpSourceTimeout);
+    io.field(d->udpSendRate);
+    io.field(d->crsfFilter);
+    io.field(d->sbusEnvelope);
+    io.field(d->sbusRedundancy);
+    io.field(d->learn_peers);
+    io.field(d->transport);
+    io.field(d->tcpSlowPolicy);
+}
+
+// Single field list for both directions - order is the snapshot layout
+template<typename IO, typename C>
+static void visitConfig(IO& io, C* c) {
+    io.field(c->config_version);
+
+    io.field(c->baudrate);
+    io.field(c->databits);
+    io.field(c->parity);
+    io.field(c->stopbits);
+    io.field(c->flowcontrol);
+
+    io.str(c->ssid);
+    io.str(c->password);
+    io.field(c->wifi_ap_mode);
+    io.field(c->wifi_mode);
+    for (int i = 0; i < MAX_WIFI_NETWORKS; i++) {
+        io.str(c->wifi_networks[i].ssid);
+        io.str(c->wifi_networks[i].password);
+    }
+    io.field(c->wifi_tx_power);
+    io.field(c->wifi_ap_channel);
+    io.str(c->mdns_hostname);
+
+    io.str(c->device_version);
+    io.str(c->device_name);
+
+    io.field(c->usb_mode);
+
+    visitDevice(io, &c->device1);
+    visitDevice(io, &c->device2);
+    visitDevice(io, &c->device3);
+    visitDevice(io, &c->device4);
+    visitDevice4(io, &c->device4_config);
+
+    io.field(c->log_level_web);
+    io.field(c->log_level_uart);
+    io.field(c->log_level_network);
+
+    io.field(c->protocolOptimization);
+    io.field(c->udpBatchingEnabled);
+    io.field(c->mavlinkRouting);
+    io.field(c->terminalAnsi);
+    io.field(c->terminalFlushMs);
+    io.str(c->terminalTriggers);
+
+    io.field(c->sbusTimingKeeper);
+    io.field(c->sbusOutputPeriod);
+    io.field(c->rcTextFormat);
+    io.field(c->crsfBinaryRate);
+
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    io.field(c->device5_config.role);
+    io.field(c->device5_config.btSendRate);
+    io.field(c->device5_config.crsfFilter);
+#endif
+}
+
+static void fillHeader(SnapshotHeader& h, uint32_t jsonCrc, size_t payloadSize, uint32_t crc) {
+    memset(&h, 0, sizeof(h));
+    h.magic = SNAPSHOT_MAGIC;
+    h.layout = CONFIG_SNAPSHOT_LAYOUT;
+    h.configSize = sizeof(Config);
+    strncpy(h.firmware, DEVICE_VERSION, sizeof(h.firmware) - 1);
+    h.jsonCrc = jsonCrc;
+    h.payloadSize = payloadSize;
+    h.crc = crc;
+}
+
+uint32_t config_snapshot_json_crc(const String& json) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(json.c_str()), json.length());
+}
+
+bool config_snapshot_load(Config* config, uint32_t jsonCrc) {
+    uint32_t startUs = micros();
+
+    Preferences prefs;
+    if (!prefs.begin(SNAPSHOT_NAMESPACE, true)) return false;
+
+    size_t size = prefs.getBytesLength(SNAPSHOT_KEY);
+    if (size < sizeof(SnapshotHeader) || size > SNAPSHOT_MAX_SIZE) {
+        prefs.end();
+        return false;
+    }
+
+    uint8_t* blob = static_cast<uint8_t*>(malloc(size));
+    if (!blob) {
+        prefs.end();
+        return false;
+    }
+    size_t got = prefs.getBytes(SNAPSHOT_KEY, blob, size);
+    prefs.end();
+
+    SnapshotHeader h;
+    memcpy(&h, blob, sizeof(h));
+    const uint8_t* payload = blob + sizeof(h);
+    size_t payloadSize = size - sizeof(h);
+
+    SnapshotHeader expected;
+    fillHeader(expected, jsonCrc, payloadSize, h.crc);
+
+    const char* reason = nullptr;
+    if (got != size || memcmp(&h, &expected, sizeof(h)) != 0) {
+        reason = "stale";
+    } else if (esp_rom_crc32_le(0, payload, payloadSize) != h.crc) {
+        reason = "CRC mismatch";
+    }
+
+    bool loaded = false;
+    if (!reason) {
+        // Decode into a copy so a bad snapshot leaves config untouched
+        Config decoded = *config;
+        SnapshotReader reader(payload, payloadSize);
+        visitConfig(reader, &decoded);
+        if (reader.ok()) {
+            *config = decoded;
+            loaded = true;
+        } else {
+            reason = "malformed";
+        }
+    }
+    free(blob);
+
+    if (loaded) {
+        log_msg(LOG_INFO, "Config loaded from snapshot (%zu bytes, %lu us)", size,
+                (unsigned long)(micros() - startUs));
+    } else {
+        log_msg(LOG_INFO, "Config snapshot not used (%s), parsing JSON", reason);
+    }
+    return loaded;
+}
+
+void config_snapshot_save(const Config* config, uint32_t jsonCrc) {
+    SnapshotWriter counter(nullptr, 0);
+    visitConfig(counter, config);
+    size_t payloadSize = counter.length();
+    size_t size = sizeof(SnapshotHeader) + payloadSize;
+    if (size > SNAPSHOT_MAX_SIZE) {
+        log_msg(LOG_WARNING, "Config snapshot too large (%zu bytes), not saved", size);
+        config_snapshot_clear();
+        return;
+    }
+
+    uint8_t* blob = static_cast<uint8_t*>(malloc(size));
+    if (!blob) return;
+
+    SnapshotWriter writer(blob + sizeof(SnapshotHeader), payloadSize);
+    visitConfig(writer, config);
+
+    SnapshotHeader h;
+    fillHeader(h, jsonCrc, payloadSize,
+               esp_rom_crc32_le(0, blob + sizeof(SnapshotHeader), payloadSize));
+    memcpy(blob, &h, sizeof(h));
+
+    Preferences prefs;
+    if (prefs.begin(SNAPSHOT_NAMESPACE, false)) {
+        // Skip identical rewrites (NVS wear)
+        bool same = false;
+        if (prefs.getBytesLength(SNAPSHOT_KEY) == size) {
+            uint8_t* old = static_cast<uint8_t*>(malloc(size));
+            if (old) {
+                same = prefs.getBytes(SNAPSHOT_KEY, old, size) == size && memcmp(old, blob, size) == 0;
+                free(old);
+            }
+        }
+        if (!same) {
+            if (prefs.putBytes(SNAPSHOT_KEY, blob, size) == size) {
+                log_msg(LOG_DEBUG, "Config snapshot saved (%zu bytes)", size);
+            } else {
+                log_msg(LOG_WARNING, "Config snapshot write failed");
+            }
+        }
+        prefs.end();
+    }
+    free(blob);
+}
+
+void config_snapshot_clear() {
+    Preferences prefs;
+    if (prefs.begin(SNAPSHOT_NAMESPACE, false)) {
+        prefs.remove(SNAPSHOT_KEY);
+        prefs.end();
+    }
+}
+
+bool config_snapshot_equal(const Config* a, const Config* b) {
+    SnapshotWriter countA(nullptr, 0);
+    SnapshotWriter countB(nullptr, 0);
+    visitConfig(countA, a);
+    visitConfig(countB, b);
+    if (countA.length() != countB.length()) return false;
+
+    size_t size = countA.length();
+    uint8_t* bufA = static_cast<uint8_t*>(malloc(size));
+    uint8_t* bufB = static_cast<uint8_t*>(malloc(size));
+    bool equal = false;
+    if (bufA && bufB) {
+        SnapshotWriter writerA(bufA, size);
+        SnapshotWriter writerB(bufB, size);
+        visitConfig(writerA, a);
+        visitConfig(writerB, b);
+        equal = memcmp(bufA, bufB, size) == 0;
+    }
+    free(bufA);
+    free(bufB);
+    return equal;
+}
@@ -0,0 +1,32 @@
+#ifndef CONFIG_SNAPSHOT_H
+#define CONFIG_SNAPSHOT_H
+
+#include "types.h"
+
+// Binary snapshot of the parsed Config in NVS, so boot can skip the JSON parse.
+// /config.json stays the source of truth: the snapshot is rewritten by every
+// config_save() and by config_load() after a JSON parse, and is only used when
+// its header matches this firmware (layout, sizeof(Config), DEVICE_VERSION), the
+// CRC is valid and /config.json still has the CRC it was generated from.
+// config_save() drops the snapshot before rewriting the file, so a reset between
+// the two writes falls back to the JSON.
+
+// Bump when fields are added, removed or reordered in visitConfig()
+#define CONFIG_SNAPSHOT_LAYOUT  4
+
+// CRC32 of /config.json contents - the key a snapshot belongs to
+uint32_t config_snapshot_json_crc(const String& json);
+
+// Fill config from the snapshot. False = missing/stale, parse the JSON instead.
+bool config_snapshot_load(Config* config, uint32_t jsonCrc);
+
+// Store config as the snapshot of the /config.json with CRC jsonCrc
+void config_snapshot_save(const Config* config, uint32_t jsonCrc);
+
+// Drop the snapshot (next boot parses the JSON)
+void config_snapshot_clear();
+
+// True if every snapshot field of a and b is equal (same field list as the snapshot)
+bool config_snapshot_equal(const Config* a, const Config* b);
+
+#endif // CONFIG_SNAPSHOT_H
@@ -156,6 +156,7 @@ Hardware: ESP32-WROOM-32 based development board
 #define LOG_BUFFER_SIZE     100     // S3 without BLE
 #define LOG_DISPLAY_COUNT   95
 #endif
+#define LOG_RECORD_TEXT_SIZE 192    // Web log line size (fixed-size ring records, longer lines truncated)
 
 // Crash logging (need move to crashlog)
 #define CRASHLOG_MAX_ENTRIES        10                  // Maximum number of crash entries to keep
@@ -167,11 +168,13 @@ Hardware: ESP32-WROOM-32 based development board
 // FreeRTOS priorities for multi-core ESP32
 #define UART_TASK_PRIORITY  (configMAX_PRIORITIES - 4)  // Highest priority for UART !!
 #define WEB_TASK_PRIORITY   (configMAX_PRIORITIES - 15) // Lower priority for web server
+#define SBUS_OUT_TASK_PRIORITY (UART_TASK_PRIORITY + 1) // SBUS output scheduler - one short frame write per tick
 
 // Core assignments for multi-core ESP32
 #define UART_TASK_CORE      0   // Main UART bridge task
 #define UART_DMA_TASK_CORE  0   // UART DMA task (same as UART)
 #define WEB_TASK_CORE       1   // Web server task
+#define SBUS_OUT_TASK_CORE  0   // SBUS output scheduler task (next to the bridge task)
 
 // Input buffer sizes
 #define INPUT_BUFFER_SIZE 4096  // 4KB for GCS→FC commands
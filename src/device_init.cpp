@@ -592,6 +592,11 @@ void registerSbusOutputs() {
         }
     }
 #endif
+
+    // Fixed-cadence output scheduler (outputs must be registered first)
+    if (config.sbusOutputPeriod) {
+        router->startOutputScheduler(config.sbusOutputPeriod);
+    }
 }
 
 // Initialize and log device configuration
@@ -651,6 +656,10 @@ void initDevices() {
         if (config.device1.role == D1_SBUS_IN) {
             router->registerSource(SBUS_SOURCE_DEVICE1, 0);  // Highest priority
             log_msg(LOG_INFO, "SBUS source registered: Device1 (priority 0)");
+        } else if (config.device1.role == D1_CRSF_IN) {
+            // CRSF RC channels converted to SBUS by CrsfParser
+            router->registerSource(SBUS_SOURCE_DEVICE1, 0);
+            log_msg(LOG_INFO, "SBUS source registered: Device1 CRSF (priority 0)");
         }
 
         if (config.device2.role == D2_SBUS_IN) {
@@ -73,6 +73,12 @@ enum Device4Role {
     D4_CRSF_TEXT = 5         // CRSF text output via UDP
 };
 
+// Device 4 transport (D4_NETWORK_BRIDGE only, other roles are UDP)
+enum Device4Transport {
+    D4_TRANSPORT_UDP = 0,
+    D4_TRANSPORT_TCP = 1    // TCP server on device4 port
+};
+
 // Device 5 role (Bluetooth - Classic SPP on MiniKit, BLE on S3)
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
 enum Device5Role {
@@ -105,6 +111,9 @@ enum CrsfFilterBit : uint8_t {
     CRSF_FILTER_ALL        = 0x3F   // Bits 0-5: All groups enabled
 };
 
+// CRSF binary output rate groups (same grouping and order as CrsfFilterBit)
+#define CRSF_RATE_GROUPS 6
+
 // Device configuration
 typedef struct {
     uint8_t role;
@@ -123,6 +132,11 @@ struct Device4Config {
     uint16_t udpSourceTimeout; // UDP source timeout in ms (100-5000, default 1000) for D4_SBUS_UDP_RX
     uint8_t udpSendRate;       // Send rate in Hz (10-70, default 50) for D4_SBUS_UDP_TX
     uint8_t crsfFilter;        // CRSF text filter bitmask (default: CRSF_FILTER_ALL)
+    bool sbusEnvelope;         // Wrap SBUS frames with sequence + timestamp (D4_SBUS_UDP_TX)
+    uint8_t sbusRedundancy;    // Previous frames repeated per envelope datagram (0-3)
+    bool learn_peers;          // Also send to endpoints that send us datagrams (D4_NETWORK_BRIDGE)
+    uint8_t transport;         // Device4Transport (D4_NETWORK_BRIDGE)
+    uint8_t tcpSlowPolicy;     // TcpSlowPolicy: drop or disconnect clients that stop reading
 };
 
 // Device 5 Configuration (Bluetooth - Classic SPP on MiniKit, BLE on S3)
@@ -190,9 +204,19 @@ typedef struct {
     bool udpBatchingEnabled;
     bool mavlinkRouting;
     bool terminalAnsi;  // Terminal: use xterm.js ANSI rendering
+    uint8_t terminalFlushMs;  // Terminal: WebSocket flush interval in ms (10-200)
+    String terminalTriggers;  // Terminal: trigger actions, "<pattern> | <actions>" per line
 
     // SBUS settings
     bool sbusTimingKeeper;
+    uint8_t sbusOutputPeriod;  // Output scheduler period in ms (7/9/14/20), 0 = on arrival
+
+    // RC text output format (SBUS text and CRSF text): 0 = ESP-Bridge, 1 = R2D2
+    uint8_t rcTextFormat;
+
+    // CRSF binary outputs: max rate per frame group in Hz (0 = unlimited)
+    // Order: RC, Link Stats, Battery, GPS/Altitude, Attitude, Flight Mode
+    uint8_t crsfBinaryRate[CRSF_RATE_GROUPS];
 
 #if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
     // Device 5 - Bluetooth (Classic SPP or BLE)
@@ -49,6 +49,7 @@ enum BlinkType {
     BLINK_SAFE_MODE,
     BLINK_BT_CONNECTED,
     BLINK_BLE_ONLY,         // Fast blink for BLE only (single-color)
+    BLINK_TRIGGER,          // Terminal trigger flash (configurable color)
     BLINK_MAX
 };
 
@@ -99,7 +100,9 @@ static volatile BlinkState blinkStates[BLINK_MAX] = {
     // BLINK_BT_CONNECTED - simple blink (MiniKit only)
     {false, -1, LED_BT_CONNECTED_BLINK_MS, LED_BT_CONNECTED_BLINK_MS, 0, 1, 0, 0, false, (uint32_t)CRGB::Blue},
     // BLINK_BLE_ONLY - fast blink for BLE only (single-color)
-    {false, -1, LED_BLE_FAST_BLINK_MS, LED_BLE_FAST_BLINK_MS, 0, 1, 0, 0, false, (uint32_t)CRGB::Purple}
+    {false, -1, LED_BLE_FAST_BLINK_MS, LED_BLE_FAST_BLINK_MS, 0, 1, 0, 0, false, (uint32_t)CRGB::Purple},
+    // BLINK_TRIGGER - simple blink, color set per trigger
+    {false, 0, 0, 0, 0, 1, 0, 0, false, (uint32_t)CRGB::Red}
 };
 
 // Safe millis() comparison that handles wrap-around correctly
@@ -525,6 +528,12 @@ void led_rapid_blink(int count, int delay_ms) {
     startBlink(BLINK_RAPID, CRGB::Purple, count, delay_ms, delay_ms);
 }
 
+// Terminal trigger flash (works in standalone and network modes)
+void led_trigger_flash(uint32_t color) {
+    startBlink(BLINK_TRIGGER, CRGB(color), LED_TRIGGER_FLASH_COUNT,
+               LED_TRIGGER_FLASH_MS, LED_TRIGGER_FLASH_MS);
+}
+
 // Visual indication of click count (works in standalone and WiFi client modes)
 void led_blink_click_feedback(int clickCount) {
     // Show feedback only in modes where button clicks do something useful
@@ -563,6 +572,16 @@ void led_process_updates() {
         FastLED.show();
         ledUpdateNeeded = false;
     }
+
+    // Terminal trigger flash, then restore the static color
+    if (blinkStates[BLINK_TRIGGER].active) {
+        processBlinkPatternUnderMutex(BLINK_TRIGGER);
+        if (!blinkStates[BLINK_TRIGGER].active) {
+            ledUpdateNeeded = true;
+        }
+        xSemaphoreGive(ledMutex);
+        return;
+    }
     
     // Client modes
     if (currentLedMode == LED_MODE_WIFI_CLIENT_SEARCHING) {
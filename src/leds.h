@@ -10,6 +10,8 @@
 #define LED_WIFI_SEARCH_BLINK_MS 2000 // Orange slow blink for WiFi searching
 #define LED_WIFI_ERROR_BLINK_MS  500  // Fast blink for WiFi errors
 #define LED_BT_CONNECTED_BLINK_MS 500 // Bluetooth connected blink interval (MiniKit)
+#define LED_TRIGGER_FLASH_MS   100   // Terminal trigger flash on/off time
+#define LED_TRIGGER_FLASH_COUNT 3    // Terminal trigger flashes per match
 
 // Single-color LED patterns for BLE modes
 #define LED_BLE_FAST_BLINK_MS 150     // Fast blink for BLE only mode
@@ -47,5 +49,6 @@ void led_notify_device3_tx();
 void led_notify_device3_rx();
 void led_rapid_blink(int count, int delay_ms);
 void led_blink_click_feedback(int clickCount);
+void led_trigger_flash(uint32_t color);     // Terminal trigger action
 
 #endif // LEDS_H
\ No newline at end of file
@@ -21,11 +21,20 @@ int udpLogHead = 0;
 int udpLogTail = 0;
 SemaphoreHandle_t udpLogMutex = nullptr;
 
-// Logging system internal data
-static String logBuffer[LOG_BUFFER_SIZE];
+// Cached sink level; permissive until config is loaded (log_write filters per sink)
+std::atomic<int8_t> logActiveLevel{LOG_DEBUG};
+
+// Web log ring: fixed-size records, no heap Strings
+struct LogWebRecord {
+    uint32_t timeMs;
+    int8_t level;
+    uint16_t len;
+    char text[LOG_RECORD_TEXT_SIZE];   // Full line with prefix, null-terminated
+};
+
+static LogWebRecord logRing[LOG_BUFFER_SIZE];
 static int logIndex = 0;
 static int logCount = 0;
-static bool initialized = false;
 
 // Global logging configuration
 static LogConfig logConfig;
@@ -50,13 +59,6 @@ const char* getLogLevelName(LogLevel level) {
 
 // Initialize logging system
 void logging_init() {
-    if (!initialized) {
-        for (int i = 0; i < LOG_BUFFER_SIZE; i++) {
-            logBuffer[i] = "";
-            logBuffer[i].reserve(128);  // Pre-allocate memory
-        }
-        initialized = true;
-    }
     logIndex = 0;
     logCount = 0;
 
@@ -87,6 +89,7 @@ void logging_free_udp_if_unused() {
             udpLogMutex = nullptr;
         }
     }
+    logging_update_level();
 }
 
 // Initialize UART logging on Device 3
@@ -98,6 +101,7 @@ void logging_init_uart() {
 
     // Use existing device3Serial interface
     logSerial = device3Serial;
+    logging_update_level();
 
     if (logSerial) {
         log_msg(LOG_INFO, "UART logging using existing Device 3 interface (D3_UART3_LOG mode)");
@@ -113,6 +117,7 @@ void logging_init_usb(UsbInterface* usb) {
     }
 
     logUsb = usb;
+    logging_update_level();
 
     if (logUsb) {
         log_msg(LOG_INFO, "USB logging using Device 2 interface (D2_USB_LOG mode)");
@@ -121,91 +126,107 @@ void logging_init_usb(UsbInterface* usb) {
     }
 }
 
-// Printf-style logging - thread-safe and heap-safe
-void log_msg(LogLevel level, const char* fmt, ...) {
-    if (!fmt) return;
-    
-    // Stack buffer for formatted message
-    char msgBuf[256];
-    
-    // Format the message
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(msgBuf, sizeof(msgBuf), fmt, args);
-    va_end(args);
+// Highest level any enabled sink accepts (LOG_OFF = nobody listens)
+static LogLevel sinkMaxLevel() {
+    LogLevel maxLevel = LOG_OFF;
+    if (config.log_level_web > maxLevel) maxLevel = config.log_level_web;
+    if ((logSerial && config.device3.role == D3_UART3_LOG) ||
+        (logUsb && config.device2.role == D2_USB_LOG)) {
+        if (config.log_level_uart > maxLevel) maxLevel = config.log_level_uart;
+    }
+    if (config.device4.role == D4_LOG_NETWORK && udpLogBuffer) {
+        if (config.log_level_network > maxLevel) maxLevel = config.log_level_network;
+    }
+    return maxLevel;
+}
 
-    // Ensure null termination
-    msgBuf[sizeof(msgBuf) - 1] = '\0';
-    
-    // Check if this message should be logged to web interface
-    bool shouldLogToWeb = (config.log_level_web != LOG_OFF && level <= config.log_level_web);
-    
-    // Web interface logging (with mutex)
-    if (shouldLogToWeb && xSemaphoreTake(logMutex, 0) == pdTRUE) {
-        unsigned long uptimeMs = millis();
-        unsigned long seconds = uptimeMs / 1000;
-        unsigned long ms = uptimeMs % 1000;
-
-        // Format directly into a temporary buffer
-        char tempBuf[300];
-        int webLen = snprintf(tempBuf, sizeof(tempBuf), "[%lu.%lus][%s] %s",
-                              seconds, ms/100, getLogLevelName(level), msgBuf);
-
-        // Ensure null termination and check length
-        if (webLen > 0 && webLen < (int)sizeof(tempBuf)) {
-            // Only now assign to String in one operation
-            logBuffer[logIndex] = tempBuf;
-        } else {
-            // Fallback for too long messages
-            logBuffer[logIndex] = "[LOG TOO LONG]";
-        }
+void logging_update_level() {
+    logActiveLevel.store(sinkMaxLevel(), std::memory_order_relaxed);
+}
 
-        logIndex = (logIndex + 1) % LOG_BUFFER_SIZE;
-        if (logCount < LOG_BUFFER_SIZE) {
-            logCount++;
-        }
-        xSemaphoreGive(logMutex);
+// Web sink: copy record into the fixed-size ring
+static void sinkWeb(const LogRecord& rec) {
+    if (xSemaphoreTake(logMutex, 0) != pdTRUE) return;
+
+    LogWebRecord& slot = logRing[logIndex];
+    size_t n = rec.len < sizeof(slot.text) - 1 ? rec.len : sizeof(slot.text) - 1;
+    memcpy(slot.text, rec.line, n);
+    slot.text[n] = '\0';
+    slot.len = n;
+    slot.timeMs = rec.timeMs;
+    slot.level = rec.level;
+
+    logIndex = (logIndex + 1) % LOG_BUFFER_SIZE;
+    if (logCount < LOG_BUFFER_SIZE) {
+        logCount++;
     }
-    
-    // UART logging (non-blocking)
-    if (logSerial && config.device3.role == D3_UART3_LOG &&
-        config.log_level_uart != LOG_OFF && level <= config.log_level_uart) {
+    xSemaphoreGive(logMutex);
+}
+
+// Network sink: whole line + '\n' into the UDP log ring (two-segment memcpy)
+static void sinkNetwork(const LogRecord& rec) {
+    if (xSemaphoreTake(udpLogMutex, 0) != pdTRUE) return;
+
+    size_t total = rec.len + 1;
+    size_t freeSpace = (udpLogTail - udpLogHead - 1 + UDP_LOG_BUFFER_SIZE) % UDP_LOG_BUFFER_SIZE;
+    if (total <= freeSpace) {
+        size_t first = UDP_LOG_BUFFER_SIZE - udpLogHead;
+        if (first > rec.len) first = rec.len;
+        memcpy(udpLogBuffer + udpLogHead, rec.line, first);
+        memcpy(udpLogBuffer, rec.line + first, rec.len - first);
+        udpLogHead = (udpLogHead + rec.len) % UDP_LOG_BUFFER_SIZE;
+        udpLogBuffer[udpLogHead] = '\n';
+        udpLogHead = (udpLogHead + 1) % UDP_LOG_BUFFER_SIZE;
+    }
+    // Buffer full: drop whole line (no partial lines on the wire)
 
-        // Format for UART with timestamp
-        char uartBuf[320];
-        unsigned long uptimeMs = millis();
-        unsigned long seconds = uptimeMs / 1000;
-        unsigned long ms = uptimeMs % 1000;
+    xSemaphoreGive(udpLogMutex);
+}
 
-        int uartLen = snprintf(uartBuf, sizeof(uartBuf),
-                              "[%lu.%lus][%s] %s\r\n",
-                              seconds, ms/100, getLogLevelName(level), msgBuf);
+// Printf-style logging - thread-safe and heap-safe (called via log_msg macro)
+// The line is formatted once ("[sec.d][LVL] message") and handed to every sink by
+// reference; serial sinks get the CRLF already reserved behind it.
+void log_write(LogLevel level, const char* fmt, ...) {
+    if (!fmt || level == LOG_OFF) return;
 
-        if (uartLen > 0 && uartLen < (int)sizeof(uartBuf)) {
-            // Non-blocking write
-            if (logSerial->availableForWrite() > uartLen) {
-                logSerial->write(reinterpret_cast<const uint8_t*>(uartBuf), uartLen);
-            }
-        }
-    }
-    
-    // USB logging (non-blocking, same format as UART)
-    if (logUsb && config.device2.role == D2_USB_LOG &&
-        config.log_level_uart != LOG_OFF && level <= config.log_level_uart) {
+    LogRecord rec;
+    rec.timeMs = millis();
+    rec.level = level;
 
-        char usbBuf[320];
-        unsigned long uptimeMs = millis();
-        unsigned long seconds = uptimeMs / 1000;
-        unsigned long ms = uptimeMs % 1000;
+    int prefixLen = snprintf(rec.line, sizeof(rec.line), "[%lu.%lus][%s] ",
+                             (unsigned long)(rec.timeMs / 1000),
+                             (unsigned long)((rec.timeMs % 1000) / 100),
+                             getLogLevelName(level));
 
-        int usbLen = snprintf(usbBuf, sizeof(usbBuf),
-                              "[%lu.%lus][%s] %s\r\n",
-                              seconds, ms/100, getLogLevelName(level), msgBuf);
+    // Message text, truncated to LOG_MSG_MAX (room for CRLF stays free)
+    va_list args;
+    va_start(args, fmt);
+    int msgLen = vsnprintf(rec.line + prefixLen, LOG_MSG_MAX, fmt, args);
+    va_end(args);
+    if (msgLen < 0) return;
+    if (msgLen > LOG_MSG_MAX - 1) msgLen = LOG_MSG_MAX - 1;
+    rec.len = prefixLen + msgLen;
 
-        if (usbLen > 0 && usbLen < (int)sizeof(usbBuf)) {
-            if (logUsb->availableForWrite() > usbLen) {
-                logUsb->write(reinterpret_cast<const uint8_t*>(usbBuf), usbLen);
-            }
+    // Web interface logging (with mutex)
+    if (config.log_level_web != LOG_OFF && level <= config.log_level_web) {
+        sinkWeb(rec);
+    }
+
+    // UART / USB logging (non-blocking, CRLF terminated)
+    bool toUart = logSerial && config.device3.role == D3_UART3_LOG;
+    bool toUsb = logUsb && config.device2.role == D2_USB_LOG;
+    if ((toUart || toUsb) &&
+        config.log_level_uart != LOG_OFF && level <= config.log_level_uart) {
+        rec.line[rec.len] = '\r';
+        rec.line[rec.len + 1] = '\n';
+        size_t serialLen = rec.len + 2;
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(rec.line);
+
+        if (toUart && logSerial->availableForWrite() > (int)serialLen) {
+            logSerial->write(data, serialLen);
+        }
+        if (toUsb && logUsb->availableForWrite() > (int)serialLen) {
+            logUsb->write(data, serialLen);
         }
     }
 
@@ -215,41 +236,13 @@ void log_msg(LogLevel level, const char* fmt, ...) {
         config.log_level_network != LOG_OFF &&
         level <= config.log_level_network &&
         udpLogBuffer && udpLogMutex) {
-
-        // Format for network
-        char netBuf[320];
-        unsigned long uptimeMs = millis();
-        unsigned long seconds = uptimeMs / 1000;
-        unsigned long ms = uptimeMs % 1000;
-
-        int netLen = snprintf(netBuf, sizeof(netBuf),
-                             "[%lu.%lus][%s] %s\n",
-                             seconds, ms/100, getLogLevelName(level), msgBuf);
-
-        // Add to ring buffer (non-blocking)
-        if (netLen > 0 && netLen < sizeof(netBuf) &&
-            xSemaphoreTake(udpLogMutex, 0) == pdTRUE) {
-
-            // Copy to ring buffer
-            for (int i = 0; i < netLen; i++) {
-                int nextHead = (udpLogHead + 1) % UDP_LOG_BUFFER_SIZE;
-                if (nextHead != udpLogTail) {
-                    udpLogBuffer[udpLogHead] = netBuf[i];
-                    udpLogHead = nextHead;
-                } else {
-                    break;  // Buffer full
-                }
-            }
-
-            xSemaphoreGive(udpLogMutex);
-        }
+        sinkNetwork(rec);
     }
 }
 
-// Return logs for web interface
-void logging_get_recent_logs(String* buffer, int maxCount, int* actualCount) {
+// Visit recent web log lines, oldest first
+void logging_for_each_recent(int maxCount, void (*fn)(const char* line, void* ctx), void* ctx) {
     if (xSemaphoreTake(logMutex, 100) == pdTRUE) {
-        *actualCount = 0;
         int maxEntries = min(maxCount, logCount);
 
         int startIndex;
@@ -261,9 +254,8 @@ void logging_get_recent_logs(String* buffer, int maxCount, int* actualCount) {
 
         for (int i = 0; i < maxEntries; i++) {
             int index = (startIndex + i) % LOG_BUFFER_SIZE;
-            if (logBuffer[index].length() > 0) {
-                buffer[*actualCount] = logBuffer[index];
-                (*actualCount)++;
+            if (logRing[index].len > 0) {
+                fn(logRing[index].text, ctx);
             }
         }
 
@@ -277,8 +269,9 @@ void logging_clear() {
         logIndex = 0;
         logCount = 0;
         for (int i = 0; i < LOG_BUFFER_SIZE; i++) {
-            logBuffer[i].clear();
+            logRing[i].len = 0;
+            logRing[i].text[0] = '\0';
         }
         xSemaphoreGive(logMutex);
     }
-}
\ No newline at end of file
+}
@@ -2,9 +2,17 @@
 #define LOGGING_H
 
 #include <Arduino.h>
+#include <atomic>
 #include "types.h"      // For LogLevel enum
 #include "defines.h"
 
+// Compile-time floor: log calls above this level are removed by the compiler
+// (0 = errors only, 1 = +warnings, 2 = +info, 3 = everything).
+// Override per build, e.g. -D LOG_COMPILE_LEVEL=2
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 3
+#endif
+
 // Logging configuration structure
 struct LogConfig {
     // Channel enable flags
@@ -18,13 +26,41 @@ struct LogConfig {
     LogLevel networkLevel = LOG_ERROR;  // Network - minimal traffic
 };
 
+// Log record: formatted once by log_msg(), passed to every sink by reference
+#define LOG_MSG_MAX      256    // Message text incl. terminator (longer messages truncated)
+#define LOG_PREFIX_MAX   24     // "[4294967.9s][DBG] "
+
+struct LogRecord {
+    uint32_t timeMs;
+    int8_t level;
+    uint16_t len;                               // Line length (prefix + message)
+    char line[LOG_PREFIX_MAX + LOG_MSG_MAX + 2]; // + CRLF for serial sinks
+};
+
 // Existing functions
 void logging_init();
-void logging_get_recent_logs(String* buffer, int maxCount, int* actualCount);
 void logging_clear();
 
+// Visit recent web log lines, oldest first (log mutex held - keep callback short)
+void logging_for_each_recent(int maxCount, void (*fn)(const char* line, void* ctx), void* ctx);
+
+// Highest level any enabled sink accepts (cached, see logging_update_level)
+extern std::atomic<int8_t> logActiveLevel;
+
+#define LOG_LEVEL_ENABLED(level) \
+    ((int)(level) <= LOG_COMPILE_LEVEL && \
+     (int)(level) <= logActiveLevel.load(std::memory_order_relaxed))
+
 // Log functions
-void log_msg(LogLevel level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+// log_msg() checks the level before its arguments are evaluated; disabled levels
+// cost one relaxed atomic load, levels above LOG_COMPILE_LEVEL cost nothing.
+#define log_msg(level, ...) \
+    do { if (LOG_LEVEL_ENABLED(level)) log_write((level), __VA_ARGS__); } while (0)
+
+void log_write(LogLevel level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Recompute logActiveLevel (call after log levels or log sinks change)
+void logging_update_level();
 
 // UART logging initialization
 void logging_init_uart();
@@ -10,6 +10,7 @@
 #include "web/web_interface.h"
 #include "uart/uartbridge.h"
 #include "crashlog.h"
+#include "boot_profile.h"
 #include "usb/usb_interface.h"
 #include "diagnostics.h"
 #include "system_utils.h"
@@ -29,6 +30,8 @@
 #endif
 #include "uart/uart_dma.h"
 #include "protocols/udp_sender.h"
+#include "protocols/sbus_udp_envelope.h"
+#include "protocols/tcp_server_transport.h"
 #include "circular_buffer.h"
 #include <AsyncUDP.h>
 
@@ -53,7 +56,10 @@ UsbInterface* usbInterface = NULL;
 
 // UDP transport for Device4
 AsyncUDP* udpTransport = nullptr;
-CircularBuffer* udpRxBuffer = nullptr;
+CircularBuffer* udpRxBuffer = nullptr;   // Device4 input (UDP datagrams or TCP stream)
+
+// TCP server transport for Device4 (Bridge role with transport = TCP)
+TcpServerTransport* tcpServerTransport = nullptr;
 
 // Mutexes for thread safety
 SemaphoreHandle_t logMutex = NULL;
@@ -113,6 +119,7 @@ void setup() {
     logging_init();
 
     log_msg(LOG_INFO, "%s v%s starting", config.device_name.c_str(), config.device_version.c_str());
+    boot_profile_mark(BOOT_PHASE_EARLY);
 
     // Initialize filesystem
     log_msg(LOG_INFO, "Initializing LittleFS...");
@@ -135,9 +142,11 @@ void setup() {
     } else {
         log_msg(LOG_INFO, "LittleFS mounted successfully");
     }
+    boot_profile_mark(BOOT_PHASE_LITTLEFS);
 
     // Check for crash and log if needed (MUST be early, before most initialization)
     crashlog_check_and_save();
+    boot_profile_mark(BOOT_PHASE_CRASHLOG);
 
     // Load configuration from file (this may override defaults including usb_mode)
     log_msg(LOG_INFO, "Loading configuration...");
@@ -201,12 +210,14 @@ void setup() {
 
     // Initialize devices based on configuration
     initDevices();
+    boot_profile_mark(BOOT_PHASE_DEVICES);
 
     // Initialize hardware
     log_msg(LOG_INFO, "Initializing pins...");
     initPins();
     leds_init();
     log_msg(LOG_INFO, "Hardware initialized");
+    boot_profile_mark(BOOT_PHASE_PINS);
 
 #if defined(BOARD_MINIKIT_ESP32)
     // Update uptime after LED init (user sees LED = can press RESET)
@@ -217,6 +228,7 @@ void setup() {
     log_msg(LOG_INFO, "Detecting WiFi mode...");
     detectWiFiMode();
     log_msg(LOG_INFO, "WiFi mode: %s", bridgeMode == BRIDGE_STANDALONE ? "Disabled" : "Enabled");
+    boot_profile_mark(BOOT_PHASE_WIFI_DETECT);
 
 #if defined(MINIKIT_BT_ENABLED)
     // Initialize Bluetooth SPP AFTER mode detection
@@ -227,9 +239,13 @@ void setup() {
 #if defined(BLE_ENABLED)
     initDevice5BLE();
 #endif
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    boot_profile_mark(BOOT_PHASE_BLUETOOTH);
+#endif
 
     // Initialize TaskScheduler
     initializeScheduler();
+    boot_profile_mark(BOOT_PHASE_SCHEDULER);
 
     // Mode-specific initialization
     if (bridgeMode == BRIDGE_STANDALONE) {
@@ -247,6 +263,7 @@ void setup() {
 
     // Create FreeRTOS tasks
     createTasks();
+    boot_profile_mark(BOOT_PHASE_TASKS);
 
 #if defined(MINIKIT_BT_ENABLED)
     // Log BT status after network is up (so it appears in UDP logs)
@@ -266,6 +283,7 @@ void setup() {
 #endif
 
     log_msg(LOG_INFO, "Setup complete!");
+    boot_profile_mark(BOOT_PHASE_SETUP_DONE);
 
 #if defined(BOARD_MINIKIT_ESP32)
     // Write initial uptime so quick reset detection works immediately
@@ -463,6 +481,7 @@ void initCommonDevices() {
             log_msg(LOG_INFO, "UART DMA interface created");
         }
     }
+    boot_profile_mark(BOOT_PHASE_UART_DMA);
 
     // Create USB interface based on configuration (only if Device 2 uses USB)
     if (config.device2.role == D2_USB || config.device2.role == D2_USB_SBUS_TEXT ||
@@ -502,12 +521,14 @@ void initCommonDevices() {
         } else {
             log_msg(LOG_ERROR, "Failed to create USB interface");
         }
+        boot_profile_mark(BOOT_PHASE_USB);
     } else {
         log_msg(LOG_INFO, "Device 2 is not configured for USB, skipping USB initialization");
     }
 
     // Initialize UART bridge
     initMainUART(uartBridgeSerial, &config, usbInterface);
+    boot_profile_mark(BOOT_PHASE_UART_INIT);
 }
 
 void initStandaloneMode() {
@@ -553,14 +574,30 @@ void initNetworkMode() {
         led_set_wifi_mode(LED_MODE_WIFI_ON);
     }
 
+    boot_profile_mark(BOOT_PHASE_WIFI_START);
+
     // Set network as active
     systemState.networkActive = true;
 
     // Initialize common devices (UART DMA, USB, Device1)
     initCommonDevices();
 
-    // Initialize UDP transport for Device4
-    if (config.device4.role == D4_NETWORK_BRIDGE ||
+    // Initialize TCP server transport for Device4 (Bridge over TCP)
+    if (config.device4.role == D4_NETWORK_BRIDGE &&
+        config.device4_config.transport == D4_TRANSPORT_TCP) {
+
+        udpRxBuffer = new CircularBuffer();
+        udpRxBuffer->init(8192);  // TCP delivers in bursts up to the receive window
+
+        tcpServerTransport = new TcpServerTransport(config.device4_config.port, udpRxBuffer,
+                                                    config.device4_config.tcpSlowPolicy);
+        if (!tcpServerTransport->begin()) {
+            log_msg(LOG_ERROR, "Failed to start TCP server on port %d", config.device4_config.port);
+            delete tcpServerTransport;
+            tcpServerTransport = nullptr;
+        }
+        boot_profile_mark(BOOT_PHASE_UDP);
+    } else if (config.device4.role == D4_NETWORK_BRIDGE ||     // Initialize UDP transport for Device4
         config.device4.role == D4_LOG_NETWORK ||
         config.device4.role == D4_SBUS_UDP_TX ||
         config.device4.role == D4_SBUS_UDP_RX ||
@@ -585,11 +622,20 @@ void initNetworkMode() {
                     // Setup callback based on role and protocol
                     if (config.device4.role == D4_SBUS_UDP_RX || config.protocolOptimization == PROTOCOL_SBUS) {
                         // SBUS mode - filter for valid SBUS frames only
-                        udpTransport->onPacket([](AsyncUDPPacket packet) {
+                        // Create envelope receiver here, not lazily in the UDP task. Only the
+                        // SBUS UDP RX role releases its jitter buffer (bridge task), so other
+                        // roles take plain frames only.
+                        SbusUdpReceiver* envelopeRx = (config.device4.role == D4_SBUS_UDP_RX)
+                            ? SbusUdpReceiver::getInstance() : nullptr;
+                        udpTransport->onPacket([envelopeRx](AsyncUDPPacket packet) {
                             if (udpRxBuffer) {
                                 size_t len = packet.length();
 
-                                if (len == 25) {
+                                // Envelope (seq + timestamp) - ordered and de-jittered by receiver,
+                                // frames released to the input buffer from the bridge task
+                                if (envelopeRx && envelopeRx->handleDatagram(packet.data(), len)) {
+                                    g_deviceStats.device4.rxPackets.fetch_add(1, std::memory_order_relaxed);
+                                } else if (len == 25) {
                                     // Single frame - validate
                                     if (packet.data()[0] == 0x0F) {
                                         udpRxBuffer->write(packet.data(), 25);
@@ -614,13 +660,24 @@ void initNetworkMode() {
                         log_msg(LOG_INFO, "UDP callback configured for SBUS protocol (filtering enabled)");
                     } else {
                         // RAW/MAVLink mode - accept all packets
-                        udpTransport->onPacket([](AsyncUDPPacket packet) {
+                        // With peer learning the sender replies to every source (GCS on any port)
+                        UdpPeerTable* peerTable = nullptr;
+                        if (config.device4.role == D4_NETWORK_BRIDGE && config.device4_config.learn_peers) {
+                            UdpPeerTable::enable();
+                            peerTable = UdpPeerTable::getInstance();
+                        }
+                        udpTransport->onPacket([peerTable](AsyncUDPPacket packet) {
                             if (udpRxBuffer) {
                                 udpRxBuffer->write(packet.data(), packet.length());
                                 g_deviceStats.device4.rxPackets.fetch_add(1, std::memory_order_relaxed);
+                                if (peerTable) {
+                                    peerTable->learn((uint32_t)packet.remoteIP(), packet.remotePort(),
+                                                     packet.length());
+                                }
                             }
                         });
-                        log_msg(LOG_INFO, "UDP callback configured for RAW/MAVLink protocol (no filtering)");
+                        log_msg(LOG_INFO, "UDP callback configured for RAW/MAVLink protocol (no filtering%s)",
+                                peerTable ? ", peer learning" : "");
                     }
                 }
             } else {
@@ -630,10 +687,12 @@ void initNetworkMode() {
         } else {
             log_msg(LOG_ERROR, "Failed to create UDP transport");
         }
+        boot_profile_mark(BOOT_PHASE_UDP);
     }
 
     // Initialize web server
     webserver_init(&config, &systemState);
+    boot_profile_mark(BOOT_PHASE_WEB_SERVER);
 }
 
 //================================================================
@@ -101,6 +101,10 @@ public:
         return sent;
     }
 
+    size_t getDirectWriteSpace() override {
+        return bluetoothBLE ? bluetoothBLE->availableForWrite() : 0;
+    }
+
     void processSendQueue(bool bulkMode = false) override {
         (void)bulkMode;  // BLE doesn't use bulk mode
 
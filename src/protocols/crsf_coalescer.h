@@ -0,0 +1,122 @@
+// CRSF binary output coalescing
+// One instance per binary output. Known RC/telemetry frame types keep only their
+// newest frame pending; each type group has its own maximum rate. Pending data is
+// bounded by the number of frame types, not by input rate, so a slow consumer
+// always receives the freshest frame of every type instead of a stale backlog.
+// Unknown types (MSP, device ping, parameters) are request/response traffic and
+// are forwarded immediately, never coalesced.
+#pragma once
+
+#include "crsf_protocol.h"
+#include "packet_sender.h"
+#include "../device_types.h"
+#include <Arduino.h>
+#include <string.h>
+
+// Coalesced frame types (slot index)
+static constexpr size_t CRSF_COALESCE_SLOTS = 7;
+
+// Slot -> rate group (matches CRSF filter groups, BARO_ALT grouped with GPS)
+static constexpr uint8_t CRSF_SLOT_RATE_GROUP[CRSF_COALESCE_SLOTS] = {0, 1, 2, 3, 3, 4, 5};
+
+class CrsfBinaryCoalescer {
+private:
+    struct Slot {
+        uint8_t data[CRSF_MAX_FRAME_SIZE];
+        uint8_t len;
+        bool pending;
+        uint32_t queuedUs;       // Arrival of pending frame (age tracking)
+        uint32_t lastSendMs;
+        uint32_t intervalMs;     // 0 = no rate limit
+    };
+
+    PacketSender* sender;
+    Slot slots[CRSF_COALESCE_SLOTS];
+
+    // Statistics
+    uint32_t framesForwarded = 0;
+    uint32_t framesCoalesced = 0;    // Superseded by newer frame of same type
+    uint32_t framesPassthrough = 0;  // Unknown types sent directly
+    uint32_t maxAgeUs = 0;           // Worst arrival -> send delay
+
+    // Frame type -> slot, -1 = not coalesced
+    static int slotForType(uint8_t type) {
+        switch (type) {
+            case CRSF_TYPE_RC_CHANNELS:  return 0;
+            case CRSF_TYPE_LINK_STATS:   return 1;
+            case CRSF_TYPE_BATTERY:      return 2;
+            case CRSF_TYPE_GPS:          return 3;
+            case CRSF_TYPE_BARO_ALT:     return 4;
+            case CRSF_TYPE_ATTITUDE:     return 5;
+            case CRSF_TYPE_FLIGHT_MODE:  return 6;
+            default: return -1;
+        }
+    }
+
+    bool trySend(Slot& s, uint32_t nowMs, uint32_t nowUs) {
+        if (s.intervalMs > 0 && (nowMs - s.lastSendMs) < s.intervalMs) return false;
+        if (sender->getDirectWriteSpace() < s.len) return false;  // Never send partial frames
+
+        // Short count = frame cut on the wire, don't mark it sent
+        if (sender->sendDirect(s.data, s.len) != s.len) return false;
+
+        uint32_t age = nowUs - s.queuedUs;
+        if (age > maxAgeUs) maxAgeUs = age;
+        s.pending = false;
+        s.lastSendMs = nowMs;
+        framesForwarded++;
+        return true;
+    }
+
+public:
+    // rateHz: per rate group (CRSF_RATE_GROUPS entries), 0 = unlimited
+    CrsfBinaryCoalescer(PacketSender* s, const uint8_t* rateHz) : sender(s) {
+        memset(slots, 0, sizeof(slots));
+        for (size_t i = 0; i < CRSF_COALESCE_SLOTS; i++) {
+            uint8_t hz = rateHz ? rateHz[CRSF_SLOT_RATE_GROUP[i]] : 0;
+            slots[i].intervalMs = hz ? (1000 / hz) : 0;
+        }
+    }
+
+    // New validated frame (addr + len + type + payload + crc)
+    void submit(const uint8_t* frame, size_t len, uint8_t type) {
+        int idx = slotForType(type);
+        if (idx < 0 || len > CRSF_MAX_FRAME_SIZE) {
+            if (sender->getDirectWriteSpace() >= len) sender->sendDirect(frame, len);
+            framesPassthrough++;
+            return;
+        }
+
+        Slot& s = slots[idx];
+        if (s.pending) framesCoalesced++;
+        memcpy(s.data, frame, len);
+        s.len = len;
+        s.pending = true;
+        s.queuedUs = micros();
+
+        trySend(s, millis(), s.queuedUs);
+    }
+
+    // Send pending frames whose rate slot has come and that fit (called every bridge loop)
+    void flush() {
+        uint32_t nowMs = millis();
+        uint32_t nowUs = micros();
+        for (size_t i = 0; i < CRSF_COALESCE_SLOTS; i++) {
+            if (slots[i].pending) trySend(slots[i], nowMs, nowUs);
+        }
+    }
+
+    size_t getPendingCount() const {
+        size_t n = 0;
+        for (size_t i = 0; i < CRSF_COALESCE_SLOTS; i++) {
+            if (slots[i].pending) n++;
+        }
+        return n;
+    }
+
+    PacketSender* getSender() const { return sender; }
+    uint32_t getFramesForwarded() const { return framesForwarded; }
+    uint32_t getFramesCoalesced() const { return framesCoalesced; }
+    uint32_t getFramesPassthrough() const { return framesPassthrough; }
+    uint32_t getMaxAgeUs() const { return maxAgeUs; }
+};
@@ -1,25 +1,29 @@
 // CRSF/ELRS Frame Parser with text and binary output
 // Parses CRSF frames from CircularBuffer, sends to registered outputs:
 //   - Text outputs: human-readable format with per-output RC rate limiting
-//   - Binary outputs: raw CRSF frames forwarded as-is (no rate limiting)
+//   - Binary outputs: raw CRSF frames forwarded as-is, coalesced per frame type
+//   - SBUS conversion (optional): RC channels fed to SbusRouter as Device1 source
 #pragma once
 
 #include "protocol_parser.h"
 #include "crsf_protocol.h"
 #include "rc_channels.h"
+#include "rc_text_format.h"
+#include "crsf_sbus_converter.h"
+#include "crsf_coalescer.h"
 #include "packet_sender.h"
 #include "../config.h"
 #include "../device_stats.h"
 #include "../logging.h"
 #include <vector>
-#include <stdio.h>
+#include <stdlib.h>
 
 // Forward declarations
 extern Config config;
 
-// Text output buffer: longest line is RC with 16 channels
-// "RC " + 16*5 + 15 commas + "\r\n" + null = ~100 bytes, round up
+// Text output buffer: longest line is RC in R2D2 format (RC_TEXT_R2D2_SIZE = 172 bytes)
 static constexpr size_t CRSF_TEXT_BUFFER_SIZE = 200;
+static_assert(CRSF_TEXT_BUFFER_SIZE >= RC_TEXT_BUFFER_SIZE, "CRSF text buffer too small for RC line");
 
 class CrsfParser : public ProtocolParser {
 private:
@@ -51,31 +55,28 @@ private:
         }
     }
 
-    // Binary outputs: raw CRSF frames forwarded without conversion (no rate limiting)
-    std::vector<PacketSender*> binaryOutputs;
+    // Binary outputs: raw CRSF frames forwarded without conversion, newest frame per type
+    std::vector<CrsfBinaryCoalescer*> binaryOutputs;
+
+    // CRSF -> SBUS conversion (nullptr when no SBUS outputs configured)
+    CrsfSbusConverter* sbusConverter = nullptr;
 
     // Text output buffer
     char textBuf[CRSF_TEXT_BUFFER_SIZE];
 
-    // Format RC channels frame to text: "RC 1500,1500,...\r\n"
+    // Format RC channels frame to text in selected RC text format (ESP-Bridge or R2D2)
     size_t formatRcChannels(const uint8_t* payload, size_t payloadLen) {
         if (payloadLen < CRSF_RC_PAYLOAD_SIZE) return 0;
 
         uint16_t channels[CRSF_RC_CHANNELS];
         unpackCrsfChannels(payload, channels);
 
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "RC %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\r\n",
-            crsfToUs(channels[0]),  crsfToUs(channels[1]),
-            crsfToUs(channels[2]),  crsfToUs(channels[3]),
-            crsfToUs(channels[4]),  crsfToUs(channels[5]),
-            crsfToUs(channels[6]),  crsfToUs(channels[7]),
-            crsfToUs(channels[8]),  crsfToUs(channels[9]),
-            crsfToUs(channels[10]), crsfToUs(channels[11]),
-            crsfToUs(channels[12]), crsfToUs(channels[13]),
-            crsfToUs(channels[14]), crsfToUs(channels[15]));
-
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        int us[RC_TEXT_CHANNELS];
+        for (size_t i = 0; i < RC_TEXT_CHANNELS; i++) {
+            us[i] = crsfToUs(channels[i]);
+        }
+
+        return formatRcText(us, textBuf, sizeof(textBuf), config.rcTextFormat);
     }
 
     // Format Link Statistics: "LQ upRSSI,upLQ,upSNR,rfMode,txPower,dnRSSI,dnLQ,dnSNR\r\n"
@@ -93,13 +94,18 @@ private:
         // [7] downlink RSSI (dBm, unsigned)
         // [8] downlink Link Quality (%)
         // [9] downlink SNR (dB, signed)
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "LQ -%d,%d,%d,%d,%d,-%d,%d,%d\r\n",
-            payload[0], payload[2], (int8_t)payload[3],
-            payload[5], payload[6],
-            payload[7], payload[8], (int8_t)payload[9]);
-
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        char* p = rcFmtStr(textBuf, "LQ -");
+        p = rcFmtUint(p, payload[0]);            *p++ = ',';
+        p = rcFmtUint(p, payload[2]);            *p++ = ',';
+        p = rcFmtInt(p, (int8_t)payload[3]);     *p++ = ',';
+        p = rcFmtUint(p, payload[5]);            *p++ = ',';
+        p = rcFmtUint(p, payload[6]);            *p++ = ',';
+        *p++ = '-';
+        p = rcFmtUint(p, payload[7]);            *p++ = ',';
+        p = rcFmtUint(p, payload[8]);            *p++ = ',';
+        p = rcFmtInt(p, (int8_t)payload[9]);
+
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Format Battery: "BAT voltage,current,mAh,remaining\r\n"
@@ -115,13 +121,15 @@ private:
         uint16_t current = (payload[2] << 8) | payload[3];
         uint32_t capacity = (payload[4] << 16) | (payload[5] << 8) | payload[6];
 
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "BAT %d.%d,%d.%d,%lu,%d\r\n",
-            voltage / 10, voltage % 10,
-            current / 10, current % 10,
-            (unsigned long)capacity, payload[7]);
+        char* p = rcFmtStr(textBuf, "BAT ");
+        p = rcFmtUint(p, voltage / 10);  *p++ = '.';
+        p = rcFmtUint(p, voltage % 10);  *p++ = ',';
+        p = rcFmtUint(p, current / 10);  *p++ = '.';
+        p = rcFmtUint(p, current % 10);  *p++ = ',';
+        p = rcFmtUint(p, capacity);      *p++ = ',';
+        p = rcFmtUint(p, payload[7]);
 
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Format GPS: "GPS lat,lon,groundspeed,heading,alt,sats\r\n"
@@ -141,15 +149,20 @@ private:
         uint16_t heading = (payload[10] << 8) | payload[11];
         int16_t alt = ((payload[12] << 8) | payload[13]) - 1000;
 
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "GPS %ld.%07ld,%ld.%07ld,%d.%d,%d.%02d,%d,%d\r\n",
-            (long)(lat / 10000000L), (long)(abs(lat) % 10000000L),
-            (long)(lon / 10000000L), (long)(abs(lon) % 10000000L),
-            speed / 10, speed % 10,
-            heading / 100, heading % 100,
-            alt, payload[14]);
-
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        // Integer part keeps C division semantics (same output as former "%ld.%07ld")
+        char* p = rcFmtStr(textBuf, "GPS ");
+        p = rcFmtInt(p, lat / 10000000L);                          *p++ = '.';
+        p = rcFmtUintPadded(p, abs(lat) % 10000000L, 7);           *p++ = ',';
+        p = rcFmtInt(p, lon / 10000000L);                          *p++ = '.';
+        p = rcFmtUintPadded(p, abs(lon) % 10000000L, 7);           *p++ = ',';
+        p = rcFmtUint(p, speed / 10);                              *p++ = '.';
+        p = rcFmtUint(p, speed % 10);                              *p++ = ',';
+        p = rcFmtUint(p, heading / 100);                           *p++ = '.';
+        p = rcFmtUintPadded(p, heading % 100, 2);                  *p++ = ',';
+        p = rcFmtInt(p, alt);                                      *p++ = ',';
+        p = rcFmtUint(p, payload[14]);
+
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Format Attitude: "ATT pitch,roll,yaw\r\n"
@@ -169,13 +182,15 @@ private:
         int rollDeg10  = (int)(roll * 573L / 1000);
         int yawDeg10   = (int)(yaw * 573L / 1000);
 
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "ATT %d.%d,%d.%d,%d.%d\r\n",
-            pitchDeg10 / 10, abs(pitchDeg10) % 10,
-            rollDeg10 / 10, abs(rollDeg10) % 10,
-            yawDeg10 / 10, abs(yawDeg10) % 10);
+        char* p = rcFmtStr(textBuf, "ATT ");
+        p = rcFmtInt(p, pitchDeg10 / 10);         *p++ = '.';
+        p = rcFmtUint(p, abs(pitchDeg10) % 10);   *p++ = ',';
+        p = rcFmtInt(p, rollDeg10 / 10);          *p++ = '.';
+        p = rcFmtUint(p, abs(rollDeg10) % 10);    *p++ = ',';
+        p = rcFmtInt(p, yawDeg10 / 10);           *p++ = '.';
+        p = rcFmtUint(p, abs(yawDeg10) % 10);
 
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Format Flight Mode: "FM modename\r\n"
@@ -185,17 +200,12 @@ private:
         // Flight mode is a null-terminated string
         size_t maxStr = (payloadLen < 20) ? payloadLen : 20;
 
-        int len = snprintf(textBuf, sizeof(textBuf), "FM ");
+        char* p = rcFmtStr(textBuf, "FM ");
         for (size_t i = 0; i < maxStr && payload[i] != 0; i++) {
-            if (len < (int)sizeof(textBuf) - 3) {
-                textBuf[len++] = payload[i];
-            }
+            *p++ = payload[i];
         }
-        textBuf[len++] = '\r';
-        textBuf[len++] = '\n';
-        textBuf[len] = '\0';
 
-        return len;
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Format Baro Altitude: "ALT altitude,vario\r\n"
@@ -208,12 +218,13 @@ private:
         int16_t altDm = ((payload[0] << 8) | payload[1]) - 10000;
         int16_t varioCms = (int16_t)((payload[2] << 8) | payload[3]);
 
-        int len = snprintf(textBuf, sizeof(textBuf),
-            "ALT %d.%d,%d.%02d\r\n",
-            altDm / 10, abs(altDm) % 10,
-            varioCms / 100, abs(varioCms) % 100);
+        char* p = rcFmtStr(textBuf, "ALT ");
+        p = rcFmtInt(p, altDm / 10);                        *p++ = '.';
+        p = rcFmtUint(p, abs(altDm) % 10);                  *p++ = ',';
+        p = rcFmtInt(p, varioCms / 100);                    *p++ = '.';
+        p = rcFmtUintPadded(p, abs(varioCms) % 100, 2);
 
-        return (len > 0 && (size_t)len < sizeof(textBuf)) ? len : 0;
+        return rcFmtEndLine(textBuf, p);
     }
 
     // Send telemetry text to filtered text outputs (no rate limiting)
@@ -242,12 +253,12 @@ private:
         }
     }
 
-    // Send raw CRSF frame to all binary outputs (no rate limiting, full throughput)
-    void sendRawToOutputs(const uint8_t* data, size_t len) {
+    // Send raw CRSF frame to all binary outputs (coalesced per type, per-type rate limit)
+    void sendRawToOutputs(const uint8_t* data, size_t len, uint8_t type) {
         if (len == 0 || binaryOutputs.empty()) return;
 
-        for (auto* sender : binaryOutputs) {
-            sender->sendDirect(data, len);
+        for (auto* out : binaryOutputs) {
+            out->submit(data, len, type);
         }
     }
 
@@ -261,14 +272,20 @@ private:
                 if (payloadLen >= CRSF_RC_PAYLOAD_SIZE) {
                     uint16_t raw[16];
                     unpackCrsfChannels(payload, raw);
-                    for (int i = 0; i < 16; i++) rcChannels.channels[i] = crsfToUs(raw[i]);
-                    rcChannels.lastUpdateMs = millis();
+                    for (int i = 0; i < 16; i++) raw[i] = crsfToUs(raw[i]);
+                    rc_channels_publish(raw, RC_SOURCE_CRSF, 0, 0, millis());
+                }
+                if (sbusConverter) {
+                    sbusConverter->onRcChannels(payload, payloadLen);
                 }
                 textLen = formatRcChannels(payload, payloadLen);
                 sendTextRcToOutputs(textLen);  // Per-output rate limiting + filter
                 return;
             }
             case CRSF_TYPE_LINK_STATS:
+                if (sbusConverter) {
+                    sbusConverter->onLinkStats(payload, payloadLen);
+                }
                 textLen = formatLinkStats(payload, payloadLen);
                 break;
             case CRSF_TYPE_BATTERY:
@@ -314,15 +331,42 @@ public:
         log_msg(LOG_INFO, "CRSF text output: %s (%d Hz, filter: 0x%02X, total: %zu)", sender->getName(), rateHz, filter, textOutputs.size());
     }
 
-    // Register binary output for raw CRSF frame forwarding (no rate limiting)
+    // Change rate/filter of a registered text output (bridge task, see ProtocolPipeline::requestReconfigure)
+    void updateTextOutput(PacketSender* sender, uint8_t rateHz, uint8_t filter) {
+        for (auto& out : textOutputs) {
+            if (out.sender != sender) continue;
+            out.rateIntervalMs = (rateHz > 0 && rateHz <= 100) ? (1000 / rateHz) : 0;
+            out.crsfFilter = filter;
+            log_msg(LOG_INFO, "CRSF text output: %s updated (%d Hz, filter: 0x%02X)", sender->getName(), rateHz, filter);
+        }
+    }
+
+    // Register binary output for raw CRSF frame forwarding (per-type rates from config)
     void registerBinaryOutput(PacketSender* sender) {
         if (!sender) return;
-        binaryOutputs.push_back(sender);
+        binaryOutputs.push_back(new CrsfBinaryCoalescer(sender, config.crsfBinaryRate));
         log_msg(LOG_INFO, "CRSF binary output: %s (total: %zu)", sender->getName(), binaryOutputs.size());
     }
 
+    // Enable CRSF -> SBUS conversion (called during pipeline setup when SBUS outputs exist)
+    void enableSbusOutput() {
+        if (sbusConverter) return;
+        sbusConverter = new CrsfSbusConverter();
+        log_msg(LOG_INFO, "CRSF -> SBUS conversion enabled (router source: Device1)");
+    }
+
+    const CrsfSbusConverter* getSbusConverter() const { return sbusConverter; }
+
     // Fast path: parse CRSF frames from circular buffer
     bool tryFastProcess(CircularBuffer* buffer, BridgeContext* ctx) override {
+        // Flush coalesced SBUS frame once its output slot has come
+        if (sbusConverter) sbusConverter->poll();
+
+        // Flush rate-limited / backpressured binary frames
+        for (auto* out : binaryOutputs) {
+            out->flush();
+        }
+
         size_t avail = buffer->available();
         if (avail < CRSF_MIN_FRAME_SIZE) return false;
 
@@ -376,7 +420,7 @@ public:
         size_t payloadLen = frameLen - 2;  // Subtract type and CRC
 
         // Forward raw frame to binary outputs BEFORE consume (view.ptr still valid)
-        sendRawToOutputs(view.ptr, totalSize);
+        sendRawToOutputs(view.ptr, totalSize, view.ptr[2]);
 
         // Consume frame from buffer
         buffer->consume(totalSize);
@@ -418,4 +462,7 @@ public:
     uint32_t getInvalidFrames() const { return invalidFrames; }
     uint32_t getCrcErrors() const { return crcErrors; }
     uint32_t getLastFrameTime() const { return lastFrameTime; }
+
+    // Binary output coalescing (for Web UI stats)
+    const std::vector<CrsfBinaryCoalescer*>& getBinaryOutputs() const { return binaryOutputs; }
 };
@@ -0,0 +1,99 @@
+// CRSF -> SBUS conversion for SbusRouter
+// Turns CRSF RC_CHANNELS_PACKED into 25-byte SBUS frames and feeds them to SbusRouter
+// as the Device1 source, so a CRSF/ELRS receiver can drive SBUS outputs and failover.
+//
+// Channel mapping is lossless: CRSF and SBUS share the same 11-bit scale
+// (172 = 988us, 992 = 1500us, 1811 = 2012us) and the same LSB-first packing,
+// so the 22-byte CRSF payload is the SBUS channel block as-is.
+//
+// Flags come from the latest LINK_STATISTICS (uplink LQ):
+//   LQ == 0                       -> failsafe
+//   LQ < CRSF_SBUS_FRAMELOST_LQ   -> frame lost
+//
+// Coalescing: ELRS delivers 250/500/1000 Hz, SBUS outputs run at 7-20 ms.
+// Only the newest frame is kept; it is handed to the router at most once per
+// output period. With the router output scheduler active every frame is passed
+// through - the router keeps only the latest value itself.
+#pragma once
+
+#include "sbus_common.h"
+#include "sbus_router.h"
+#include "crsf_protocol.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define CRSF_SBUS_FRAMELOST_LQ      50      // Uplink LQ (%) below which frame-lost is set
+#define CRSF_SBUS_DEFAULT_PERIOD_US 7000    // Router without scheduler: fastest SBUS cadence
+
+class CrsfSbusConverter {
+private:
+    uint8_t frame[SBUS_FRAME_SIZE];
+    bool pending = false;           // Newest frame not yet routed
+    uint32_t lastRouteUs = 0;
+    uint32_t periodUs = CRSF_SBUS_DEFAULT_PERIOD_US;
+    uint8_t flags = 0;              // Derived from LINK_STATISTICS
+
+    // Statistics
+    uint32_t framesIn = 0;
+    uint32_t framesRouted = 0;
+    uint32_t framesCoalesced = 0;   // Superseded before routing
+
+    void route(uint32_t nowUs) {
+        SbusRouter::getInstance()->routeFrame(frame, SBUS_SOURCE_DEVICE1);
+        pending = false;
+        lastRouteUs = nowUs;
+        framesRouted++;
+    }
+
+public:
+    CrsfSbusConverter() {
+        memset(frame, 0, sizeof(frame));
+        frame[0] = SBUS_START_BYTE;
+        frame[SBUS_FRAME_SIZE - 1] = SBUS_END_BYTE;
+    }
+
+    // RC_CHANNELS_PACKED payload (22 bytes)
+    void onRcChannels(const uint8_t* payload, size_t payloadLen) {
+        if (payloadLen < CRSF_RC_PAYLOAD_SIZE) return;
+
+        if (pending) framesCoalesced++;
+        memcpy(frame + 1, payload, CRSF_RC_PAYLOAD_SIZE);
+        frame[23] = flags;
+        pending = true;
+        framesIn++;
+
+        poll();
+    }
+
+    // LINK_STATISTICS payload (10 bytes), [2] = uplink LQ
+    void onLinkStats(const uint8_t* payload, size_t payloadLen) {
+        if (payloadLen < 10) return;
+
+        uint8_t lq = payload[2];
+        if (lq == 0) {
+            flags = SBUS_FLAG_FAILSAFE | SBUS_FLAG_FRAME_LOST;
+        } else if (lq < CRSF_SBUS_FRAMELOST_LQ) {
+            flags = SBUS_FLAG_FRAME_LOST;
+        } else {
+            flags = 0;
+        }
+    }
+
+    // Route pending frame when output period has elapsed (called every bridge loop)
+    void poll() {
+        if (!pending) return;
+
+        uint32_t nowUs = micros();
+        SbusRouter* router = SbusRouter::getInstance();
+
+        // Scheduler coalesces itself - pass through for lowest latency
+        if (router->isOutputSchedulerActive() || (nowUs - lastRouteUs) >= periodUs) {
+            route(nowUs);
+        }
+    }
+
+    uint32_t getFramesIn() const { return framesIn; }
+    uint32_t getFramesRouted() const { return framesRouted; }
+    uint32_t getFramesCoalesced() const { return framesCoalesced; }
+    uint8_t getFlags() const { return flags; }
+};
@@ -2,93 +2,159 @@
 #define LINE_BASED_PARSER_H
 
 #include "protocol_parser.h"
+#include "packet_memory_pool.h"
+#include "../logging.h"
+#include <Arduino.h>
 
+// Line-based parser with batched emission
+// Complete lines are collected into one packet until the next line would not fit
+// (batchSize) or the oldest pending line has waited batchWindowMs. Lines are never
+// split between packets, except a line longer than MAX_LINE_LENGTH, which is
+// forwarded in MAX_LINE_LENGTH pieces. Packet memory comes from PacketMemoryPool.
+// parseTimeMicros of a batch is the time its oldest line was first seen.
 class LineBasedParser : public ProtocolParser {
 private:
     static constexpr size_t MAX_LINE_LENGTH = 256;
-    
-    size_t findNewline(CircularBuffer* buffer) {
-        size_t avail = buffer->available();
-        if (avail == 0) return 0;
-        
-        size_t searchLen = std::min(avail, MAX_LINE_LENGTH);
-        ContiguousView view = buffer->getContiguousForParser(searchLen);
-        
-        for (size_t i = 0; i < view.safeLen; i++) {
-            if (view.ptr[i] == '\n') {
-                // Check if preceded by \r for \r\n support
-                if (i > 0 && view.ptr[i-1] == '\r') {
-                    return i + 1;  // Include both \r\n
-                }
-                return i + 1;  // Include \n
-            }
-            // Also handle standalone \r as line ending (old Mac style)
-            if (view.ptr[i] == '\r') {
-                // Check if followed by \n
-                if (i + 1 < view.safeLen && view.ptr[i+1] == '\n') {
-                    return i + 2;  // Include \r\n
-                }
-                return i + 1;  // Just \r
+    static constexpr size_t MAX_BATCH_SIZE = 512;   // Largest pool block
+
+    size_t batchSize;           // Max bytes per packet (MAX_LINE_LENGTH..MAX_BATCH_SIZE)
+    uint32_t batchWindowMs;     // Max wait for more lines, 0 = emit immediately
+    PacketMemoryPool* memPool;
+
+    // Scan state - only this parser consumes the buffer, so bytes already
+    // scanned stay valid between calls and are never rescanned
+    size_t scannedLen;          // Bytes scanned from buffer head
+    size_t completeLen;         // Bytes of complete lines at buffer head
+    size_t pendingLines;        // Lines within completeLen
+    uint32_t pendingSinceMs;    // First complete line seen (window start)
+    uint32_t pendingSinceUs;    // Same, for parseTimeMicros
+
+    // Scan new bytes for line endings ('\n', '\r\n' or standalone '\r')
+    void scanLines(CircularBuffer* buffer, size_t avail, uint32_t currentTime) {
+        size_t limit = std::min(avail, batchSize);
+        if (scannedLen >= limit) return;
+
+        auto seg = buffer->getReadSegments();
+        auto at = [&seg](size_t i) -> uint8_t {
+            return (i < seg.first.size) ? seg.first.data[i] : seg.second.data[i - seg.first.size];
+        };
+
+        size_t i = scannedLen;
+        while (i < limit) {
+            uint8_t b = at(i++);
+            if (b != '\n' && b != '\r') continue;
+
+            if (b == '\r' && i < limit && at(i) == '\n') i++;
+
+            if (pendingLines == 0) {
+                pendingSinceMs = currentTime;
+                pendingSinceUs = micros();
             }
+            completeLen = i;
+            pendingLines++;
         }
-        return 0;  // No line ending found
+        scannedLen = limit;
+    }
+
+    // Copy head of buffer into a pool block
+    bool emit(CircularBuffer* buffer, size_t len, uint32_t timestampUs, ParseResult& result) {
+        size_t allocSize;
+        uint8_t* data = memPool->allocate(len, allocSize);
+        if (!data) {
+            log_msg(LOG_ERROR, "[LineBased] Failed to allocate %zu bytes", len);
+            return false;
+        }
+
+        auto seg = buffer->getReadSegments();
+        size_t first = std::min((size_t)seg.first.size, len);
+        memcpy(data, seg.first.data, first);
+        if (len > first) {
+            memcpy(data + first, seg.second.data, len - first);
+        }
+
+        result.packets = new ParsedPacket[1];
+        result.count = 1;
+        result.packets[0].data = data;
+        result.packets[0].size = len;
+        result.packets[0].allocSize = allocSize;
+        result.packets[0].pool = memPool;
+        result.packets[0].format = DataFormat::FORMAT_RAW;
+        result.packets[0].hints.keepWhole = true;
+        result.packets[0].parseTimeMicros = timestampUs;
+        result.bytesConsumed = len;
+
+        scannedLen -= len;
+        return true;
     }
-    
+
 public:
+    LineBasedParser(size_t batchBytes = MAX_BATCH_SIZE, uint32_t windowMs = 20) :
+        batchWindowMs(windowMs),
+        scannedLen(0),
+        completeLen(0),
+        pendingLines(0),
+        pendingSinceMs(0),
+        pendingSinceUs(0) {
+        batchSize = std::max(MAX_LINE_LENGTH, std::min(batchBytes, MAX_BATCH_SIZE));
+        memPool = PacketMemoryPool::getInstance();
+    }
+
     ParseResult parse(CircularBuffer* buffer, uint32_t currentTime) override {
         ParseResult result;
         result.count = 0;
         result.bytesConsumed = 0;
-        
+
         size_t avail = buffer->available();
-        if (avail == 0) return result;
-        
-        // Find line ending
-        size_t lineLen = findNewline(buffer);
-        
-        // If no line ending found and we have MAX_LINE_LENGTH bytes
-        if (lineLen == 0 && avail >= MAX_LINE_LENGTH) {
-            // Treat as broken line - consume without creating packet
-            result.bytesConsumed = MAX_LINE_LENGTH;
-            log_msg(LOG_WARNING, "[LineBased] Skipping %zu bytes without line ending", MAX_LINE_LENGTH);
+        if (avail == 0) {
+            reset();
             return result;
         }
-        
-        // If no complete line yet, wait for more data
-        if (lineLen == 0) {
+
+        scanLines(buffer, avail, currentTime);
+
+        if (pendingLines > 0) {
+            // Emit when no further line fits or the window has expired
+            bool full = (scannedLen >= batchSize);
+            bool expired = (currentTime - pendingSinceMs) >= batchWindowMs;
+            if (!full && !expired) return result;
+
+            size_t len = completeLen;
+            size_t lines = pendingLines;
+            if (!emit(buffer, len, pendingSinceUs, result)) return result;
+
+            completeLen = 0;
+            pendingLines = 0;
+            if (stats) {
+                stats->packetsDetected += lines;
+                stats->totalBytes += len;
+            }
             return result;
         }
-        
-        // Get line data
-        ContiguousView view = buffer->getContiguousForParser(lineLen);
-        
-        // Create packet for complete line
-        result.packets = new ParsedPacket[1];
-        result.count = 1;
-        
-        result.packets[0].data = new uint8_t[lineLen];
-        result.packets[0].size = lineLen;
-        result.packets[0].allocSize = lineLen;
-        result.packets[0].format = DataFormat::FORMAT_RAW;
-        result.packets[0].hints.keepWhole = true;
-        
-        result.packets[0].parseTimeMicros = micros();
-        
-        memcpy(result.packets[0].data, view.ptr, lineLen);
-        
-        result.bytesConsumed = lineLen;
-        
-        if (stats) {
-            stats->packetsDetected++;
-            stats->totalBytes += lineLen;
+
+        // Overlong line: forward a piece instead of waiting forever or dropping it
+        if (scannedLen >= MAX_LINE_LENGTH) {
+            if (emit(buffer, MAX_LINE_LENGTH, micros(), result)) {
+                log_msg(LOG_DEBUG, "[LineBased] Line longer than %zu bytes forwarded in pieces", MAX_LINE_LENGTH);
+                if (stats) {
+                    stats->packetsDetected++;
+                    stats->totalBytes += MAX_LINE_LENGTH;
+                }
+            }
         }
-        
+
         return result;
     }
-    
-    void reset() override {}
+
+    void reset() override {
+        scannedLen = 0;
+        completeLen = 0;
+        pendingLines = 0;
+        pendingSinceMs = 0;
+        pendingSinceUs = 0;
+    }
+
     const char* getName() const override { return "LineBased"; }
-    size_t getMinimumBytes() const override { return 2; }
+    size_t getMinimumBytes() const override { return 1; }
 };
 
-#endif
\ No newline at end of file
+#endif
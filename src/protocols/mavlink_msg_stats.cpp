@@ -0,0 +1,101 @@
+#include "mavlink_msg_stats.h"
+#include "../logging.h"
+#include "esp_heap_caps.h"
+#include <new>
+
+bool MavlinkMsgStats::enabled = false;
+
+static uint32_t sortValue(const MsgIdCounters& c, MavlinkMsgStats::SortKey key) {
+    switch (key) {
+        case MavlinkMsgStats::SORT_PACKETS: return c.rxPackets + c.txPackets;
+        case MavlinkMsgStats::SORT_DROPS:   return c.txDrops;
+        default:                            return c.rxBytes + c.txBytes;
+    }
+}
+
+static void addCounters(MsgIdCounters& total, const MsgIdCounters& c) {
+    total.rxPackets += c.rxPackets;
+    total.rxBytes += c.rxBytes;
+    total.txPackets += c.txPackets;
+    total.txBytes += c.txBytes;
+    total.txDrops += c.txDrops;
+    for (int i = 0; i < MAX_SENDERS; i++) {
+        total.rxByIface[i] += c.rxByIface[i];
+        total.txBySender[i] += c.txBySender[i];
+    }
+}
+
+bool MavlinkMsgStats::enable() {
+    if (enabled) return true;
+
+    size_t size = sizeof(Slot) * MSG_STATS_SLOTS;
+    void* mem = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!mem) {
+        mem = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (!mem) {
+        log_msg(LOG_ERROR, "MAVLink msgid stats: failed to allocate %zu bytes", size);
+        return false;
+    }
+
+    slots = static_cast<Slot*>(mem);
+    for (size_t i = 0; i < MSG_STATS_SLOTS; i++) {
+        new (&slots[i].key) std::atomic<uint32_t>(0);
+        memset(&slots[i].counters, 0, sizeof(MsgIdCounters));
+    }
+    memset(&other, 0, sizeof(other));
+
+    enabled = true;
+    log_msg(LOG_INFO, "MAVLink msgid stats enabled: %d slots, %zu bytes", MSG_STATS_SLOTS, size);
+    return true;
+}
+
+void MavlinkMsgStats::clear() {
+    for (size_t i = 0; i < MSG_STATS_SLOTS; i++) {
+        slots[i].key.store(0, std::memory_order_relaxed);
+        memset(&slots[i].counters, 0, sizeof(MsgIdCounters));
+    }
+    memset(&other, 0, sizeof(other));
+    resetPending.store(false, std::memory_order_relaxed);
+}
+
+size_t MavlinkMsgStats::getTop(MsgIdStat* out, size_t maxCount, SortKey key) const {
+    if (!enabled || maxCount == 0) return 0;
+
+    // Insertion into a small sorted array - maxCount is at most MSG_STATS_TOP_MAX
+    size_t count = 0;
+    for (size_t i = 0; i < MSG_STATS_SLOTS; i++) {
+        uint32_t k = slots[i].key.load(std::memory_order_acquire);
+        if (k == 0) continue;
+
+        MsgIdStat entry;
+        entry.msgId = k - 1;
+        memcpy(&entry.counters, &slots[i].counters, sizeof(MsgIdCounters));
+        uint32_t value = sortValue(entry.counters, key);
+
+        size_t pos = count;
+        while (pos > 0 && sortValue(out[pos - 1].counters, key) < value) pos--;
+        if (pos >= maxCount) continue;
+
+        size_t last = (count < maxCount) ? count : maxCount - 1;
+        memmove(&out[pos + 1], &out[pos], (last - pos) * sizeof(MsgIdStat));
+        out[pos] = entry;
+        if (count < maxCount) count++;
+    }
+    return count;
+}
+
+void MavlinkMsgStats::getTotals(MsgIdCounters& total, MsgIdCounters& untracked, size_t& tracked) const {
+    memset(&total, 0, sizeof(total));
+    memset(&untracked, 0, sizeof(untracked));
+    tracked = 0;
+    if (!enabled) return;
+
+    for (size_t i = 0; i < MSG_STATS_SLOTS; i++) {
+        if (slots[i].key.load(std::memory_order_acquire) == 0) continue;
+        addCounters(total, slots[i].counters);
+        tracked++;
+    }
+    memcpy(&untracked, &other, sizeof(untracked));
+    addCounters(total, untracked);
+}
@@ -0,0 +1,117 @@
+#ifndef MAVLINK_MSG_STATS_H
+#define MAVLINK_MSG_STATS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "protocol_types.h"
+
+// Per-msgid MAVLink traffic accounting (/api/mavlink/messages)
+// Fixed open-addressing table keyed by msgid, updated by the bridge task only (parsed
+// input and sender enqueue in ProtocolPipeline), so counters are plain increments and
+// readers never lock. Msgids that find no free slot within MSG_STATS_MAX_PROBE are
+// counted in a shared "other" entry, so totals always add up.
+
+#define MSG_STATS_SLOT_BITS     7
+#define MSG_STATS_SLOTS         (1 << MSG_STATS_SLOT_BITS)  // ArduPilot streams ~60-80 ids
+#define MSG_STATS_MAX_PROBE     8
+#define MSG_STATS_TOP_DEFAULT   10
+#define MSG_STATS_TOP_MAX       32
+
+struct MsgIdCounters {
+    uint32_t rxPackets;
+    uint32_t rxBytes;
+    uint32_t txPackets;                     // Accepted by a sender queue
+    uint32_t txBytes;
+    uint32_t txDrops;                       // Rejected by a full sender queue
+    uint32_t rxByIface[MAX_SENDERS];        // Packets per input interface
+    uint32_t txBySender[MAX_SENDERS];       // Packets per sender (accepted)
+};
+
+struct MsgIdStat {
+    uint32_t msgId;
+    MsgIdCounters counters;
+};
+
+class MavlinkMsgStats {
+public:
+    enum SortKey : uint8_t { SORT_BYTES, SORT_PACKETS, SORT_DROPS };
+
+    static MavlinkMsgStats* getInstance() {
+        static MavlinkMsgStats instance;
+        return &instance;
+    }
+
+    // Allocate the table (pipeline init, MAVLink mode only)
+    bool enable();
+    static inline bool isEnabled() { return enabled; }
+
+    // Bridge task hooks
+    inline void onRx(const ParsedPacket& packet, uint8_t iface) {
+        if (packet.protocol != PacketProtocol::MAVLINK) return;
+        MsgIdCounters* c = lookup(packet.protocolMsgId);
+        c->rxPackets++;
+        c->rxBytes += packet.size;
+        if (iface < MAX_SENDERS) c->rxByIface[iface]++;
+    }
+    inline void onTx(const ParsedPacket& packet, uint8_t sender, bool queued) {
+        if (packet.protocol != PacketProtocol::MAVLINK) return;
+        MsgIdCounters* c = lookup(packet.protocolMsgId);
+        if (queued) {
+            c->txPackets++;
+            c->txBytes += packet.size;
+            c->txBySender[sender]++;
+        } else {
+            c->txDrops++;
+        }
+    }
+
+    // Clear all counters - done by the bridge task on its next update
+    void requestReset() { resetPending.store(true, std::memory_order_relaxed); }
+
+    // Bridge task, every loop: apply a requested reset even when no packets arrive
+    inline void applyPendingReset() {
+        if (resetPending.load(std::memory_order_relaxed)) clear();
+    }
+
+    // Readers (web task). Counters are copied without locking; values may be one packet apart.
+    size_t getTop(MsgIdStat* out, size_t maxCount, SortKey key) const;
+    void getTotals(MsgIdCounters& total, MsgIdCounters& other, size_t& tracked) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> key;          // msgId + 1, 0 = free
+        MsgIdCounters counters;
+    };
+
+    static bool enabled;
+
+    Slot* slots;
+    MsgIdCounters other;
+    std::atomic<bool> resetPending;
+
+    MavlinkMsgStats() : slots(nullptr), other{}, resetPending(false) {}
+    MavlinkMsgStats(const MavlinkMsgStats&) = delete;
+    MavlinkMsgStats& operator=(const MavlinkMsgStats&) = delete;
+
+    void clear();
+
+    inline MsgIdCounters* lookup(uint32_t msgId) {
+        if (resetPending.load(std::memory_order_relaxed)) clear();
+
+        uint32_t key = msgId + 1;
+        uint32_t h = (msgId * 2654435761u) >> (32 - MSG_STATS_SLOT_BITS);
+        for (uint32_t probe = 0; probe < MSG_STATS_MAX_PROBE; probe++) {
+            Slot& s = slots[(h + probe) & (MSG_STATS_SLOTS - 1)];
+            uint32_t k = s.key.load(std::memory_order_relaxed);
+            if (k == key) return &s.counters;
+            if (k == 0) {
+                // Counters of a free slot are zero - publish the key for readers
+                s.key.store(key, std::memory_order_release);
+                return &s.counters;
+            }
+        }
+        return &other;
+    }
+};
+
+#endif // MAVLINK_MSG_STATS_H
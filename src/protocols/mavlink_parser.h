@@ -310,8 +310,7 @@ private:
                                     rc.chan5_raw, rc.chan6_raw, rc.chan7_raw, rc.chan8_raw,
                                     rc.chan9_raw, rc.chan10_raw, rc.chan11_raw, rc.chan12_raw,
                                     rc.chan13_raw, rc.chan14_raw, rc.chan15_raw, rc.chan16_raw };
-            for (int i = 0; i < RC_CHANNEL_COUNT; i++) rcChannels.channels[i] = ch[i];
-            rcChannels.lastUpdateMs = millis();
+            rc_channels_publish(ch, RC_SOURCE_MAVLINK, 0, 0, millis());
         } else if (msg->msgid == MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE) {
             mavlink_rc_channels_override_t rc;
             mavlink_msg_rc_channels_override_decode(msg, &rc);
@@ -319,8 +318,7 @@ private:
                                     rc.chan5_raw, rc.chan6_raw, rc.chan7_raw, rc.chan8_raw,
                                     rc.chan9_raw, rc.chan10_raw, rc.chan11_raw, rc.chan12_raw,
                                     rc.chan13_raw, rc.chan14_raw, rc.chan15_raw, rc.chan16_raw };
-            for (int i = 0; i < RC_CHANNEL_COUNT; i++) rcChannels.channels[i] = ch[i];
-            rcChannels.lastUpdateMs = millis();
+            rc_channels_publish(ch, RC_SOURCE_MAVLINK, 0, 0, millis());
         }
 
         diagCounters.totalParsed++;
@@ -0,0 +1,318 @@
+#include "packet_capture.h"
+#include "../logging.h"
+#include "../defines.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <sys/time.h>
+
+volatile bool PacketCapture::active = false;
+
+// pcapng block types / options
+#define PCAPNG_SHB              0x0A0D0D0A
+#define PCAPNG_IDB              0x00000001
+#define PCAPNG_EPB              0x00000006
+#define PCAPNG_BYTE_ORDER       0x1A2B3C4D
+#define PCAPNG_OPT_END          0
+#define PCAPNG_OPT_COMMENT      1
+#define PCAPNG_OPT_SHB_USERAPPL 4
+#define PCAPNG_OPT_IF_NAME      2
+#define PCAPNG_OPT_EPB_FLAGS    2
+
+#define CAPTURE_EPOCH_VALID     1600000000  // Below: clock not synced, timestamps since boot
+
+static const char* const captureIfaceNames[] = {
+    "USB", "UART2", "UART3", "UDP", "UART1",
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    "BT",
+#endif
+    "internal"
+};
+static_assert(sizeof(captureIfaceNames) / sizeof(captureIfaceNames[0]) == CAPTURE_IFACE_COUNT,
+              "Capture interface names must cover all senders");
+
+static inline size_t pad4(size_t len) { return (len + 3) & ~(size_t)3; }
+
+static inline void put16(uint8_t*& p, uint16_t v) { memcpy(p, &v, 2); p += 2; }
+static inline void put32(uint8_t*& p, uint32_t v) { memcpy(p, &v, 4); p += 4; }
+
+static void putOption(uint8_t*& p, uint16_t code, const void* data, uint16_t len) {
+    put16(p, code);
+    put16(p, len);
+    memcpy(p, data, len);
+    memset(p + len, 0, pad4(len) - len);
+    p += pad4(len);
+}
+
+// Fill in total length at both ends of a block started at blockStart
+static size_t finishBlock(uint8_t* blockStart, uint8_t*& p) {
+    uint32_t total = (p - blockStart) + 4;
+    memcpy(blockStart + 4, &total, 4);
+    put32(p, total);
+    return total;
+}
+
+PacketCapture::PacketCapture() :
+    mux(portMUX_INITIALIZER_UNLOCKED),
+    ring(nullptr),
+    ringSize(0),
+    head(0),
+    tail(0),
+    used(0),
+    session(0),
+    startMs(0),
+    durationMs(0),
+    captured(0),
+    lost(0),
+    headerSent(false),
+    finished(true),
+    lastTs64(0),
+    lastTimeUs(0),
+    blockLen(0),
+    blockOff(0) {
+}
+
+const char* PacketCapture::interfaceName(uint8_t iface) {
+    return (iface < CAPTURE_IFACE_COUNT) ? captureIfaceNames[iface] : nullptr;
+}
+
+uint32_t PacketCapture::start(const CaptureFilter& newFilter, uint32_t duration) {
+    if (active || ring) return 0;
+
+    size_t size = CAPTURE_RING_SIZE;
+    uint8_t* buf = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!buf) {
+        size = CAPTURE_RING_SIZE_INTERNAL;
+        buf = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    if (!buf) {
+        log_msg(LOG_ERROR, "Capture: failed to allocate %u byte ring", (unsigned)CAPTURE_RING_SIZE_INTERNAL);
+        return 0;
+    }
+
+    filter = newFilter;
+    startMs = millis();
+    durationMs = duration;
+    captured = 0;
+    lost = 0;
+
+    headerSent = false;
+    finished = false;
+    blockLen = 0;
+    blockOff = 0;
+
+    // Record timestamps are micros(), anchored to wall clock when it is known
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    lastTimeUs = micros();
+    lastTs64 = (tv.tv_sec >= CAPTURE_EPOCH_VALID)
+        ? (uint64_t)tv.tv_sec * 1000000ULL + tv.tv_usec
+        : (uint64_t)esp_timer_get_time();
+
+    portENTER_CRITICAL(&mux);
+    ring = buf;
+    ringSize = size;
+    head = 0;
+    tail = 0;
+    used = 0;
+    if (++session == 0) session = 1;
+    uint32_t id = session;
+    portEXIT_CRITICAL(&mux);
+
+    active = true;
+    log_msg(LOG_INFO, "Capture #%u started: %u KB ring, %lu s", id, (unsigned)(size / 1024),
+            (unsigned long)(duration / 1000));
+    return id;
+}
+
+void PacketCapture::stop(uint32_t id) {
+    portENTER_CRITICAL(&mux);
+    if (id != session || !ring) {
+        portEXIT_CRITICAL(&mux);
+        return;
+    }
+    active = false;
+    uint8_t* buf = ring;
+    ring = nullptr;
+    used = 0;
+    uint32_t total = captured;
+    uint32_t dropped = lost;
+    portEXIT_CRITICAL(&mux);
+
+    heap_caps_free(buf);
+    log_msg(LOG_INFO, "Capture #%u stopped: %u packets, %u lost (ring full)", id, total, dropped);
+}
+
+bool PacketCapture::matches(const ParsedPacket& packet, uint8_t iface, uint8_t dir) const {
+    if (filter.dirMask && !(filter.dirMask & dir)) return false;
+    if (filter.ifaceMask && !(filter.ifaceMask & (1 << iface))) return false;
+    if (filter.protocol >= 0 && (uint8_t)packet.protocol != (uint8_t)filter.protocol) return false;
+
+    if (filter.msgIdCount == 0) return true;
+    if (packet.protocol != PacketProtocol::MAVLINK) return false;
+    for (uint8_t i = 0; i < filter.msgIdCount; i++) {
+        if (filter.msgIds[i] == packet.protocolMsgId) return true;
+    }
+    return false;
+}
+
+void PacketCapture::record(const ParsedPacket& packet, uint8_t iface, uint8_t dir, bool rejected) {
+    if (!packet.data || packet.size == 0) return;
+    if (iface >= MAX_SENDERS) iface = CAPTURE_IFACE_INTERNAL;
+    if (!matches(packet, iface, dir)) return;
+
+    Record rec;
+    rec.timeUs = (dir == CAPTURE_DIR_IN && packet.parseTimeMicros) ? packet.parseTimeMicros : micros();
+    rec.capLen = (packet.size > CAPTURE_SNAPLEN) ? CAPTURE_SNAPLEN : packet.size;
+    rec.origLen = (packet.size >= CAPTURE_WRAP) ? CAPTURE_WRAP - 1 : packet.size;
+    rec.msgId = packet.protocolMsgId;
+    rec.iface = iface;
+    rec.flags = dir | (rejected ? RECORD_REJECTED : 0);
+    size_t need = pad4(sizeof(Record) + rec.capLen);
+
+    portENTER_CRITICAL(&mux);
+    if (ring) {
+        // Records never wrap: an end too short for the record is skipped (and marked if it can hold a header)
+        size_t pos = head;
+        size_t skip = (pos + need > ringSize) ? ringSize - pos : 0;
+        if (used + skip + need > ringSize) {
+            lost++;
+        } else {
+            if (skip) {
+                if (skip >= sizeof(Record)) {
+                    reinterpret_cast<Record*>(ring + pos)->capLen = CAPTURE_WRAP;
+                }
+                pos = 0;
+            }
+            memcpy(ring + pos, &rec, sizeof(Record));
+            memcpy(ring + pos + sizeof(Record), packet.data, rec.capLen);
+            head = pos + need;
+            if (head == ringSize) head = 0;
+            used += skip + need;
+            captured++;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+}
+
+size_t PacketCapture::buildHeader() {
+    uint8_t* p = block;
+
+    // Section Header Block
+    put32(p, PCAPNG_SHB);
+    put32(p, 0);                        // Total length, filled in below
+    put32(p, PCAPNG_BYTE_ORDER);
+    put16(p, 1);                        // Version 1.0
+    put16(p, 0);
+    put32(p, 0xFFFFFFFF);               // Section length unknown
+    put32(p, 0xFFFFFFFF);
+    const char* appl = DEVICE_NAME " " DEVICE_VERSION;
+    putOption(p, PCAPNG_OPT_SHB_USERAPPL, appl, strlen(appl));
+    put32(p, PCAPNG_OPT_END);
+    finishBlock(block, p);
+
+    // Interface Description Block per interface, id = capture interface index
+    for (uint8_t i = 0; i < CAPTURE_IFACE_COUNT; i++) {
+        uint8_t* start = p;
+        put32(p, PCAPNG_IDB);
+        put32(p, 0);
+        put16(p, CAPTURE_LINKTYPE);
+        put16(p, 0);
+        put32(p, CAPTURE_SNAPLEN);
+        putOption(p, PCAPNG_OPT_IF_NAME, captureIfaceNames[i], strlen(captureIfaceNames[i]));
+        put32(p, PCAPNG_OPT_END);
+        finishBlock(start, p);
+    }
+
+    return p - block;
+}
+
+size_t PacketCapture::buildPacketBlock(const Record& rec, const uint8_t* data) {
+    // Unwrap 32-bit micros() against the previous record (records may be slightly out of order)
+    lastTs64 += (int64_t)(int32_t)(rec.timeUs - lastTimeUs);
+    lastTimeUs = rec.timeUs;
+
+    uint8_t* p = block;
+    put32(p, PCAPNG_EPB);
+    put32(p, 0);
+    put32(p, rec.iface);
+    put32(p, (uint32_t)(lastTs64 >> 32));
+    put32(p, (uint32_t)lastTs64);
+    put32(p, rec.capLen);
+    put32(p, rec.origLen);
+    memcpy(p, data, rec.capLen);
+    memset(p + rec.capLen, 0, pad4(rec.capLen) - rec.capLen);
+    p += pad4(rec.capLen);
+
+    uint32_t epbFlags = rec.flags & (CAPTURE_DIR_IN | CAPTURE_DIR_OUT);
+    putOption(p, PCAPNG_OPT_EPB_FLAGS, &epbFlags, 4);
+    if (rec.flags & RECORD_REJECTED) {
+        static const char note[] = "sender queue full";
+        putOption(p, PCAPNG_OPT_COMMENT, note, sizeof(note) - 1);
+    }
+    put32(p, PCAPNG_OPT_END);
+    return finishBlock(block, p);
+}
+
+bool PacketCapture::popRecord() {
+    bool got = false;
+
+    portENTER_CRITICAL(&mux);
+    if (ring && used > 0) {
+        size_t pos = tail;
+        size_t rest = ringSize - pos;
+        if (rest < sizeof(Record) || reinterpret_cast<Record*>(ring + pos)->capLen == CAPTURE_WRAP) {
+            used -= rest;
+            pos = 0;
+        }
+
+        Record rec;
+        memcpy(&rec, ring + pos, sizeof(Record));
+        blockLen = buildPacketBlock(rec, ring + pos + sizeof(Record));
+        blockOff = 0;
+
+        size_t len = pad4(sizeof(Record) + rec.capLen);
+        tail = pos + len;
+        if (tail == ringSize) tail = 0;
+        used -= len;
+        got = true;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    return got;
+}
+
+size_t PacketCapture::read(uint32_t id, uint8_t* buf, size_t maxLen) {
+    if (id != session || finished) return 0;
+
+    size_t out = 0;
+    while (out < maxLen) {
+        if (blockOff < blockLen) {
+            size_t n = std::min(blockLen - blockOff, maxLen - out);
+            memcpy(buf + out, block + blockOff, n);
+            blockOff += n;
+            out += n;
+            continue;
+        }
+
+        if (!headerSent) {
+            blockLen = buildHeader();
+            blockOff = 0;
+            headerSent = true;
+            continue;
+        }
+
+        if (popRecord()) continue;
+
+        // Ring drained - done once the duration is over (or the capture was stopped)
+        bool expired = durationMs && (millis() - startMs) >= durationMs;
+        if (expired || !active) {
+            finished = true;
+            stop(id);
+        }
+        break;
+    }
+
+    if (out == 0 && !finished) return CAPTURE_READ_WAIT;
+    return out;
+}
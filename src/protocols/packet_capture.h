@@ -0,0 +1,120 @@
+#ifndef PACKET_CAPTURE_H
+#define PACKET_CAPTURE_H
+
+#include <Arduino.h>
+#include "protocol_types.h"
+
+// Live packet capture for /capture.pcapng
+// Pipeline taps record parsed input packets (RX, flow interface) and sender enqueues
+// (TX, sender index) into a bounded ring while a capture is running. The HTTP stream
+// drains the ring as pcapng: one IDB per interface (LINKTYPE_USER0, raw payload),
+// EPBs with epb_flags direction and a comment on packets a sender queue rejected.
+// Producers never wait - when the ring is full the packet is counted as lost.
+// With no capture running a tap is a single flag test.
+
+#define CAPTURE_RING_SIZE           (128 * 1024)    // PSRAM
+#define CAPTURE_RING_SIZE_INTERNAL  (16 * 1024)     // Fallback without PSRAM
+#define CAPTURE_SNAPLEN             288             // MAVLink v2 max frame is 280
+#define CAPTURE_MAX_MSGIDS          8
+#define CAPTURE_DEFAULT_SECONDS     60
+#define CAPTURE_MAX_SECONDS         600             // 0 = until the client disconnects
+#define CAPTURE_LINKTYPE            147             // LINKTYPE_USER0
+#define CAPTURE_IFACE_INTERNAL      MAX_SENDERS     // Packets without a physical interface
+#define CAPTURE_IFACE_COUNT         (MAX_SENDERS + 1)
+#define CAPTURE_READ_WAIT           SIZE_MAX        // read(): nothing buffered yet
+
+// Direction bits - same values as pcapng epb_flags inbound/outbound
+#define CAPTURE_DIR_IN              0x01
+#define CAPTURE_DIR_OUT             0x02
+
+// Applied at tap time, so filtered packets never take ring space
+struct CaptureFilter {
+    uint8_t dirMask;                        // CAPTURE_DIR_* bits, 0 = both
+    uint8_t ifaceMask;                      // Bit per capture interface, 0 = all
+    int8_t protocol;                        // PacketProtocol value, -1 = any
+    uint8_t msgIdCount;                     // 0 = any message
+    uint16_t msgIds[CAPTURE_MAX_MSGIDS];
+
+    CaptureFilter() : dirMask(0), ifaceMask(0), protocol(-1), msgIdCount(0) {}
+};
+
+class PacketCapture {
+public:
+    static PacketCapture* getInstance() {
+        static PacketCapture instance;
+        return &instance;
+    }
+
+    // Pipeline taps
+    static inline bool isActive() { return active; }
+    static inline void tap(const ParsedPacket& packet, uint8_t iface, uint8_t dir, bool rejected = false) {
+        if (__builtin_expect(active, 0)) {
+            getInstance()->record(packet, iface, dir, rejected);
+        }
+    }
+
+    // Start a capture (durationMs 0 = no limit). Returns session id, 0 if one is
+    // already running or the ring could not be allocated.
+    uint32_t start(const CaptureFilter& filter, uint32_t durationMs);
+    // Stop recording and release the ring (stream end or client disconnect).
+    // Ignored if session is no longer the current capture.
+    void stop(uint32_t session);
+
+    // Next piece of the session's pcapng stream.
+    // 0 = capture finished, CAPTURE_READ_WAIT = nothing buffered yet.
+    size_t read(uint32_t session, uint8_t* buf, size_t maxLen);
+
+    static const char* interfaceName(uint8_t iface);
+
+private:
+    // Ring record header, followed by capLen bytes padded to 4
+    struct Record {
+        uint32_t timeUs;        // micros()
+        uint16_t capLen;        // CAPTURE_WRAP = skip to ring start
+        uint16_t origLen;
+        uint16_t msgId;
+        uint8_t iface;
+        uint8_t flags;          // CAPTURE_DIR_* | RECORD_REJECTED
+    };
+    static constexpr uint16_t CAPTURE_WRAP = 0xFFFF;
+    static constexpr uint8_t RECORD_REJECTED = 0x80;
+    static constexpr size_t BLOCK_SIZE = 512;   // Largest pcapng block (header blocks)
+
+    static volatile bool active;
+
+    portMUX_TYPE mux;
+    uint8_t* ring;
+    size_t ringSize;
+    size_t head;                // Next write offset
+    size_t tail;                // Next read offset
+    size_t used;                // Bytes in use, including skipped ring ends
+
+    uint32_t session;
+    CaptureFilter filter;
+    uint32_t startMs;
+    uint32_t durationMs;
+    uint32_t captured;
+    uint32_t lost;              // Ring full
+
+    // Stream state (HTTP response callback only)
+    bool headerSent;
+    bool finished;
+    uint64_t lastTs64;          // Epoch microseconds of last record
+    uint32_t lastTimeUs;
+    uint8_t block[BLOCK_SIZE];
+    size_t blockLen;
+    size_t blockOff;
+
+    PacketCapture();
+    PacketCapture(const PacketCapture&) = delete;
+    PacketCapture& operator=(const PacketCapture&) = delete;
+
+    void record(const ParsedPacket& packet, uint8_t iface, uint8_t dir, bool rejected);
+    bool matches(const ParsedPacket& packet, uint8_t iface, uint8_t dir) const;
+
+    size_t buildHeader();
+    size_t buildPacketBlock(const Record& rec, const uint8_t* data);
+    bool popRecord();           // Next ring record into block as EPB
+};
+
+#endif // PACKET_CAPTURE_H
@@ -66,6 +66,7 @@ public:
     }
     
     size_t getBlockSize() const { return BlockSize; }
+    size_t getBlockCount() const { return BlockCount; }
     uint32_t getAllocCount() const { return allocCount; }
     uint32_t getFreeCount() const { return freeCount; }
     uint32_t getFailCount() const { return failCount; }
@@ -145,6 +146,27 @@ public:
         }
     }
     
+    // Per-pool usage snapshot (counters read without the pool mutex)
+    struct PoolUsage {
+        size_t blockSize;
+        size_t blockCount;
+        uint32_t allocCount;
+        uint32_t freeCount;
+        uint32_t failCount;
+    };
+    static constexpr size_t POOL_COUNT = 4;
+
+    void getUsage(PoolUsage* out) const {
+        out[0] = {smallPool.getBlockSize(), smallPool.getBlockCount(),
+                  smallPool.getAllocCount(), smallPool.getFreeCount(), smallPool.getFailCount()};
+        out[1] = {mediumPool.getBlockSize(), mediumPool.getBlockCount(),
+                  mediumPool.getAllocCount(), mediumPool.getFreeCount(), mediumPool.getFailCount()};
+        out[2] = {mavlinkPool.getBlockSize(), mavlinkPool.getBlockCount(),
+                  mavlinkPool.getAllocCount(), mavlinkPool.getFreeCount(), mavlinkPool.getFailCount()};
+        out[3] = {rawPool.getBlockSize(), rawPool.getBlockCount(),
+                  rawPool.getAllocCount(), rawPool.getFreeCount(), rawPool.getFailCount()};
+    }
+
     void getStats(char* buffer, size_t bufSize) {
         snprintf(buffer, bufSize,
                 "Pool Stats:"
@@ -108,6 +108,10 @@ public:
     // Returns number of bytes sent (may be 0 on error)
     virtual size_t sendDirect(const uint8_t* data, size_t size) = 0;
 
+    // Bytes sendDirect() can take right now without truncation
+    // Default: unknown/unbounded (datagram transports send whole packets or nothing)
+    virtual size_t getDirectWriteSpace() { return SIZE_MAX; }
+
     // Process queue and send packets (MUST handle partial send!)
     // @param bulkMode - true if parser detected bulk transfer
     virtual void processSendQueue(bool bulkMode = false) = 0;
@@ -6,6 +6,8 @@
 #include "sbus_fast_parser.h"
 #include "sbus_router.h"
 #include "terminal_parser.h"
+#include "packet_capture.h"
+#include "mavlink_msg_stats.h"
 #if defined(MINIKIT_BT_ENABLED)
 #include "bluetooth_sender.h"
 #endif
@@ -17,7 +19,10 @@ ProtocolPipeline::ProtocolPipeline(BridgeContext* context) :
     activeFlows(0),
     ctx(context),
     sharedRouter(nullptr),
-    crsfParser(nullptr) {
+    crsfParser(nullptr),
+    device4IsTcp(false),
+    activeConfig(nullptr),
+    pendingReconfigure(0) {
     // Initialize sender slots to nullptr
     for (size_t i = 0; i < MAX_SENDERS; i++) {
         senders[i] = nullptr;
@@ -29,6 +34,8 @@ ProtocolPipeline::~ProtocolPipeline() {
 }
 
 void ProtocolPipeline::init(Config* config) {
+    activeConfig = config;
+
     // Initialize sender slots to nullptr
     for (size_t i = 0; i < MAX_SENDERS; i++) {
         senders[i] = nullptr;
@@ -40,6 +47,10 @@ void ProtocolPipeline::init(Config* config) {
         sharedRouter = new MavlinkRouter();
         log_msg(LOG_INFO, "Shared MAVLink router created");
     }
+
+    if (config->protocolOptimization == PROTOCOL_MAVLINK) {
+        MavlinkMsgStats::getInstance()->enable();
+    }
     
     // Setup data flows based on configuration
     setupFlows(config);
@@ -80,6 +91,12 @@ void ProtocolPipeline::setupFlows(Config* config) {
         f.senderMask = 0;  // CrsfParser handles output directly via sendDirect
         f.isInputFlow = true;
         crsfParser = new CrsfParser();
+        // SBUS output roles alongside CRSF input - convert RC channels for SbusRouter
+        if (config->device2.role == D2_SBUS_OUT ||
+            config->device3.role == D3_SBUS_OUT ||
+            config->device4.role == D4_SBUS_UDP_TX) {
+            crsfParser->enableSbusOutput();
+        }
         f.parser = crsfParser;
         f.router = nullptr;
 
@@ -192,7 +209,14 @@ void ProtocolPipeline::setupFlows(Config* config) {
                 f.router = sharedRouter;  // CRITICAL: Use shared router, NOT new!
                 break;
             case PROTOCOL_TERMINAL:
-                f.parser = new TerminalParser();
+                {
+                    TerminalParser* termParser = new TerminalParser();
+                    TerminalTriggers* triggers = TerminalTriggers::getInstance();
+                    if (triggers->build(config->terminalTriggers.c_str()) > 0) {
+                        termParser->setTriggers(triggers);
+                    }
+                    f.parser = termParser;
+                }
                 f.router = nullptr;
                 break;
             default:
@@ -236,7 +260,7 @@ void ProtocolPipeline::setupFlows(Config* config) {
         f.inputBuffer = ctx->buffers.logBuffer;
         f.source = SOURCE_LOGS;
         f.senderMask = SENDER_UDP;
-        f.parser = new LineBasedParser();
+        f.parser = new LineBasedParser(512, 20);  // Batch whole log lines: up to 512 B / 20 ms
         
         // Link statistics
         if (ctx->protocol.stats) {
@@ -244,7 +268,7 @@ void ProtocolPipeline::setupFlows(Config* config) {
         }
         
         flows[activeFlows++] = f;
-        log_msg(LOG_INFO, "Logger flow created with LineBasedParser");
+        log_msg(LOG_INFO, "Logger flow created with LineBasedParser (batched)");
     } else if (config->device4.role == D4_LOG_NETWORK) {
         log_msg(LOG_ERROR, "Log buffer not allocated for Logger mode!");
     }
@@ -769,8 +793,18 @@ void ProtocolPipeline::createSenders(Config* config) {
         log_msg(LOG_INFO, "Created UART3 sender at index %d for role %d", IDX_DEVICE3, config->device3.role);
     }
     
+    // Device4 - TCP sender (Bridge role over TCP)
+    if (config->device4.role == D4_NETWORK_BRIDGE &&
+        config->device4_config.transport == D4_TRANSPORT_TCP) {
+        extern TcpServerTransport* tcpServerTransport;
+        if (tcpServerTransport) {
+            senders[IDX_DEVICE4] = new TcpSender(tcpServerTransport);
+            device4IsTcp = true;
+            log_msg(LOG_INFO, "Created TCP sender at index %d for role %d", IDX_DEVICE4, config->device4.role);
+        }
+    }
     // Device4 - UDP sender (for all UDP TX roles)
-    if ((config->device4.role == D4_NETWORK_BRIDGE ||
+    else if ((config->device4.role == D4_NETWORK_BRIDGE ||
          config->device4.role == D4_LOG_NETWORK ||
          config->device4.role == D4_SBUS_UDP_TX ||
          config->device4.role == D4_CRSF_TEXT)) {
@@ -784,6 +818,8 @@ void ProtocolPipeline::createSenders(Config* config) {
             // Rate limiting only for SBUS Output roles
             if (config->device4.role == D4_SBUS_UDP_TX) {
                 udpSender->setSendRate(config->device4_config.udpSendRate);
+                udpSender->setSbusEnvelope(config->device4_config.sbusEnvelope,
+                                           config->device4_config.sbusRedundancy);
             }
 
             // Register UDP sender as CRSF text output (with independent RC rate)
@@ -878,6 +914,20 @@ void ProtocolPipeline::processInputFlows() {
 }
 
 void ProtocolPipeline::processTelemetryFlow() {
+    // Runs every bridge loop iteration - the one place flows are never mid-parse
+    if (pendingReconfigure.load(std::memory_order_acquire)) {
+        portENTER_CRITICAL(&reconfigMux);
+        uint8_t flags = pendingReconfigure.exchange(0, std::memory_order_acq_rel);
+        memcpy(&appliedSettings, &pendingSettings, sizeof(appliedSettings));
+        portEXIT_CRITICAL(&reconfigMux);
+        applyReconfigure(flags, appliedSettings);
+    }
+
+    // Idle links included - lookup() alone would wait for the next MAVLink packet
+    if (MavlinkMsgStats::isEnabled()) {
+        MavlinkMsgStats::getInstance()->applyPendingReset();
+    }
+
     // === DIAGNOSTIC BLOCK START ===
     static uint32_t packetCount = 0;
     static uint32_t lastReport = 0;
@@ -974,6 +1024,123 @@ void ProtocolPipeline::processTelemetryFlow() {
     }
 }
 
+void ProtocolPipeline::requestReconfigure(uint8_t flags, const Config& cfg) {
+    // Built on the caller's stack, published together with the flags
+    ReconfigureSettings s;
+    memset(&s, 0, sizeof(s));
+    s.mavlinkRouting = cfg.mavlinkRouting;
+    strncpy(s.terminalTriggers, cfg.terminalTriggers.c_str(), sizeof(s.terminalTriggers) - 1);
+    s.udpBatchingEnabled = cfg.udpBatchingEnabled;
+    strncpy(s.targetIp, cfg.device4_config.target_ip, sizeof(s.targetIp) - 1);
+    s.device2OutRate = cfg.device2.outRate;
+    s.device2CrsfFilter = cfg.device2.crsfFilter;
+    s.device4SendRate = cfg.device4_config.udpSendRate;
+    s.device4CrsfFilter = cfg.device4_config.crsfFilter;
+    s.sbusEnvelope = cfg.device4_config.sbusEnvelope;
+    s.sbusRedundancy = cfg.device4_config.sbusRedundancy;
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    s.device5SendRate = cfg.device5_config.btSendRate;
+    s.device5CrsfFilter = cfg.device5_config.crsfFilter;
+#endif
+
+    portENTER_CRITICAL(&reconfigMux);
+    memcpy(&pendingSettings, &s, sizeof(pendingSettings));
+    pendingReconfigure.fetch_or(flags, std::memory_order_release);
+    portEXIT_CRITICAL(&reconfigMux);
+}
+
+void ProtocolPipeline::applyReconfigure(uint8_t flags, const ReconfigureSettings& settings) {
+    if (!activeConfig) return;
+
+    if (flags & RECONFIG_MAVLINK_ROUTING) applyMavlinkRouting(settings.mavlinkRouting);
+    if (flags & RECONFIG_TERMINAL_TRIGGERS) applyTerminalTriggers(settings.terminalTriggers);
+    if (flags & RECONFIG_SENDERS) applySenderSettings(settings);
+
+    log_msg(LOG_INFO, "Protocol pipeline reconfigured (flags=0x%02X)", flags);
+}
+
+void ProtocolPipeline::applyMavlinkRouting(bool enabled) {
+    if (activeConfig->protocolOptimization != PROTOCOL_MAVLINK) return;
+
+    if (enabled && !sharedRouter) {
+        sharedRouter = new MavlinkRouter();
+    }
+    // When disabled the router is only detached, not deleted: the web task may be
+    // reading its stats, and re-enabling reuses it
+
+    // Same flows setupFlows() gave a MavlinkParser; parser state and buffers stay
+    for (size_t i = 0; i < activeFlows; i++) {
+        DataFlow& f = flows[i];
+        if (!f.parser || strcmp(f.parser->getName(), "MAVLink/pymav") != 0) continue;
+        static_cast<MavlinkParser*>(f.parser)->setRoutingEnabled(enabled);
+        f.router = enabled ? sharedRouter : nullptr;
+    }
+
+    log_msg(LOG_INFO, "MAVLink routing %s without restart", enabled ? "enabled" : "disabled");
+}
+
+void ProtocolPipeline::applyTerminalTriggers(const char* spec) {
+    if (activeConfig->protocolOptimization != PROTOCOL_TERMINAL) return;
+
+    // Triggers only run on the UART1 telemetry flow (see setupFlows)
+    for (size_t i = 0; i < activeFlows; i++) {
+        DataFlow& f = flows[i];
+        if (f.isInputFlow || f.source == SOURCE_LOGS || !f.parser ||
+            strcmp(f.parser->getName(), "TERMINAL") != 0) continue;
+
+        TerminalTriggers* triggers = TerminalTriggers::getInstance();
+        size_t count = triggers->build(spec);
+        static_cast<TerminalParser*>(f.parser)->setTriggers(count > 0 ? triggers : nullptr);
+        break;
+    }
+}
+
+// Roles and auto_broadcast need a restart, so they are still read from activeConfig
+void ProtocolPipeline::applySenderSettings(const ReconfigureSettings& settings) {
+    Config* config = activeConfig;
+
+    // Device2 USB text outputs
+    PacketSender* usb = senders[IDX_DEVICE2_USB];
+    if (usb) {
+        if (config->device2.role == D2_USB_SBUS_TEXT) {
+            static_cast<UsbSender*>(usb)->setSendRate(settings.device2OutRate);
+        } else if (config->device2.role == D2_USB_CRSF_TEXT && crsfParser) {
+            crsfParser->updateTextOutput(usb, settings.device2OutRate, settings.device2CrsfFilter);
+        }
+    }
+
+    // Device4 UDP (TCP has no runtime settings)
+    UdpSender* udpSender = getUdpSender();
+    if (udpSender) {
+        udpSender->setBatchingEnabled(settings.udpBatchingEnabled);
+        if (!config->device4_config.auto_broadcast) {
+            udpSender->reloadTargets(settings.targetIp);
+        }
+        if (config->device4.role == D4_SBUS_UDP_TX) {
+            udpSender->setSendRate(settings.device4SendRate);
+            udpSender->setSbusEnvelope(settings.sbusEnvelope, settings.sbusRedundancy);
+        } else if (config->device4.role == D4_CRSF_TEXT && crsfParser) {
+            crsfParser->updateTextOutput(udpSender, settings.device4SendRate, settings.device4CrsfFilter);
+        }
+    }
+
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    // Device5 Bluetooth
+    PacketSender* bt = senders[IDX_DEVICE5];
+    if (bt) {
+        if (config->device5_config.role == D5_BT_SBUS_TEXT) {
+#if defined(MINIKIT_BT_ENABLED)
+            static_cast<BluetoothSender*>(bt)->setSendRate(settings.device5SendRate);
+#else
+            static_cast<BluetoothBLESender*>(bt)->setSendRate(settings.device5SendRate);
+#endif
+        } else if (config->device5_config.role == D5_BT_CRSF_TEXT && crsfParser) {
+            crsfParser->updateTextOutput(bt, settings.device5SendRate, settings.device5CrsfFilter);
+        }
+    }
+#endif
+}
+
 void ProtocolPipeline::processFlow(DataFlow& flow) {
     if (!flow.parser || !flow.inputBuffer) return;
 
@@ -1043,6 +1210,21 @@ void ProtocolPipeline::processFlow(DataFlow& flow) {
     for (size_t i = 0; i < result.count; i++) {
         result.packets[i].physicalInterface = flow.physInterface;
     }
+
+    // Per-msgid accounting (RX)
+    if (MavlinkMsgStats::isEnabled() && flow.source != SOURCE_LOGS) {
+        MavlinkMsgStats* msgStats = MavlinkMsgStats::getInstance();
+        for (size_t i = 0; i < result.count; i++) {
+            msgStats->onRx(result.packets[i], flow.physInterface);
+        }
+    }
+
+    // Capture tap (RX) - log output is internal, not traffic
+    if (PacketCapture::isActive() && flow.source != SOURCE_LOGS) {
+        for (size_t i = 0; i < result.count; i++) {
+            PacketCapture::tap(result.packets[i], flow.physInterface, CAPTURE_DIR_IN);
+        }
+    }
     
     // Apply routing if configured
     if (flow.router && result.count > 0) {
@@ -1085,7 +1267,14 @@ void ProtocolPipeline::distributePackets(ParsedPacket* packets, size_t count, Pa
         // Send to selected interfaces
         for (size_t j = 0; j < MAX_SENDERS; j++) {
             if (senders[j] && (finalMask & (1 << j))) {
-                senders[j]->enqueue(packets[i]);
+                bool queued = senders[j]->enqueue(packets[i]);
+                // TX accounting and capture tap - here rather than in enqueue(), which does not know its sender index
+                if (MavlinkMsgStats::isEnabled() && source != SOURCE_LOGS) {
+                    MavlinkMsgStats::getInstance()->onTx(packets[i], j, queued);
+                }
+                if (PacketCapture::isActive() && source != SOURCE_LOGS) {
+                    PacketCapture::tap(packets[i], j, CAPTURE_DIR_OUT, !queued);
+                }
             }
         }
     }
@@ -1233,6 +1422,8 @@ void ProtocolPipeline::appendStatsToJson(JsonDocument& doc) {
                 if (bestParser) {
                     parserStats["validFrames"] = bestParser->getValidFrames();
                     parserStats["invalidFrames"] = bestParser->getInvalidFrames();
+                    parserStats["syncLosses"] = bestParser->getSyncLosses();
+                    parserStats["resyncBytes"] = bestParser->getResyncBytes();
                     if (bestTime > 0) {
                         parserStats["lastActivityMs"] = (long)(millis() - bestTime);
                     }
@@ -1245,6 +1436,24 @@ void ProtocolPipeline::appendStatsToJson(JsonDocument& doc) {
                     parserStats["validFrames"] = crsfParser->getValidFrames();
                     parserStats["invalidFrames"] = crsfParser->getInvalidFrames();
                     parserStats["crcErrors"] = crsfParser->getCrcErrors();
+                    const CrsfSbusConverter* conv = crsfParser->getSbusConverter();
+                    if (conv) {
+                        parserStats["sbusFramesIn"] = conv->getFramesIn();
+                        parserStats["sbusFramesRouted"] = conv->getFramesRouted();
+                        parserStats["sbusFramesCoalesced"] = conv->getFramesCoalesced();
+                    }
+                    if (!crsfParser->getBinaryOutputs().empty()) {
+                        JsonArray bin = parserStats["binaryOutputs"].to<JsonArray>();
+                        for (auto* out : crsfParser->getBinaryOutputs()) {
+                            JsonObject o = bin.createNestedObject();
+                            o["name"] = out->getSender()->getName();
+                            o["forwarded"] = out->getFramesForwarded();
+                            o["coalesced"] = out->getFramesCoalesced();
+                            o["passthrough"] = out->getFramesPassthrough();
+                            o["pending"] = out->getPendingCount();
+                            o["maxAgeUs"] = out->getMaxAgeUs();
+                        }
+                    }
                     uint32_t lastTime = crsfParser->getLastFrameTime();
                     if (lastTime > 0) {
                         parserStats["lastActivityMs"] = (long)(millis() - lastTime);
@@ -1256,6 +1465,17 @@ void ProtocolPipeline::appendStatsToJson(JsonDocument& doc) {
             case PROTOCOL_TERMINAL: {  // Terminal (4)
                 parserStats["linesProcessed"] = ctx->protocol.stats->packetsDetected;
                 parserStats["bytesProcessed"] = ctx->protocol.stats->totalBytes;
+
+                TerminalTriggers* triggers = TerminalTriggers::getInstance();
+                if (triggers->isActive()) {
+                    parserStats["triggerMatches"] = triggers->getMatches();
+                    JsonArray hits = parserStats["triggers"].to<JsonArray>();
+                    for (size_t i = 0; i < triggers->getTriggerCount(); i++) {
+                        JsonObject t = hits.createNestedObject();
+                        t["pattern"] = triggers->getPattern(i);
+                        t["hits"] = triggers->getHits(i);
+                    }
+                }
                 break;
             }
         }
@@ -1327,10 +1547,26 @@ void ProtocolPipeline::appendStatsToJson(JsonDocument& doc) {
         }
     }
 
+    // TCP server clients (Bridge over TCP)
+    if (device4IsTcp) {
+        extern TcpServerTransport* tcpServerTransport;
+        if (tcpServerTransport) {
+            tcpServerTransport->appendJson(stats["tcpServer"].to<JsonObject>());
+        }
+    }
+
     // Add UDP batching stats for UDP sender
-    if (senders[IDX_DEVICE4]) {
+    if (UdpSender* udpSender = getUdpSender()) {
         JsonObject udpStats = stats["udpBatching"].to<JsonObject>();
-        ((UdpSender*)senders[IDX_DEVICE4])->getBatchingStats(udpStats);
+        udpSender->getBatchingStats(udpStats);
+
+        if (UdpPeerTable::isEnabled()) {
+            UdpPeerTable::getInstance()->appendJson(stats["udpPeers"].to<JsonArray>());
+        }
+        UdpHostResolver* resolver = UdpHostResolver::getInstance();
+        if (resolver->count() > 0) {
+            resolver->appendJson(stats["udpHosts"].to<JsonArray>());
+        }
     }
     
     // Add router statistics if MAVLink routing active
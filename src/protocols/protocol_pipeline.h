@@ -12,11 +12,40 @@
 #include "usb_sender.h"
 #include "uart_sender.h"
 #include "udp_sender.h"
+#include "tcp_sender.h"
 #include "crsf_parser.h"
+#include "terminal_triggers.h"
 #include "../types.h"
 #include "../circular_buffer.h"
 #include "../logging.h"
 #include <ArduinoJson.h>
+#include <atomic>
+
+// Runtime reconfiguration groups (ProtocolPipeline::requestReconfigure)
+enum ReconfigureFlags : uint8_t {
+    RECONFIG_MAVLINK_ROUTING  = 0x01,   // Create/drop the shared MAVLink router
+    RECONFIG_TERMINAL_TRIGGERS = 0x02,  // Rebuild the terminal trigger automaton
+    RECONFIG_SENDERS          = 0x04    // Rates, filters, UDP targets/batching
+};
+
+// Runtime settings copied by requestReconfigure(). The web task keeps editing the
+// global config in place, so the bridge task applies this copy, never config itself.
+struct ReconfigureSettings {
+    bool mavlinkRouting;
+    char terminalTriggers[TERMINAL_TRIGGER_SPEC_MAX + 1];
+    bool udpBatchingEnabled;
+    char targetIp[sizeof(Device4Config::target_ip)];
+    uint8_t device2OutRate;
+    uint8_t device2CrsfFilter;
+    uint8_t device4SendRate;
+    uint8_t device4CrsfFilter;
+    bool sbusEnvelope;
+    uint8_t sbusRedundancy;
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+    uint8_t device5SendRate;
+    uint8_t device5CrsfFilter;
+#endif
+};
 
 // Forward declaration
 class CircularBuffer;
@@ -65,9 +94,17 @@ private:
     
     // Fixed sender slots (can be nullptr)
     PacketSender* senders[MAX_SENDERS];
+    bool device4IsTcp;              // senders[IDX_DEVICE4] is a TcpSender, not a UdpSender
     
     // Bridge context
     BridgeContext* ctx;
+
+    // Config the pipeline was built from, and reconfiguration waiting for the bridge task
+    Config* activeConfig;
+    std::atomic<uint8_t> pendingReconfigure;
+    ReconfigureSettings pendingSettings;    // Written by requestReconfigure() under reconfigMux
+    ReconfigureSettings appliedSettings;    // Bridge task copy being applied
+    portMUX_TYPE reconfigMux = portMUX_INITIALIZER_UNLOCKED;
     
     // Private methods
     void setupFlows(Config* config);
@@ -75,6 +112,10 @@ private:
     void createSenders(Config* config);
     void processFlow(DataFlow& flow);
     void distributePackets(ParsedPacket* packets, size_t count, PacketSource source, uint8_t senderMask);
+    void applyReconfigure(uint8_t flags, const ReconfigureSettings& settings);
+    void applyMavlinkRouting(bool enabled);
+    void applyTerminalTriggers(const char* spec);
+    void applySenderSettings(const ReconfigureSettings& settings);
     void cleanup();
     
 public:
@@ -89,6 +130,11 @@ public:
     // Add methods for separate processing
     void processInputFlows();   // Process GCS→FC flows
     void processTelemetryFlow(); // Process FC→GCS flow
+
+    // Apply runtime settings from cfg (any task, ReconfigureFlags). The values are
+    // copied here; the bridge task applies them before its next telemetry pass, so
+    // parsers and senders are never swapped under a running flow; buffers and stats are kept.
+    void requestReconfigure(uint8_t flags, const Config& cfg);
     
     // Check if any input flow has data (optimization for main loop)
     bool hasInputData() const {
@@ -114,6 +160,11 @@ public:
     
     // Sender access for statistics
     PacketSender* getSender(size_t index) const;
+
+    // Device4 sender if it is UDP (nullptr for TCP transport or no Device4 sender)
+    UdpSender* getUdpSender() const {
+        return device4IsTcp ? nullptr : static_cast<UdpSender*>(senders[IDX_DEVICE4]);
+    }
     size_t getSenderCount() const { return MAX_SENDERS; }  // Fixed count
 
     // Flow access for external components
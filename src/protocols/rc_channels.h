@@ -2,16 +2,81 @@
 #define RC_CHANNELS_H
 
 #include <stdint.h>
+#include <string.h>
+#include <atomic>
 
 #define RC_CHANNEL_COUNT 16
 
-// Shared RC channel storage — written by SBUS/CRSF parsers, read by web API
+// Channel source protocol (RcChannelData.source)
+#define RC_SOURCE_NONE      0
+#define RC_SOURCE_SBUS      1   // Active SbusRouter source (input = SBUS_SOURCE_*)
+#define RC_SOURCE_CRSF      2
+#define RC_SOURCE_MAVLINK   3   // RC_CHANNELS / RC_CHANNELS_OVERRIDE
+
+// Channel flags (RcChannelData.flags)
+#define RC_FLAG_FAILSAFE    0x01    // Source reports failsafe (SBUS flag bit 3)
+#define RC_FLAG_FRAME_LOST  0x02    // Source reports lost frame (SBUS flag bit 2)
+
+// Shared RC channel storage — written by SBUS/CRSF/MAVLink parsers, read by web API
+// Latest value only, guarded by a sequence counter instead of a lock: the writer (bridge
+// task) never waits, readers retry if they raced with an update.
 struct RcChannelData {
     uint16_t channels[RC_CHANNEL_COUNT];  // Channel values in microseconds (988-2012)
     uint32_t lastUpdateMs;                // millis() of last update
+    uint8_t source;                       // RC_SOURCE_*
+    uint8_t input;                        // Source-specific input id (SBUS router source)
+    uint8_t flags;                        // RC_FLAG_*
+    std::atomic<uint32_t> seq;            // Odd while an update is in progress
+};
+
+// Consistent copy of RcChannelData
+struct RcChannelSnapshot {
+    uint16_t channels[RC_CHANNEL_COUNT];
+    uint32_t lastUpdateMs;
+    uint8_t source;
+    uint8_t input;
+    uint8_t flags;
+    uint32_t seq;                         // Changes with every update
 };
 
 // Global instance
 extern RcChannelData rcChannels;
 
+// Publish new channel values (one writer at a time - the active input's parser)
+inline void rc_channels_publish(const uint16_t* us, uint8_t source, uint8_t input,
+                                uint8_t flags, uint32_t timeMs) {
+    uint32_t s = rcChannels.seq.load(std::memory_order_relaxed);
+    rcChannels.seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(rcChannels.channels, us, sizeof(rcChannels.channels));
+    rcChannels.lastUpdateMs = timeMs;
+    rcChannels.source = source;
+    rcChannels.input = input;
+    rcChannels.flags = flags;
+
+    rcChannels.seq.store(s + 2, std::memory_order_release);
+}
+
+// Read latest values without blocking the writer. False if every attempt raced an update.
+inline bool rc_channels_read(RcChannelSnapshot& out) {
+    for (int attempt = 0; attempt < 4; attempt++) {
+        uint32_t s = rcChannels.seq.load(std::memory_order_acquire);
+        if (s & 1) continue;
+
+        memcpy(out.channels, rcChannels.channels, sizeof(out.channels));
+        out.lastUpdateMs = rcChannels.lastUpdateMs;
+        out.source = rcChannels.source;
+        out.input = rcChannels.input;
+        out.flags = rcChannels.flags;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (rcChannels.seq.load(std::memory_order_relaxed) == s) {
+            out.seq = s;
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif // RC_CHANNELS_H
@@ -0,0 +1,140 @@
+// RC text formatting without printf
+// Shared by SBUS text output (sbus_text.h) and CRSF text output (crsf_parser.h).
+// Digit-pair table turns 3-4 digit µs values into 2 table copies, no division chains,
+// no allocation. Output is byte-identical to the previous snprintf formats.
+//
+// Formats (global Config.rcTextFormat):
+//   ESP-Bridge: "RC 1500,1500,...\r\n"            16 channels, µs
+//   R2D2:       "$0,0,...,0,\r\n"                  24 fields, (µs - 1500) * 2, trailing comma,
+//                                                  last 8 fields always 0 (EdgeTX LUA compatible)
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// RC text format selection (global, orthogonal to per-device sbusOutputFormat)
+enum RcTextFormat : uint8_t {
+    RC_TEXT_ESP_BRIDGE = 0,
+    RC_TEXT_R2D2 = 1
+};
+
+static constexpr size_t RC_TEXT_CHANNELS = 16;
+static constexpr size_t RC_TEXT_R2D2_FIELDS = 24;
+
+// Max line sizes including null terminator
+static constexpr size_t RC_TEXT_ESP_BRIDGE_SIZE = 3 + 16 * 5 + 15 + 2 + 1;   // "RC " + values + commas + CRLF
+static constexpr size_t RC_TEXT_R2D2_SIZE = 1 + 24 * 6 + 24 + 2 + 1;         // "$" + values + commas + CRLF
+static constexpr size_t RC_TEXT_BUFFER_SIZE =
+    (RC_TEXT_ESP_BRIDGE_SIZE > RC_TEXT_R2D2_SIZE) ? RC_TEXT_ESP_BRIDGE_SIZE : RC_TEXT_R2D2_SIZE;
+
+// "00" "01" ... "99"
+static constexpr char RC_DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Write unsigned decimal, returns pointer past last char (no terminator)
+inline char* rcFmtUint(char* p, uint32_t v) {
+    char tmp[10];
+    char* t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        uint32_t q = v / 100;
+        uint32_t r = v - q * 100;
+        t -= 2;
+        memcpy(t, &RC_DIGIT_PAIRS[r * 2], 2);
+        v = q;
+    }
+    if (v >= 10) {
+        t -= 2;
+        memcpy(t, &RC_DIGIT_PAIRS[v * 2], 2);
+    } else {
+        *--t = (char)('0' + v);
+    }
+    size_t n = tmp + sizeof(tmp) - t;
+    memcpy(p, t, n);
+    return p + n;
+}
+
+// Signed decimal (same as %d / %ld)
+inline char* rcFmtInt(char* p, int32_t v) {
+    if (v < 0) {
+        *p++ = '-';
+        return rcFmtUint(p, 0u - (uint32_t)v);
+    }
+    return rcFmtUint(p, (uint32_t)v);
+}
+
+// Zero-padded unsigned decimal (same as %0<width>d)
+inline char* rcFmtUintPadded(char* p, uint32_t v, uint8_t width) {
+    char digits[10];
+    char* end = rcFmtUint(digits, v);
+    size_t n = end - digits;
+    while (n < width) {
+        *p++ = '0';
+        width--;
+    }
+    memcpy(p, digits, n);
+    return p + n;
+}
+
+// Literal text
+inline char* rcFmtStr(char* p, const char* s) {
+    size_t n = strlen(s);
+    memcpy(p, s, n);
+    return p + n;
+}
+
+// Terminate line with CRLF + null, returns length (excluding null)
+inline size_t rcFmtEndLine(char* start, char* p) {
+    *p++ = '\r';
+    *p++ = '\n';
+    *p = '\0';
+    return p - start;
+}
+
+// "RC 1500,1500,...\r\n"
+// buffer must be at least RC_TEXT_ESP_BRIDGE_SIZE bytes
+inline size_t formatRcEspBridge(const int* us, char* buffer) {
+    char* p = buffer;
+    *p++ = 'R';
+    *p++ = 'C';
+    *p++ = ' ';
+    for (size_t i = 0; i < RC_TEXT_CHANNELS; i++) {
+        if (i) *p++ = ',';
+        p = rcFmtInt(p, us[i]);
+    }
+    return rcFmtEndLine(buffer, p);
+}
+
+// "$val,val,...,val,\r\n" - 24 fields, raw = (us - 1500) * 2, last 8 = 0
+// buffer must be at least RC_TEXT_R2D2_SIZE bytes
+inline size_t formatRcR2D2(const int* us, char* buffer) {
+    char* p = buffer;
+    *p++ = '$';
+    for (size_t i = 0; i < RC_TEXT_R2D2_FIELDS; i++) {
+        if (i < RC_TEXT_CHANNELS) {
+            p = rcFmtInt(p, (us[i] - 1500) * 2);
+        } else {
+            *p++ = '0';
+        }
+        *p++ = ',';
+    }
+    return rcFmtEndLine(buffer, p);
+}
+
+// Format 16 channel µs values in selected text format
+// Returns length of text string (excluding null terminator), 0 if buffer too small
+inline size_t formatRcText(const int* us, char* buffer, size_t bufferSize, uint8_t format) {
+    if (format == RC_TEXT_R2D2) {
+        return (bufferSize >= RC_TEXT_R2D2_SIZE) ? formatRcR2D2(us, buffer) : 0;
+    }
+    return (bufferSize >= RC_TEXT_ESP_BRIDGE_SIZE) ? formatRcEspBridge(us, buffer) : 0;
+}
@@ -10,6 +10,9 @@
 #define SBUS_START_BYTE 0x0F
 #define SBUS_END_BYTE 0x00
 #define SBUS_UPDATE_RATE_MS 14
+#define SBUS_FLAGS_RESERVED_MASK 0xF0   // Upper nibble of flags byte is always 0
+#define SBUS_FLAG_FRAME_LOST 0x04       // Flags byte (frame[23]) bit 2
+#define SBUS_FLAG_FAILSAFE 0x08         // Flags byte (frame[23]) bit 3
 
 // SBUS frame structure - exactly 25 bytes
 #pragma pack(push, 1)
@@ -39,6 +42,22 @@ inline SbusFlags extractSbusFlags(uint8_t flagByte) {
     return flags;
 }
 
+// Output scheduler periods (ms) accepted from config, 0 = write on frame arrival
+static constexpr uint8_t SBUS_OUTPUT_PERIODS[] = {7, 9, 14, 20};
+
+inline bool isValidSbusOutputPeriod(uint8_t periodMs) {
+    if (periodMs == 0) return true;
+    for (uint8_t p : SBUS_OUTPUT_PERIODS) {
+        if (p == periodMs) return true;
+    }
+    return false;
+}
+
+// Check for any of the valid SBUS end bytes (plain SBUS and SBUS2 slots)
+inline bool isSbusEndByte(uint8_t b) {
+    return b == 0x00 || b == 0x04 || b == 0x14 || b == 0x24;
+}
+
 // Unpack 11-bit SBUS channels from packed data
 inline void unpackSbusChannels(const uint8_t* data, uint16_t* channels) {
     // Unpack 16 channels (11 bits each) from 22 bytes
@@ -15,11 +15,49 @@ extern Config config;
 
 class SbusFastParser : public ProtocolParser {
 private:
+    // Quiet time after the last buffer write that marks a frame boundary
+    // (one frame takes 3ms on the wire, frames repeat every 7-14ms)
+    static constexpr uint32_t SBUS_SYNC_GAP_US = 2000;
+
     SbusRouter* router;         // Pointer to singleton
     uint8_t sourceId;           // CRITICAL: Store source ID for this parser
     uint32_t invalidFrames;     // Statistics
     uint32_t validFrames;
     uint32_t lastFrameTime;     // millis() of last valid frame
+    uint32_t syncLosses;        // Locked -> hunting transitions
+    uint32_t resyncBytes;       // Bytes discarded while hunting for frame start
+    bool locked;                // Frame boundary known, consume whole frames
+
+    // Copy up to len bytes from buffer head without consuming (no linearization)
+    static size_t peekBytes(CircularBuffer* buffer, uint8_t* dst, size_t len) {
+        CircularBuffer::SegmentPair seg = buffer->getReadSegments();
+        size_t n1 = min(len, seg.first.size);
+        if (n1) memcpy(dst, seg.first.data, n1);
+        size_t n2 = min(len - n1, seg.second.size);
+        if (n2) memcpy(dst + n1, seg.second.data, n2);
+        return n1 + n2;
+    }
+
+    // Offset of the first start byte candidate, or total available if none
+    static size_t findStartByte(CircularBuffer* buffer) {
+        CircularBuffer::SegmentPair seg = buffer->getReadSegments();
+        if (seg.first.size) {
+            const uint8_t* p = (const uint8_t*)memchr(seg.first.data, SBUS_START_BYTE, seg.first.size);
+            if (p) return p - seg.first.data;
+        }
+        if (seg.second.size) {
+            const uint8_t* p = (const uint8_t*)memchr(seg.second.data, SBUS_START_BYTE, seg.second.size);
+            if (p) return seg.first.size + (p - seg.second.data);
+        }
+        return seg.total();
+    }
+
+    // Drop one byte of a rejected candidate and keep hunting
+    void rejectCandidate(CircularBuffer* buffer) {
+        buffer->consume(1);
+        resyncBytes++;
+        invalidFrames++;
+    }
 
 public:
     // CRITICAL: Constructor with source ID
@@ -27,7 +65,10 @@ public:
         sourceId(src),
         invalidFrames(0),
         validFrames(0),
-        lastFrameTime(0) {
+        lastFrameTime(0),
+        syncLosses(0),
+        resyncBytes(0),
+        locked(false) {
 
         // Get singleton router instance
         router = SbusRouter::getInstance();
@@ -35,49 +76,73 @@ public:
     }
 
     // Fast path implementation
+    // Hunting: memchr to the next 0x0F, accept a candidate only when the end byte
+    // is valid and the next frame start (or an inter-frame gap with clean flags)
+    // confirms the boundary. Locked: consume whole frames, drop back to hunting
+    // on the first malformed frame.
     bool tryFastProcess(CircularBuffer* buffer, BridgeContext* ctx) override {
-        // Check if we have complete SBUS frame
-        if (buffer->available() < 25) return false;
-
-        // Get contiguous view for SBUS frame
-        ContiguousView view = buffer->getContiguousForParser(25);
-        if (view.safeLen < 25) return false;  // Not enough contiguous data
-
-        // Check first byte
-        if (view.ptr[0] != 0x0F) {
-            buffer->consume(1);  // Resync: slide window by 1 byte
-            return true;  // Handled
+        size_t avail = buffer->available();
+        if (avail < SBUS_FRAME_SIZE) return false;
+
+        if (!locked) {
+            size_t skip = findStartByte(buffer);
+            if (skip > 0) {
+                buffer->consume(skip);
+                resyncBytes += skip;
+                avail -= skip;
+                if (avail < SBUS_FRAME_SIZE) return true;  // Handled, wait for more data
+            }
         }
 
-        // Validate end byte (all 4 valid SBUS end bytes)
-        if (view.ptr[24] != 0x00 && view.ptr[24] != 0x04 &&
-            view.ptr[24] != 0x14 && view.ptr[24] != 0x24) {
-            // Invalid end byte - resync by consuming only 1 byte
-            buffer->consume(1);  // Slide window
-            invalidFrames++;
-            return true;  // Handled
+        // One extra byte lets the hunter check the following frame start
+        uint8_t frame[SBUS_FRAME_SIZE + 1];
+        size_t got = peekBytes(buffer, frame, locked ? SBUS_FRAME_SIZE : SBUS_FRAME_SIZE + 1);
+
+        bool shapeValid = (frame[0] == SBUS_START_BYTE) && isSbusEndByte(frame[24]);
+
+        if (locked) {
+            if (!shapeValid) {
+                locked = false;
+                syncLosses++;
+                rejectCandidate(buffer);
+                return true;
+            }
+        } else {
+            if (!shapeValid) {
+                rejectCandidate(buffer);
+                return true;
+            }
+            if (got > SBUS_FRAME_SIZE) {
+                if (frame[SBUS_FRAME_SIZE] != SBUS_START_BYTE) {
+                    rejectCandidate(buffer);
+                    return true;
+                }
+            } else if ((frame[23] & SBUS_FLAGS_RESERVED_MASK) != 0 ||
+                       buffer->getTimeSinceLastWriteMicros() < SBUS_SYNC_GAP_US) {
+                return false;  // Not confirmed yet - wait for next byte or gap
+            }
+            locked = true;
         }
 
-        // Valid frame - copy it
-        uint8_t frame[25];
-        memcpy(frame, view.ptr, 25);
-        buffer->consume(25);
+        buffer->consume(SBUS_FRAME_SIZE);
 
         validFrames++;
         lastFrameTime = millis();
 
-        // Update shared RC channel data for web UI monitor
-        uint16_t raw[16];
-        unpackSbusChannels(frame + 1, raw);
-        for (int i = 0; i < 16; i++) rcChannels.channels[i] = sbusToUs(raw[i]);
-        rcChannels.lastUpdateMs = lastFrameTime;
-
         // Route through singleton router
         // Router will handle:
         // - Source selection (Auto/Manual)
         // - Failsafe state management
         // - Writing to all registered outputs
-        router->routeFrame(frame, sourceId);
+        if (router->routeFrame(frame, sourceId)) {
+            // Active source - update shared RC channel data for web UI monitor
+            uint16_t us[16];
+            unpackSbusChannels(frame + 1, us);
+            for (int i = 0; i < 16; i++) us[i] = sbusToUs(us[i]);
+            uint8_t flags = ((frame[23] & SBUS_FLAG_FAILSAFE) ? RC_FLAG_FAILSAFE : 0) |
+                            ((frame[23] & SBUS_FLAG_FRAME_LOST) ? RC_FLAG_FRAME_LOST : 0);
+            rc_channels_publish(us, RC_SOURCE_SBUS, sourceId, flags, lastFrameTime);
+        }
 
         return true;  // Processed via fast path
     }
@@ -102,6 +167,9 @@ public:
         invalidFrames = 0;
         validFrames = 0;
         lastFrameTime = 0;
+        syncLosses = 0;
+        resyncBytes = 0;
+        locked = false;
     }
 
     const char* getName() const override {
@@ -116,6 +184,9 @@ public:
     uint32_t getValidFrames() const { return validFrames; }
     uint32_t getInvalidFrames() const { return invalidFrames; }
     uint32_t getLastFrameTime() const { return lastFrameTime; }
+    uint32_t getSyncLosses() const { return syncLosses; }
+    uint32_t getResyncBytes() const { return resyncBytes; }
+    bool isLocked() const { return locked; }
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "sbus_router.h"
 #include "../device_stats.h"
 #include "packet_sender.h"
+#include "../defines.h"
 
 // Static instance initialization
 SbusRouter* SbusRouter::instance = nullptr;
@@ -21,6 +22,7 @@ SbusRouter::SbusRouter() :
 
     memset(sources, 0, sizeof(sources));
     memset(lastValidFrame, 0, sizeof(lastValidFrame));
+    memset(latestFrame, 0, sizeof(latestFrame));
     memset(sourceConfigured, 0, sizeof(sourceConfigured));
 
     // Fixed priorities: Device1 > Device2 > Device3 > UDP
@@ -95,7 +97,16 @@ bool SbusRouter::routeFrame(const uint8_t* frame, uint8_t sourceId) {
 
     // Route frame if this is active source
     if (sourceId == activeSource) {
-        writeToOutputs(frame);
+        if (outputTimer) {
+            // Scheduler owns output cadence - just publish latest value
+            portENTER_CRITICAL(&latestMux);
+            memcpy(latestFrame, frame, 25);
+            latestValid = true;
+            latestFresh = true;
+            portEXIT_CRITICAL(&latestMux);
+        } else {
+            writeToOutputs(frame);
+        }
         return true;
     }
 
@@ -137,7 +148,8 @@ void SbusRouter::writeToOutputs(const uint8_t* frame) {
 
 void SbusRouter::tick() {
     // Only repeat for UDP source with Timing Keeper enabled
-    if (activeSource != SBUS_SOURCE_UDP || !timingKeeperEnabled) {
+    // Output scheduler already repeats at fixed cadence
+    if (activeSource != SBUS_SOURCE_UDP || !timingKeeperEnabled || outputTimer) {
         return;
     }
 
@@ -155,6 +167,133 @@ void SbusRouter::tick() {
     }
 }
 
+bool SbusRouter::startOutputScheduler(uint8_t periodMs) {
+    stopOutputScheduler();
+
+    if (periodMs == 0) return false;
+    if (!isValidSbusOutputPeriod(periodMs)) {
+        log_msg(LOG_ERROR, "SBUS output scheduler: invalid period %u ms", periodMs);
+        return false;
+    }
+
+    outputTaskStop = false;
+    outputTaskDone = false;
+    if (xTaskCreatePinnedToCore(outputTaskMain, "sbus_out", 4096, this,
+                                SBUS_OUT_TASK_PRIORITY, &outputTask, SBUS_OUT_TASK_CORE) != pdPASS) {
+        log_msg(LOG_ERROR, "SBUS output scheduler: task creation failed");
+        outputTask = nullptr;
+        return false;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = &SbusRouter::outputTimerCallback;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "sbus_out";
+
+    if (esp_timer_create(&args, &outputTimer) != ESP_OK) {
+        log_msg(LOG_ERROR, "SBUS output scheduler: esp_timer_create failed");
+        outputTimer = nullptr;
+        stopOutputScheduler();
+        return false;
+    }
+
+    outputPeriodMs = periodMs;
+    lastEmitUs = 0;
+    if (esp_timer_start_periodic(outputTimer, (uint64_t)periodMs * 1000) != ESP_OK) {
+        log_msg(LOG_ERROR, "SBUS output scheduler: esp_timer_start_periodic failed");
+        stopOutputScheduler();
+        return false;
+    }
+
+    log_msg(LOG_INFO, "SBUS output scheduler started: %u ms period", periodMs);
+    return true;
+}
+
+void SbusRouter::stopOutputScheduler() {
+    if (!outputTimer && !outputTask) return;
+
+    if (outputTimer) {
+        esp_timer_stop(outputTimer);
+        esp_timer_delete(outputTimer);
+        outputTimer = nullptr;
+    }
+
+    // Task finishes its current frame and deletes itself
+    if (outputTask) {
+        outputTaskStop = true;
+        xTaskNotifyGive(outputTask);
+        for (int i = 0; i < 50 && !outputTaskDone; i++) {
+            vTaskDelay(pdMS_TO_TICKS(2));
+        }
+        outputTask = nullptr;
+    }
+
+    outputPeriodMs = 0;
+    log_msg(LOG_INFO, "SBUS output scheduler stopped");
+}
+
+// esp_timer task: only wake the output task
+void SbusRouter::outputTimerCallback(void* arg) {
+    TaskHandle_t task = static_cast<SbusRouter*>(arg)->outputTask;
+    if (task) xTaskNotifyGive(task);
+}
+
+void SbusRouter::outputTaskMain(void* arg) {
+    SbusRouter* self = static_cast<SbusRouter*>(arg);
+    for (;;) {
+        // Ticks missed while writing collapse into one emit (latest-value semantics)
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (self->outputTaskStop) break;
+        self->emitScheduledFrame();
+    }
+    self->outputTaskDone = true;
+    vTaskDelete(nullptr);
+}
+
+void SbusRouter::emitScheduledFrame() {
+    // Runs in the sbus_out task - the only writer of outputs while the scheduler is on
+    int64_t nowUs = esp_timer_get_time();
+
+    // Period jitter (deviation from nominal interval between callbacks)
+    if (lastEmitUs != 0) {
+        int64_t deviation = (nowUs - lastEmitUs) - (int64_t)outputPeriodMs * 1000;
+        uint32_t jitterUs = (uint32_t)(deviation < 0 ? -deviation : deviation);
+        if (jitterUs > jitterMaxUs) jitterMaxUs = jitterUs;
+
+        size_t bucket = 0;
+        while (bucket < SBUS_JITTER_BUCKETS - 1 && jitterUs >= SBUS_JITTER_BUCKET_LIMITS_US[bucket]) {
+            bucket++;
+        }
+        jitterHist[bucket]++;
+    }
+    lastEmitUs = nowUs;
+
+    // Stop emitting when active source is lost - let FC detect signal loss
+    uint32_t timeoutMs = (activeSource == SBUS_SOURCE_UDP) ? udpSourceTimeoutMs : 100;
+    if (activeSource >= 4 || millis() - sources[activeSource].lastFrameTime > timeoutMs) {
+        schedSkipped++;
+        return;
+    }
+
+    uint8_t frame[25];
+    bool fresh;
+    portENTER_CRITICAL(&latestMux);
+    if (!latestValid) {
+        portEXIT_CRITICAL(&latestMux);
+        schedSkipped++;
+        return;
+    }
+    memcpy(frame, latestFrame, 25);
+    fresh = latestFresh;
+    latestFresh = false;
+    portEXIT_CRITICAL(&latestMux);
+
+    writeToOutputs(frame);
+    schedEmitted++;
+    if (!fresh) schedRepeated++;
+}
+
 uint8_t SbusRouter::getSourceQuality(uint8_t sourceId) const {
     if (sourceId >= 4 || !sourceConfigured[sourceId]) return 0;
 
@@ -10,8 +10,9 @@
 #include "../logging.h"
 #include <stdint.h>
 #include <vector>
+#include "esp_timer.h"
 
-// SBUS conversion buffer size - must fit TEXT (101 bytes) and MAVLink (64 bytes) if enabled
+// SBUS conversion buffer size - must fit TEXT (up to 172 bytes in R2D2 format) and MAVLink (64 bytes) if enabled
 #ifdef SBUS_MAVLINK_SUPPORT
 static constexpr size_t SBUS_OUTPUT_BUFFER_SIZE =
     (SBUS_TEXT_BUFFER_SIZE > SBUS_MAVLINK_BUFFER_SIZE) ? SBUS_TEXT_BUFFER_SIZE : SBUS_MAVLINK_BUFFER_SIZE;
@@ -19,6 +20,10 @@ static constexpr size_t SBUS_OUTPUT_BUFFER_SIZE =
 static constexpr size_t SBUS_OUTPUT_BUFFER_SIZE = SBUS_TEXT_BUFFER_SIZE;
 #endif
 
+// Jitter histogram buckets: |actual - nominal| period deviation in microseconds
+static constexpr size_t SBUS_JITTER_BUCKETS = 6;
+static constexpr uint32_t SBUS_JITTER_BUCKET_LIMITS_US[SBUS_JITTER_BUCKETS - 1] = {50, 100, 250, 500, 1000};
+
 // Forward declarations
 class PacketSender;
 
@@ -102,6 +107,31 @@ private:
     // Lazy-allocated conversion buffer (for TEXT/MAVLink output)
     char* convertBuffer = nullptr;
 
+    // Output scheduler (fixed cadence, latest-value semantics). The esp_timer only
+    // notifies outputTask; the frame is written from that task, so sender calls
+    // (AsyncUDP, UART, BLE) never block the shared esp_timer task.
+    esp_timer_handle_t outputTimer = nullptr;
+    TaskHandle_t outputTask = nullptr;
+    volatile bool outputTaskStop = false;  // Set by stopOutputScheduler()
+    volatile bool outputTaskDone = false;  // Set by the task right before it deletes itself
+    uint8_t outputPeriodMs = 0;            // 0 = scheduler off, write on arrival
+    portMUX_TYPE latestMux = portMUX_INITIALIZER_UNLOCKED;
+    uint8_t latestFrame[25];               // Most recent frame from active source
+    bool latestValid = false;
+    bool latestFresh = false;              // Updated since last emit
+    int64_t lastEmitUs = 0;
+
+    // Scheduler statistics
+    uint32_t schedEmitted = 0;
+    uint32_t schedRepeated = 0;            // Emits without a new input frame
+    uint32_t schedSkipped = 0;             // Ticks skipped (source lost)
+    uint32_t jitterMaxUs = 0;
+    uint32_t jitterHist[SBUS_JITTER_BUCKETS] = {0};
+
+    static void outputTimerCallback(void* arg);
+    static void outputTaskMain(void* arg);
+    void emitScheduledFrame();
+
 public:
     // Singleton accessor
     static SbusRouter* getInstance() {
@@ -192,6 +222,19 @@ public:
     // Timing keeper tick (called from TaskScheduler)
     void tick();
 
+    // Output scheduler control (periodMs: 7/9/14/20, 0 = stop)
+    bool startOutputScheduler(uint8_t periodMs);
+    void stopOutputScheduler();
+    bool isOutputSchedulerActive() const { return outputTimer != nullptr; }
+    uint8_t getOutputPeriodMs() const { return outputPeriodMs; }
+
+    // Scheduler statistics for Web UI
+    uint32_t getSchedulerEmitted() const { return schedEmitted; }
+    uint32_t getSchedulerRepeated() const { return schedRepeated; }
+    uint32_t getSchedulerSkipped() const { return schedSkipped; }
+    uint32_t getJitterMaxUs() const { return jitterMaxUs; }
+    const uint32_t* getJitterHistogram() const { return jitterHist; }
+
     // Write to all registered outputs
     void writeToOutputs(const uint8_t* frame);
 
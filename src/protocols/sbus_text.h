@@ -1,15 +1,19 @@
 // SBUS Text Format Conversion
 // Converts binary SBUS frames to text format for Mission Planner RC Override
 // Format: "RC 1500,1500,...\r\n" (16 channels in microseconds)
+// or R2D2 "$val,...,val,\r\n" - selected globally by Config.rcTextFormat
 #pragma once
 
 #include <stdint.h>
 #include <stddef.h>
-#include <stdio.h>
 #include "sbus_common.h"
+#include "rc_text_format.h"
+#include "../config.h"
 
-// Text output buffer size: "RC " + 16 channels * 5 chars max + 15 commas + "\r\n" + null
-static constexpr size_t SBUS_TEXT_BUFFER_SIZE = 3 + 16 * 5 + 15 + 2 + 1;
+extern Config config;
+
+// Text output buffer size: longest supported line (R2D2, 24 fields) + null
+static constexpr size_t SBUS_TEXT_BUFFER_SIZE = RC_TEXT_BUFFER_SIZE;
 
 // Convert SBUS raw value to microseconds
 // OpenTX/EdgeTX standard: 172 → 988µs, 992 → 1500µs, 1811 → 2012µs
@@ -39,13 +43,10 @@ inline size_t sbusFrameToText(const uint8_t* frame, char* buffer, size_t bufferS
     uint16_t channels[SBUS_CHANNELS];
     unpackSbusChannels(frame + 1, channels);  // Skip start byte
 
-    // Format: "RC 1500,1500,...\r\n"
-    int len = snprintf(buffer, bufferSize,
-        "RC %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\r\n",
-        sbusToUs(channels[0]),  sbusToUs(channels[1]),  sbusToUs(channels[2]),  sbusToUs(channels[3]),
-        sbusToUs(channels[4]),  sbusToUs(channels[5]),  sbusToUs(channels[6]),  sbusToUs(channels[7]),
-        sbusToUs(channels[8]),  sbusToUs(channels[9]),  sbusToUs(channels[10]), sbusToUs(channels[11]),
-        sbusToUs(channels[12]), sbusToUs(channels[13]), sbusToUs(channels[14]), sbusToUs(channels[15]));
+    int us[SBUS_CHANNELS];
+    for (size_t i = 0; i < SBUS_CHANNELS; i++) {
+        us[i] = sbusToUs(channels[i]);
+    }
 
-    return (len > 0 && (size_t)len < bufferSize) ? len : 0;
+    return formatRcText(us, buffer, bufferSize, config.rcTextFormat);
 }
@@ -0,0 +1,171 @@
+#include "sbus_udp_envelope.h"
+#include "../device_stats.h"
+
+// Static instance initialization
+SbusUdpReceiver* SbusUdpReceiver::instance = nullptr;
+
+bool SbusUdpReceiver::handleDatagram(const uint8_t* data, size_t len) {
+    SbusUdpEnvelopeHeader hdr;
+    if (!sbusUdpEnvelopeParse(data, len, &hdr)) return false;
+
+    uint32_t nowUs = micros();
+    uint32_t nowMs = millis();
+
+    portENTER_CRITICAL(&mux);
+    stats.datagrams++;
+
+    // Stream (re)start: long silence or sender reboot (large backward jump)
+    if (haveSeq) {
+        int32_t jump = (int32_t)(hdr.seq - lastSeq);
+        if (nowMs - lastDatagramMs > STREAM_RESET_MS || jump < -SEQ_RESET_WINDOW) {
+            haveSeq = false;
+            haveTransit = false;
+        }
+    }
+    lastDatagramMs = nowMs;
+
+    // Newest frame already superseded - late or reordered datagram, never roll back
+    if (haveSeq && (int32_t)(hdr.seq - lastSeq) <= 0) {
+        stats.framesStale++;
+        portEXIT_CRITICAL(&mux);
+        return true;
+    }
+
+    // Raw datagram loss - every datagram carries exactly one new newest frame
+    bool continuing = haveSeq;              // False on stream (re)start: nothing to recover
+    uint32_t prevNewestSeq = lastNewestSeq;
+    if (continuing) {
+        int32_t gap = (int32_t)(hdr.seq - prevNewestSeq);
+        if (gap > 1) stats.datagramsLost += gap - 1;
+    }
+    lastNewestSeq = hdr.seq;
+
+    updateJitter(hdr.sendTimeUs, nowUs);
+
+    uint32_t playoutUs = (jitter16 >> 4) * JB_JITTER_MULT;
+    if (playoutUs > JB_MAX_DELAY_US) playoutUs = JB_MAX_DELAY_US;
+    stats.playoutDelayUs = playoutUs;
+
+    // Playout time on local clock: send time + minimal transit + jitter delay
+    uint32_t releaseUs = hdr.sendTimeUs + (uint32_t)baseTransit + playoutUs;
+
+    const uint8_t* frames = data + SBUS_UDP_ENV_HEADER_SIZE;
+    uint32_t firstSeq = hdr.seq - (hdr.frameCount - 1);
+
+    for (uint8_t i = 0; i < hdr.frameCount; i++) {
+        uint32_t seq = firstSeq + i;
+        bool newest = (i == hdr.frameCount - 1);
+
+        if (haveSeq) {
+            int32_t diff = (int32_t)(seq - lastSeq);
+            if (diff <= 0) {
+                stats.duplicates++;  // Copy of a frame we already have
+                continue;
+            }
+            if (diff > 1) {
+                stats.framesLost += diff - 1;
+            }
+        }
+
+        haveSeq = true;
+        lastSeq = seq;
+        stats.framesAccepted++;
+        // Redundant copy newer than the previous datagram's newest frame = it was lost
+        if (!newest && continuing && (int32_t)(seq - prevNewestSeq) > 0) {
+            stats.framesRecovered++;
+        }
+
+        // Only the newest frame is de-jittered, older ones are already late
+        if (newest && (int32_t)(releaseUs - nowUs) > 0) {
+            pushPending(frames + i * SBUS_FRAME_SIZE, releaseUs);
+        } else {
+            if (newest) stats.lateReleases++;
+            pushPending(frames + i * SBUS_FRAME_SIZE, nowUs);
+        }
+    }
+
+    portEXIT_CRITICAL(&mux);
+    return true;
+}
+
+void SbusUdpReceiver::updateJitter(uint32_t sendTimeUs, uint32_t nowUs) {
+    // Transit includes unknown clock offset - only differences are meaningful
+    int32_t transit = (int32_t)(nowUs - sendTimeUs);
+
+    if (!haveTransit) {
+        haveTransit = true;
+        jitter16 = 0;
+        baseTransit = transit;
+        windowMinTransit = transit;
+        windowStartUs = nowUs;
+        lastTransit = transit;
+        stats.jitterUs = 0;
+        return;
+    }
+
+    // RFC 3550 interarrival jitter: J += (|D| - J) / 16, kept scaled by 16
+    int32_t d = transit - lastTransit;
+    if (d < 0) d = -d;
+    jitter16 = jitter16 + (uint32_t)d - ((jitter16 + 8) >> 4);
+    lastTransit = transit;
+    stats.jitterUs = jitter16 >> 4;
+
+    // Minimal transit over a sliding window (tracks sender/receiver clock drift)
+    if (transit - windowMinTransit < 0) windowMinTransit = transit;
+    if (transit - baseTransit < 0) baseTransit = transit;
+    if (nowUs - windowStartUs > BASE_WINDOW_US) {
+        baseTransit = windowMinTransit;
+        windowMinTransit = transit;
+        windowStartUs = nowUs;
+    }
+}
+
+void SbusUdpReceiver::pushPending(const uint8_t* frame, uint32_t releaseUs) {
+    // Full - drop oldest, it is superseded by newer frames anyway
+    if (pendingCount == JB_SLOTS) {
+        pendingHead = (pendingHead + 1) % JB_SLOTS;
+        pendingCount--;
+        stats.overflows++;
+    }
+
+    PendingFrame& slot = pending[(pendingHead + pendingCount) % JB_SLOTS];
+    memcpy(slot.frame, frame, SBUS_FRAME_SIZE);
+    slot.releaseUs = releaseUs;
+    pendingCount++;
+}
+
+size_t SbusUdpReceiver::releaseDue(CircularBuffer* out) {
+    if (!out || pendingCount == 0) return 0;
+
+    uint8_t due[JB_SLOTS][SBUS_FRAME_SIZE];
+    size_t count = 0;
+    uint32_t nowUs = micros();
+
+    portENTER_CRITICAL(&mux);
+    while (pendingCount > 0) {
+        PendingFrame& p = pending[pendingHead];
+        if ((int32_t)(nowUs - p.releaseUs) < 0) break;  // FIFO - rest is later
+        memcpy(due[count++], p.frame, SBUS_FRAME_SIZE);
+        pendingHead = (pendingHead + 1) % JB_SLOTS;
+        pendingCount--;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    for (size_t i = 0; i < count; i++) {
+        out->write(due[i], SBUS_FRAME_SIZE);
+    }
+
+    if (count > 0) {
+        g_deviceStats.device4.rxBytes.fetch_add(count * SBUS_FRAME_SIZE, std::memory_order_relaxed);
+        g_deviceStats.lastGlobalActivity.store(millis(), std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+SbusUdpReceiver::Stats SbusUdpReceiver::getStats() {
+    portENTER_CRITICAL(&mux);
+    Stats copy = stats;
+    portEXIT_CRITICAL(&mux);
+    return copy;
+}
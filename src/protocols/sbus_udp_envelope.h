@@ -0,0 +1,149 @@
+#ifndef SBUS_UDP_ENVELOPE_H
+#define SBUS_UDP_ENVELOPE_H
+
+#include "sbus_common.h"
+#include "../circular_buffer.h"
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+
+// Optional SBUS-over-UDP envelope (ESP -> ESP links)
+//
+// Datagram layout (little-endian):
+//   [0..1]  magic 'S','B'
+//   [2]     version (1)
+//   [3]     frame count (1..SBUS_UDP_ENV_MAX_FRAMES)
+//   [4..7]  sequence number of the LAST (newest) frame
+//   [8..11] sender micros() at send time
+//   [12..]  frames, oldest first, consecutive sequence numbers
+//
+// Raw 25/50/75-byte datagrams start with 0x0F and are still accepted as before.
+// With redundancy the sender repeats the previous N frames in every datagram;
+// the receiver drops copies by sequence, so a single lost datagram costs nothing.
+#define SBUS_UDP_ENV_MAGIC0      0x53  // 'S'
+#define SBUS_UDP_ENV_MAGIC1      0x42  // 'B'
+#define SBUS_UDP_ENV_VERSION     1
+#define SBUS_UDP_ENV_HEADER_SIZE 12
+#define SBUS_UDP_ENV_MAX_FRAMES  4
+#define SBUS_UDP_MAX_REDUNDANCY  (SBUS_UDP_ENV_MAX_FRAMES - 1)  // Previous frames per datagram
+
+struct SbusUdpEnvelopeHeader {
+    uint8_t frameCount;
+    uint32_t seq;           // Sequence of newest frame
+    uint32_t sendTimeUs;    // Sender clock
+};
+
+inline size_t sbusUdpEnvelopeWriteHeader(uint8_t* dst, uint32_t seq, uint32_t sendTimeUs, uint8_t frameCount) {
+    dst[0] = SBUS_UDP_ENV_MAGIC0;
+    dst[1] = SBUS_UDP_ENV_MAGIC1;
+    dst[2] = SBUS_UDP_ENV_VERSION;
+    dst[3] = frameCount;
+    memcpy(dst + 4, &seq, 4);          // ESP32 is little-endian
+    memcpy(dst + 8, &sendTimeUs, 4);
+    return SBUS_UDP_ENV_HEADER_SIZE;
+}
+
+// Validate envelope and extract header. Returns false for raw/unknown datagrams.
+inline bool sbusUdpEnvelopeParse(const uint8_t* data, size_t len, SbusUdpEnvelopeHeader* hdr) {
+    if (len < SBUS_UDP_ENV_HEADER_SIZE + SBUS_FRAME_SIZE) return false;
+    if (data[0] != SBUS_UDP_ENV_MAGIC0 || data[1] != SBUS_UDP_ENV_MAGIC1) return false;
+    if (data[2] != SBUS_UDP_ENV_VERSION) return false;
+
+    uint8_t count = data[3];
+    if (count == 0 || count > SBUS_UDP_ENV_MAX_FRAMES) return false;
+    if (len != SBUS_UDP_ENV_HEADER_SIZE + (size_t)count * SBUS_FRAME_SIZE) return false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (data[SBUS_UDP_ENV_HEADER_SIZE + i * SBUS_FRAME_SIZE] != SBUS_START_BYTE) return false;
+    }
+
+    hdr->frameCount = count;
+    memcpy(&hdr->seq, data + 4, 4);
+    memcpy(&hdr->sendTimeUs, data + 8, 4);
+    return true;
+}
+
+// Receiver side of the envelope: ordering, loss accounting and jitter buffer.
+// handleDatagram() runs in the AsyncUDP task, releaseDue() in the bridge task.
+class SbusUdpReceiver {
+public:
+    // Link statistics snapshot for Web UI
+    struct Stats {
+        uint32_t datagrams;       // Envelope datagrams received
+        uint32_t framesAccepted;  // New frames passed on (in order)
+        uint32_t framesLost;      // Sequence gaps never filled
+        uint32_t framesRecovered; // Gaps filled from redundant copies
+        uint32_t datagramsLost;   // Gaps in newest-frame sequence (raw link loss)
+        uint32_t framesStale;     // Late/reordered datagrams dropped
+        uint32_t duplicates;      // Already-seen frames (redundant copies)
+        uint32_t lateReleases;    // Frames that arrived after their playout time
+        uint32_t overflows;       // Pending frames superseded before release
+        uint32_t jitterUs;        // Smoothed interarrival jitter (RFC 3550)
+        uint32_t playoutDelayUs;  // Current jitter buffer delay
+    };
+
+private:
+    // Jitter buffer depth (frames) and latency budget
+    static constexpr size_t JB_SLOTS = 8;
+    static constexpr uint32_t JB_MAX_DELAY_US = 10000;   // Never delay more than 10ms
+    static constexpr uint32_t JB_JITTER_MULT = 3;        // Delay = 3 x jitter
+    static constexpr uint32_t BASE_WINDOW_US = 2000000;  // Min-transit window (clock drift)
+    static constexpr uint32_t STREAM_RESET_MS = 1000;    // Accept any seq after silence
+    static constexpr int32_t SEQ_RESET_WINDOW = 1000;    // Big backward jump = sender restart
+
+    struct PendingFrame {
+        uint8_t frame[SBUS_FRAME_SIZE];
+        uint32_t releaseUs;
+    };
+
+    PendingFrame pending[JB_SLOTS];
+    size_t pendingHead = 0;   // Oldest
+    size_t pendingCount = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Sequence tracking
+    bool haveSeq = false;
+    uint32_t lastSeq = 0;
+    uint32_t lastNewestSeq = 0;   // Newest seq of previous datagram
+    uint32_t lastDatagramMs = 0;
+
+    // Jitter estimation
+    bool haveTransit = false;
+    int32_t lastTransit = 0;
+    uint32_t jitter16 = 0;        // Jitter in us, scaled by 16
+    int32_t baseTransit = 0;      // Min transit (sender clock -> local clock offset)
+    int32_t windowMinTransit = 0;
+    uint32_t windowStartUs = 0;
+
+    Stats stats = {};
+
+    static SbusUdpReceiver* instance;
+    SbusUdpReceiver() {}
+
+    SbusUdpReceiver(const SbusUdpReceiver&) = delete;
+    SbusUdpReceiver& operator=(const SbusUdpReceiver&) = delete;
+
+    void updateJitter(uint32_t sendTimeUs, uint32_t nowUs);
+    void pushPending(const uint8_t* frame, uint32_t releaseUs);
+
+public:
+    static SbusUdpReceiver* getInstance() {
+        if (!instance) {
+            instance = new SbusUdpReceiver();
+        }
+        return instance;
+    }
+
+    // Called from UDP callback. Returns false if datagram is not an envelope.
+    bool handleDatagram(const uint8_t* data, size_t len);
+
+    // Move frames whose playout time has come into output buffer (bridge task)
+    size_t releaseDue(CircularBuffer* out);
+
+    // True once at least one envelope datagram was seen
+    bool isActive() const { return stats.datagrams > 0; }
+
+    Stats getStats();
+};
+
+#endif // SBUS_UDP_ENVELOPE_H
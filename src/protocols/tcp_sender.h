@@ -0,0 +1,74 @@
+#ifndef TCP_SENDER_H
+#define TCP_SENDER_H
+
+#include "packet_sender.h"
+#include "tcp_server_transport.h"
+#include "../wifi/wifi_manager.h"
+
+// Device4 Bridge over TCP: moves queued packets into the client rings of
+// TcpServerTransport, which coalesces them into segment-sized writes.
+class TcpSender : public PacketSender {
+private:
+    TcpServerTransport* tcpTransport;  // Passed from outside
+
+    void discardQueue() {
+        while (!packetQueue.empty()) {
+            currentQueueBytes -= packetQueue.front().packet.size;
+            packetQueue.front().packet.free();
+            packetQueue.pop_front();
+        }
+    }
+
+public:
+    explicit TcpSender(TcpServerTransport* transport) :
+        PacketSender(DEFAULT_MAX_PACKETS, DEFAULT_MAX_BYTES),
+        tcpTransport(transport) {
+        log_msg(LOG_INFO, "TcpSender: created");
+    }
+
+    // Out-of-band data (trigger notifications) - queued like any packet, never blocks
+    size_t sendDirect(const uint8_t* data, size_t size) override {
+        if (!tcpTransport || !wifiIsReady()) return 0;
+        if (tcpTransport->append(data, size, millis()) == 0) {
+            totalDropped++;
+            return 0;
+        }
+        totalSent++;
+        return size;
+    }
+
+    void processSendQueue(bool bulkMode = false) override {
+        // No clients: drop silently (not counted), like UDP without targets
+        if (!wifiIsReady() || !tcpTransport->hasClients()) {
+            discardQueue();
+            return;
+        }
+
+        uint32_t now = millis();
+        while (!packetQueue.empty()) {
+            QueuedPacket* item = &packetQueue.front();
+            // No client took it (rings full or lock busy): lost for everyone
+            if (tcpTransport->append(item->packet.data, item->packet.size, now) > 0) {
+                totalSent++;
+            } else {
+                totalDropped++;
+            }
+
+            currentQueueBytes -= item->packet.size;
+            item->packet.free();
+            packetQueue.pop_front();
+        }
+
+        tcpTransport->flush(now, bulkMode);
+    }
+
+    bool isReady() const override {
+        return true;  // Slow clients are handled per client by the transport
+    }
+
+    const char* getName() const override {
+        return "TCP";
+    }
+};
+
+#endif // TCP_SENDER_H
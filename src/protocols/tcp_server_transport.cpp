@@ -0,0 +1,349 @@
+#include "tcp_server_transport.h"
+#include "../logging.h"
+#include "../device_stats.h"
+#include "esp_heap_caps.h"
+
+static uint8_t* allocRing() {
+    uint8_t* ring = static_cast<uint8_t*>(heap_caps_malloc(TCP_CLIENT_RING_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!ring) {
+        ring = static_cast<uint8_t*>(heap_caps_malloc(TCP_CLIENT_RING_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    return ring;
+}
+
+TcpServerTransport::TcpServerTransport(uint16_t port, CircularBuffer* rxBuffer, uint8_t slowPolicy) :
+    port(port),
+    slowPolicy(slowPolicy),
+    rxBuffer(rxBuffer) {
+
+    for (Client& c : clients) {
+        c.owner = this;
+        c.client = nullptr;
+        c.ring = nullptr;
+    }
+}
+
+TcpServerTransport::~TcpServerTransport() {
+    end();
+    for (Client& c : clients) {
+        free(c.ring);
+        c.ring = nullptr;
+    }
+    if (clientLock) {
+        vSemaphoreDelete(clientLock);
+    }
+    delete server;
+}
+
+bool TcpServerTransport::begin() {
+    clientLock = xSemaphoreCreateMutex();
+    if (!clientLock) {
+        log_msg(LOG_ERROR, "TCP server: lock allocation failed");
+        return false;
+    }
+
+    server = new AsyncServer(port);
+    server->setNoDelay(true);
+    server->onClient([](void* arg, AsyncClient* client) {
+        static_cast<TcpServerTransport*>(arg)->handleClient(client);
+    }, this);
+    server->begin();
+
+    log_msg(LOG_INFO, "TCP server listening on port %u (%d clients, %u KB ring each, %s slow clients)",
+            port, TCP_MAX_CLIENTS, TCP_CLIENT_RING_SIZE / 1024,
+            slowPolicy == TCP_SLOW_DISCONNECT ? "disconnect" : "drop for");
+    return true;
+}
+
+void TcpServerTransport::end() {
+    if (server) {
+        server->end();
+    }
+    if (!clientLock) return;
+
+    // Collect under the lock, close outside - close() runs onDisconnect, which takes it
+    AsyncClient* open[TCP_MAX_CLIENTS];
+    size_t n = 0;
+    xSemaphoreTake(clientLock, portMAX_DELAY);
+    for (Client& c : clients) {
+        if (c.client) open[n++] = c.client;
+    }
+    xSemaphoreGive(clientLock);
+
+    for (size_t i = 0; i < n; i++) {
+        open[i]->close(true);
+    }
+}
+
+// async_tcp task
+void TcpServerTransport::handleClient(AsyncClient* client) {
+    Client* slot = nullptr;
+
+    // Ring lives only as long as the connection - idle server holds no send memory
+    uint8_t* ring = allocRing();
+    if (!ring) {
+        log_msg(LOG_ERROR, "TCP client %s rejected: send ring allocation failed",
+                client->remoteIP().toString().c_str());
+        client->close(true);
+        delete client;
+        return;
+    }
+
+    if (xSemaphoreTake(clientLock, pdMS_TO_TICKS(100)) == pdTRUE) {
+        for (Client& c : clients) {
+            if (c.client) continue;
+            slot = &c;
+            c.client = client;
+            c.ring = ring;
+            c.head = 0;
+            c.tail = 0;
+            c.used = 0;
+            c.mss = client->getMss() ? client->getMss() : TCP_DEFAULT_MSS;
+            c.oldestMs = 0;
+            c.stallStartMs = 0;
+            c.unacked.store(0, std::memory_order_relaxed);
+            c.closeRequested.store(false, std::memory_order_relaxed);
+            c.ip = (uint32_t)client->remoteIP();
+            c.port = client->remotePort();
+            c.connectedMs = millis();
+            c.txBytes = 0;
+            c.writes = 0;
+            c.dropPackets = 0;
+            c.dropBytes = 0;
+            c.rxBytes = 0;
+            clientCount.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        xSemaphoreGive(clientLock);
+    }
+
+    if (!slot) {
+        free(ring);
+        rejectedClients++;
+        log_msg(LOG_WARNING, "TCP client %s rejected (%d clients max)",
+                client->remoteIP().toString().c_str(), TCP_MAX_CLIENTS);
+        client->close(true);
+        delete client;
+        return;
+    }
+
+    client->setNoDelay(true);
+
+    client->onData([](void* arg, AsyncClient* client, void* data, size_t len) {
+        Client* c = static_cast<Client*>(arg);
+        CircularBuffer* rx = c->owner->rxBuffer;
+        if (!rx) return;
+        size_t written = rx->write(static_cast<const uint8_t*>(data), len);
+        c->rxBytes += len;
+        g_deviceStats.device4.rxPackets.fetch_add(1, std::memory_order_relaxed);
+        if (written < len) {
+            log_msg(LOG_WARNING, "TCP RX buffer full, %zu bytes lost", len - written);
+        }
+    }, slot);
+
+    client->onAck([](void* arg, AsyncClient* client, size_t len, uint32_t time) {
+        Client* c = static_cast<Client*>(arg);
+        uint32_t unacked = c->unacked.load(std::memory_order_relaxed);
+        uint32_t next;
+        do {
+            next = (len >= unacked) ? 0 : unacked - len;
+        } while (!c->unacked.compare_exchange_weak(unacked, next, std::memory_order_relaxed));
+    }, slot);
+
+    client->onPoll([](void* arg, AsyncClient* client) {
+        Client* c = static_cast<Client*>(arg);
+        if (c->closeRequested.load(std::memory_order_relaxed)) {
+            client->close(true);
+        }
+    }, slot);
+
+    client->onTimeout([](void* arg, AsyncClient* client, uint32_t time) {
+        client->close(true);
+    }, slot);
+
+    client->onDisconnect([](void* arg, AsyncClient* client) {
+        Client* c = static_cast<Client*>(arg);
+        c->owner->handleDisconnect(c, client);
+    }, slot);
+
+    log_msg(LOG_INFO, "TCP client %s:%u connected (MSS %u)",
+            client->remoteIP().toString().c_str(), slot->port, slot->mss);
+}
+
+// async_tcp task (or end()), client is freed here
+void TcpServerTransport::handleDisconnect(Client* c, AsyncClient* client) {
+    uint32_t ip = 0;
+    uint16_t remotePort = 0;
+    uint32_t drops = 0;
+    uint8_t* ring = nullptr;
+
+    xSemaphoreTake(clientLock, portMAX_DELAY);
+    if (c->client == client) {
+        ip = c->ip;
+        remotePort = c->port;
+        drops = c->dropPackets;
+        ring = c->ring;
+        c->ring = nullptr;
+        c->client = nullptr;
+        c->used = 0;
+        clientCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    xSemaphoreGive(clientLock);
+
+    free(ring);
+    delete client;
+
+    if (ip) {
+        log_msg(LOG_INFO, "TCP client %s:%u disconnected (%u packets dropped)",
+                IPAddress(ip).toString().c_str(), remotePort, (unsigned)drops);
+    }
+}
+
+size_t TcpServerTransport::append(const uint8_t* data, size_t size, uint32_t now) {
+    if (size == 0 || size > TCP_CLIENT_RING_SIZE || !hasClients()) return 0;
+    if (xSemaphoreTake(clientLock, pdMS_TO_TICKS(2)) != pdTRUE) return 0;
+
+    size_t accepted = 0;
+    for (Client& c : clients) {
+        if (!c.client || c.closeRequested.load(std::memory_order_relaxed)) continue;
+
+        if (TCP_CLIENT_RING_SIZE - c.used < size) {
+            // Slow client: drop the whole packet, never a partial one
+            c.dropPackets++;
+            c.dropBytes += size;
+            if (!c.stallStartMs) {
+                c.stallStartMs = now ? now : 1;
+            } else if (slowPolicy == TCP_SLOW_DISCONNECT &&
+                       (now - c.stallStartMs) >= TCP_STALL_DISCONNECT_MS) {
+                c.closeRequested.store(true, std::memory_order_relaxed);
+                slowDisconnects++;
+                log_msg(LOG_WARNING, "TCP client %s:%u not reading for %u ms, disconnecting",
+                        IPAddress(c.ip).toString().c_str(), c.port, TCP_STALL_DISCONNECT_MS);
+            }
+            continue;
+        }
+
+        size_t first = TCP_CLIENT_RING_SIZE - c.head;
+        if (first > size) first = size;
+        memcpy(c.ring + c.head, data, first);
+        memcpy(c.ring, data + first, size - first);
+        c.head = (c.head + size) % TCP_CLIENT_RING_SIZE;
+        if (c.used == 0) c.oldestMs = now;
+        c.used += size;
+        accepted++;
+    }
+
+    xSemaphoreGive(clientLock);
+    return accepted;
+}
+
+// Hand ring bytes to lwIP, as much as the send buffer takes (caller holds clientLock)
+size_t TcpServerTransport::writeRing(Client& c) {
+    size_t space = c.client->space();
+    size_t toSend = (c.used < space) ? c.used : space;
+    size_t sent = 0;
+
+    while (toSend > 0) {
+        size_t chunk = TCP_CLIENT_RING_SIZE - c.tail;
+        if (chunk > toSend) chunk = toSend;
+        size_t added = c.client->add(reinterpret_cast<const char*>(c.ring + c.tail), chunk,
+                                     ASYNC_WRITE_FLAG_COPY);
+        if (added == 0) break;
+        c.tail = (c.tail + added) % TCP_CLIENT_RING_SIZE;
+        c.used -= added;
+        toSend -= added;
+        sent += added;
+    }
+
+    if (sent > 0) {
+        c.client->send();
+        c.unacked.fetch_add(sent, std::memory_order_relaxed);
+        c.txBytes += sent;
+        c.writes++;
+        // oldestMs stays: what is left may be older than this write, append() restarts it once drained
+    }
+    if (c.stallStartMs && c.used < TCP_CLIENT_RING_SIZE / 2) {
+        c.stallStartMs = 0;
+    }
+    return sent;
+}
+
+void TcpServerTransport::flush(uint32_t now, bool bulkMode) {
+    if (!hasClients()) return;
+    if (xSemaphoreTake(clientLock, pdMS_TO_TICKS(2)) != pdTRUE) return;
+
+    uint32_t latencyCap = bulkMode ? TCP_COALESCE_MS_BULK : TCP_COALESCE_MS_NORMAL;
+    size_t totalSent = 0;
+    uint32_t writes = 0;
+
+    for (Client& c : clients) {
+        if (!c.client || c.used == 0 || c.closeRequested.load(std::memory_order_relaxed)) continue;
+
+        bool segmentFull = c.used >= c.mss;
+        bool lineIdle = c.unacked.load(std::memory_order_relaxed) == 0;
+        bool due = (now - c.oldestMs) >= latencyCap;
+        if (!segmentFull && !lineIdle && !due) continue;
+
+        size_t sent = writeRing(c);
+        if (sent > 0) {
+            totalSent += sent;
+            writes++;
+        }
+    }
+
+    xSemaphoreGive(clientLock);
+
+    if (totalSent > 0) {
+        g_deviceStats.device4.txBytes.fetch_add(totalSent, std::memory_order_relaxed);
+        g_deviceStats.device4.txPackets.fetch_add(writes, std::memory_order_relaxed);
+        g_deviceStats.lastGlobalActivity.store(now, std::memory_order_relaxed);
+    }
+}
+
+void TcpServerTransport::appendJson(JsonObject obj) {
+    obj["port"] = port;
+    obj["slowPolicy"] = slowPolicy == TCP_SLOW_DISCONNECT ? "disconnect" : "drop";
+    obj["rejected"] = rejectedClients;
+    obj["slowDisconnects"] = slowDisconnects;
+    JsonArray arr = obj["clients"].to<JsonArray>();
+
+    // Copy under the lock, build JSON outside it - appends must not wait for a render
+    struct ClientStats {
+        uint32_t ip;
+        uint16_t port;
+        uint32_t connectedMs;
+        size_t used;
+        uint32_t txBytes;
+        uint32_t rxBytes;
+        uint32_t writes;
+        uint32_t dropPackets;
+        uint32_t dropBytes;
+        bool stalled;
+    } copies[TCP_MAX_CLIENTS];
+    size_t n = 0;
+
+    if (!clientLock || xSemaphoreTake(clientLock, pdMS_TO_TICKS(10)) != pdTRUE) return;
+    for (const Client& c : clients) {
+        if (!c.client) continue;
+        copies[n++] = {c.ip, c.port, c.connectedMs, c.used, c.txBytes, c.rxBytes,
+                       c.writes, c.dropPackets, c.dropBytes, c.stallStartMs != 0};
+    }
+    xSemaphoreGive(clientLock);
+
+    uint32_t now = millis();
+    for (size_t i = 0; i < n; i++) {
+        const ClientStats& c = copies[i];
+        JsonObject o = arr.add<JsonObject>();
+        o["ip"] = IPAddress(c.ip).toString();
+        o["port"] = c.port;
+        o["connectedS"] = (now - c.connectedMs) / 1000;
+        o["queued"] = c.used;
+        o["txBytes"] = c.txBytes;
+        o["rxBytes"] = c.rxBytes;
+        o["writes"] = c.writes;
+        o["avgWrite"] = c.writes ? c.txBytes / c.writes : 0;
+        o["dropPackets"] = c.dropPackets;
+        o["dropBytes"] = c.dropBytes;
+        o["stalled"] = c.stalled;
+    }
+}
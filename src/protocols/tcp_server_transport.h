@@ -0,0 +1,101 @@
+#ifndef TCP_SERVER_TRANSPORT_H
+#define TCP_SERVER_TRANSPORT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <AsyncTCP.h>
+#include <atomic>
+#include "../circular_buffer.h"
+
+// Device4 Bridge over TCP (device4.transport = TCP): server on device4.port.
+//
+// Every client has its own send ring, filled and flushed by the sender task
+// (TcpSender). Small packets are coalesced: a ring is written when it holds a
+// full segment (MSS), when nothing is in flight (Nagle - the first packet after
+// an idle line goes out at once), or when its oldest byte waited the latency
+// cap. lwIP Nagle is disabled, the coalescing happens here.
+//
+// A client that stops reading fills its ring; further packets for it are
+// dropped whole (never cut mid-packet). With TCP_SLOW_DISCONNECT the client is
+// closed once its ring stayed full for TCP_STALL_DISCONNECT_MS.
+//
+// Accept/disconnect/RX run in the async_tcp task, ring writes in the sender
+// task; clientLock keeps a client from being freed while the sender uses it.
+#define TCP_MAX_CLIENTS             4
+#define TCP_CLIENT_RING_SIZE        8192    // Per-client send ring (PSRAM if available)
+#define TCP_COALESCE_MS_NORMAL      5       // Latency cap for a partial segment
+#define TCP_COALESCE_MS_BULK        20      // Latency cap in bulk mode (fuller segments)
+#define TCP_STALL_DISCONNECT_MS     3000    // Full ring this long -> disconnect (TCP_SLOW_DISCONNECT)
+#define TCP_DEFAULT_MSS             1436
+
+// Slow client handling (device4.tcp_slow_policy)
+enum TcpSlowPolicy : uint8_t {
+    TCP_SLOW_DROP = 0,          // Drop packets for the client while its ring is full
+    TCP_SLOW_DISCONNECT = 1     // Same, and disconnect after TCP_STALL_DISCONNECT_MS
+};
+
+class TcpServerTransport {
+private:
+    struct Client {
+        TcpServerTransport* owner;
+        AsyncClient* client;        // nullptr = free slot
+        uint8_t* ring;              // Allocated on connect, freed on disconnect
+        size_t head;                // Next write (sender task)
+        size_t tail;                // Next byte to send (sender task)
+        size_t used;
+        uint16_t mss;
+        uint32_t oldestMs;          // Oldest unsent byte queued
+        uint32_t stallStartMs;      // Ring full since (0 = not stalled)
+        std::atomic<uint32_t> unacked{0};       // Written, not acked yet (onAck)
+        std::atomic<bool> closeRequested{false};// Closed from the next poll (async_tcp task)
+        uint32_t ip;
+        uint16_t port;
+        uint32_t connectedMs;
+        uint32_t txBytes;
+        uint32_t writes;            // add()+send() calls - txBytes/writes = coalescing
+        uint32_t dropPackets;
+        uint32_t dropBytes;
+        uint32_t rxBytes;           // async_tcp task
+    };
+
+    uint16_t port;
+    uint8_t slowPolicy;
+    AsyncServer* server = nullptr;
+    CircularBuffer* rxBuffer;       // Device4 input (bridge task reads)
+    Client clients[TCP_MAX_CLIENTS];
+    std::atomic<uint8_t> clientCount{0};
+    SemaphoreHandle_t clientLock = nullptr;
+    uint32_t rejectedClients = 0;
+    uint32_t slowDisconnects = 0;
+
+    TcpServerTransport(const TcpServerTransport&) = delete;
+    TcpServerTransport& operator=(const TcpServerTransport&) = delete;
+
+    void handleClient(AsyncClient* client);
+    void handleDisconnect(Client* c, AsyncClient* client);
+    size_t writeRing(Client& c);
+
+public:
+    TcpServerTransport(uint16_t port, CircularBuffer* rxBuffer, uint8_t slowPolicy);
+    ~TcpServerTransport();
+
+    // Start listening (send rings are allocated per connection)
+    bool begin();
+
+    // Stop listening and close clients (WiFi shutdown)
+    void end();
+
+    bool hasClients() const { return clientCount.load(std::memory_order_relaxed) > 0; }
+
+    // Queue a whole packet for every client (sender task). Returns clients that took it,
+    // 0 = lost for all (rings full or lock busy) - the sender counts it as dropped.
+    size_t append(const uint8_t* data, size_t size, uint32_t now);
+
+    // Write rings that are due (sender task, every pass)
+    void flush(uint32_t now, bool bulkMode);
+
+    // Per-client queue, coalescing and drop counters for the Web UI
+    void appendJson(JsonObject obj);
+};
+
+#endif // TCP_SERVER_TRANSPORT_H
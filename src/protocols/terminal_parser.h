@@ -2,23 +2,51 @@
 #define TERMINAL_PARSER_H
 
 #include "protocol_parser.h"
+#include "terminal_triggers.h"
 #include "../logging.h"
 #include "../circular_buffer.h"
 #include <Arduino.h>
 
 // Terminal buffer for WebSocket streaming (allocated once, read by web server)
-// Ring buffer that supports multiple readers (history + live streaming)
+// Ring buffer with one read cursor per WebSocket client: a new client replays
+// history from its own cursor, a slow client never holds back or duplicates
+// data for the others. Readers that fall more than a full ring behind skip
+// ahead and get the exact number of bytes they lost.
 class TerminalBuffer {
+public:
+    static constexpr size_t MAX_READERS = 8;
+
 private:
+    struct Reader {
+        uint32_t clientId;
+        size_t pos;           // Total bytes consumed by this reader (monotonic)
+        size_t overrun;       // Bytes lost since last report
+        uint32_t droppedTotal; // Bytes lost since attach
+        bool active;
+    };
+
     uint8_t* buf;
     size_t capacity;
     size_t writePos;      // Total bytes written (monotonic)
-    size_t wsSentPos;     // Total bytes sent via WebSocket
+    Reader readers[MAX_READERS];
     portMUX_TYPE lock;
     static TerminalBuffer* instance;
 
+    Reader* findReader(uint32_t clientId) {
+        for (size_t i = 0; i < MAX_READERS; i++) {
+            if (readers[i].active && readers[i].clientId == clientId) return &readers[i];
+        }
+        return nullptr;
+    }
+
+    // Oldest byte still in the ring
+    size_t tailPos() const {
+        return (writePos > capacity) ? writePos - capacity : 0;
+    }
+
 public:
-    TerminalBuffer() : buf(nullptr), capacity(0), writePos(0), wsSentPos(0) {
+    TerminalBuffer() : buf(nullptr), capacity(0), writePos(0) {
+        memset(readers, 0, sizeof(readers));
         portMUX_INITIALIZE(&lock);
     }
 
@@ -52,74 +80,128 @@ public:
 
     void write(const uint8_t* data, size_t len) {
         if (!buf || len == 0) return;
+
+        // Skip, copy and publish in one critical section - readers never see
+        // a writePos ahead of the bytes behind it
         portENTER_CRITICAL(&lock);
-        for (size_t i = 0; i < len; i++) {
-            buf[writePos % capacity] = data[i];
-            writePos++;
+
+        // Only the last 'capacity' bytes can survive
+        if (len > capacity) {
+            writePos += len - capacity;
+            data += len - capacity;
+            len = capacity;
         }
-        // If WebSocket reader fell behind (buffer wrapped), catch it up
-        if (writePos > wsSentPos + capacity) {
-            wsSentPos = writePos - capacity;
+
+        size_t head = writePos % capacity;
+        size_t first = capacity - head;
+        if (first > len) first = len;
+        memcpy(buf + head, data, first);
+        if (len > first) {
+            memcpy(buf, data + first, len - first);
         }
+        writePos += len;
         portEXIT_CRITICAL(&lock);
     }
 
-    // Get new data for WebSocket poll (since last read)
-    size_t readNew(uint8_t* dst, size_t maxLen) {
-        if (!buf) return 0;
+    // Register a WebSocket client. With replayHistory the cursor starts at the
+    // oldest buffered byte, otherwise at the live position.
+    bool attachReader(uint32_t clientId, bool replayHistory) {
         portENTER_CRITICAL(&lock);
-        size_t avail = writePos - wsSentPos;
-        if (avail == 0) {
-            portEXIT_CRITICAL(&lock);
-            return 0;
+        Reader* r = findReader(clientId);
+        if (!r) {
+            for (size_t i = 0; i < MAX_READERS; i++) {
+                if (!readers[i].active) { r = &readers[i]; break; }
+            }
         }
-        size_t toRead = min(avail, maxLen);
-        for (size_t i = 0; i < toRead; i++) {
-            dst[i] = buf[(wsSentPos + i) % capacity];
+        if (r) {
+            r->clientId = clientId;
+            r->pos = replayHistory ? tailPos() : writePos;
+            r->overrun = 0;
+            r->droppedTotal = 0;
+            r->active = true;
         }
-        wsSentPos += toRead;
         portEXIT_CRITICAL(&lock);
-        return toRead;
+        return r != nullptr;
     }
 
-    // Get buffered history chunk (for new WebSocket client connect)
-    // offset: byte offset from start of history, returns 0 when done
-    size_t readHistory(uint8_t* dst, size_t maxLen, size_t offset) {
+    void detachReader(uint32_t clientId) {
+        portENTER_CRITICAL(&lock);
+        Reader* r = findReader(clientId);
+        if (r) r->active = false;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    // Read next data for one client (two-segment memcpy).
+    // overrun (optional) receives bytes this client lost since the previous call.
+    size_t readFor(uint32_t clientId, uint8_t* dst, size_t maxLen, size_t* overrun = nullptr) {
+        if (overrun) *overrun = 0;
         if (!buf) return 0;
+
         portENTER_CRITICAL(&lock);
-        size_t totalInBuf = min(writePos, capacity);
-        if (offset >= totalInBuf) {
+        Reader* r = findReader(clientId);
+        if (!r) {
             portEXIT_CRITICAL(&lock);
             return 0;
         }
-        size_t remaining = totalInBuf - offset;
-        size_t toRead = min(remaining, maxLen);
-        size_t startPos = writePos - totalInBuf + offset;
-        for (size_t i = 0; i < toRead; i++) {
-            dst[i] = buf[(startPos + i) % capacity];
+
+        // Lagging reader: skip to the oldest byte still buffered
+        size_t tail = tailPos();
+        if (r->pos < tail) {
+            r->overrun += tail - r->pos;
+            r->droppedTotal += tail - r->pos;
+            r->pos = tail;
+        }
+        if (overrun) {
+            *overrun = r->overrun;
+            r->overrun = 0;
+        }
+
+        size_t avail = writePos - r->pos;
+        size_t toRead = (avail < maxLen) ? avail : maxLen;
+        if (toRead > 0) {
+            size_t start = r->pos % capacity;
+            size_t first = capacity - start;
+            if (first > toRead) first = toRead;
+            memcpy(dst, buf + start, first);
+            if (toRead > first) {
+                memcpy(dst + first, buf, toRead - first);
+            }
+            r->pos += toRead;
         }
         portEXIT_CRITICAL(&lock);
         return toRead;
     }
 
-    // Reset WebSocket reader to current position (after sending history)
-    void resetWsReader() {
+    // Bytes pending for one client (including data it already lost)
+    size_t availableFor(uint32_t clientId) {
         portENTER_CRITICAL(&lock);
-        wsSentPos = writePos;
+        Reader* r = findReader(clientId);
+        size_t avail = r ? writePos - r->pos : 0;
         portEXIT_CRITICAL(&lock);
+        return avail;
+    }
+
+    // Bytes lost so far by one client (overruns)
+    uint32_t droppedFor(uint32_t clientId) {
+        portENTER_CRITICAL(&lock);
+        Reader* r = findReader(clientId);
+        uint32_t dropped = r ? r->droppedTotal : 0;
+        portEXIT_CRITICAL(&lock);
+        return dropped;
     }
 
     // Drop all buffered history; new clients won't replay anything
     void clear() {
         portENTER_CRITICAL(&lock);
         writePos = 0;
-        wsSentPos = 0;
+        for (size_t i = 0; i < MAX_READERS; i++) {
+            readers[i].pos = 0;
+            readers[i].overrun = 0;
+        }
         portEXIT_CRITICAL(&lock);
     }
 
-    size_t available() const {
-        return writePos - wsSentPos;
-    }
+    size_t getCapacity() const { return capacity; }
 };
 
 // Terminal parser: line-based with timeout fallback + tap to terminal buffer
@@ -131,10 +213,11 @@ private:
     static constexpr size_t MAX_CHUNK = 512;
 
     TerminalBuffer* termBuf;
+    TerminalTriggers* triggers;   // Console trigger matcher (UART1 flow only)
     uint32_t bufferStartTime;
 
 public:
-    TerminalParser() : bufferStartTime(0) {
+    TerminalParser() : triggers(nullptr), bufferStartTime(0) {
         termBuf = TerminalBuffer::getInstance();
         termBuf->init();
         log_msg(LOG_INFO, "TerminalParser initialized");
@@ -189,6 +272,9 @@ public:
 
         // Tap: copy to terminal buffer for WebSocket streaming
         termBuf->write(result.packets[0].data, chunkLen);
+        if (triggers) {
+            triggers->scan(result.packets[0].data, chunkLen);
+        }
 
         result.bytesConsumed = chunkLen;
         bufferStartTime = 0;
@@ -201,6 +287,9 @@ public:
         return result;
     }
 
+    // Scan this flow's output for trigger patterns
+    void setTriggers(TerminalTriggers* t) { triggers = t; }
+
     void reset() override {
         bufferStartTime = 0;
         if (stats) {
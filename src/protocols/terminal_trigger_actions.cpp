@@ -0,0 +1,66 @@
+// Trigger actions (scheduler side) - kept apart from the matcher in
+// terminal_triggers.cpp so the automaton builds without the network stack
+#include "terminal_triggers.h"
+#include "protocol_pipeline.h"
+#include "udp_sender.h"
+#include "../logging.h"
+#include "../leds.h"
+#include "../device_types.h"
+#include "../wifi/wifi_manager.h"
+
+extern Config config;
+extern ProtocolPipeline* getProtocolPipeline();
+
+void TerminalTriggers::fire(const Trigger& t) {
+    if (t.actions & TRIGGER_ACTION_LOG) {
+        log_msg(LOG_WARNING, "Terminal trigger: %s", t.pattern);
+    }
+
+    if (t.actions & TRIGGER_ACTION_LED) {
+        led_trigger_flash(t.ledColor);
+    }
+
+    // UDP: Device4 targets (Network Bridge or Logger role)
+    if ((t.actions & TRIGGER_ACTION_UDP) &&
+        (config.device4.role == D4_NETWORK_BRIDGE || config.device4.role == D4_LOG_NETWORK) &&
+        wifiIsReady()) {
+        ProtocolPipeline* pipeline = getProtocolPipeline();
+        PacketSender* sender = pipeline ? pipeline->getSender(IDX_DEVICE4) : nullptr;
+        if (sender) {
+            char msg[TERMINAL_TRIGGER_PATTERN_LEN + 10];
+            int len = snprintf(msg, sizeof(msg), "TRIGGER %s\n", t.pattern);
+            if (UdpSender* udpSender = pipeline->getUdpSender()) {
+                udpSender->sendNotification(reinterpret_cast<const uint8_t*>(msg), len);
+            } else {
+                // TCP: into the client rings, written with the next flush
+                sender->sendDirect(reinterpret_cast<const uint8_t*>(msg), len);
+            }
+        }
+    }
+}
+
+void TerminalTriggers::dispatch() {
+    // Copy fired triggers under buildLock, run the actions outside it so a
+    // rebuild on the bridge task never waits for LED or UDP
+    Trigger fired[TERMINAL_TRIGGER_MAX];
+    size_t count = 0;
+
+    xSemaphoreTake(buildLock, portMAX_DELAY);
+    portENTER_CRITICAL(&pendingMux);
+    uint16_t mask = pendingMask;
+    pendingMask = 0;
+    portEXIT_CRITICAL(&pendingMux);
+
+    for (uint8_t i = 0; mask && i < triggerCount; i++) {
+        if (mask & (1u << i)) {
+            mask &= ~(1u << i);
+            triggers[i].hits++;
+            fired[count++] = triggers[i];
+        }
+    }
+    xSemaphoreGive(buildLock);
+
+    for (size_t i = 0; i < count; i++) {
+        fire(fired[i]);
+    }
+}
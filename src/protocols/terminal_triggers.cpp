@@ -0,0 +1,224 @@
+#include "terminal_triggers.h"
+#include "../logging.h"
+#include "../leds.h"
+
+// Static instance initialization
+TerminalTriggers* TerminalTriggers::instance = nullptr;
+
+// Transition placeholder while building the trie
+static constexpr uint8_t STATE_NONE = 0xFF;
+
+// LED action colors
+static const struct {
+    const char* name;
+    uint32_t color;
+} TRIGGER_COLORS[] = {
+    {"red",     COLOR_RED},
+    {"green",   0x00FF00},
+    {"blue",    0x0000FF},
+    {"yellow",  COLOR_YELLOW},
+    {"cyan",    0x00FFFF},
+    {"magenta", COLOR_MAGENTA},
+    {"orange",  COLOR_ORANGE},
+    {"white",   0xFFFFFF},
+};
+
+static char* trim(char* s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char* end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) end--;
+    *end = '\0';
+    return s;
+}
+
+TerminalTriggers::TerminalTriggers() {
+    memset(triggers, 0, sizeof(triggers));
+    memset(byteClass, 0, sizeof(byteClass));
+    buildLock = xSemaphoreCreateMutex();
+}
+
+void TerminalTriggers::freeAutomaton() {
+    delete[] delta;
+    delete[] output;
+    delta = nullptr;
+    output = nullptr;
+    stateCount = 0;
+    state = 0;
+}
+
+// Parse "<pattern> | <actions>" into next trigger slot
+bool TerminalTriggers::addTrigger(char* line) {
+    char* actions = nullptr;
+    char* bar = strrchr(line, '|');
+    if (bar) {
+        *bar = '\0';
+        actions = bar + 1;
+    }
+
+    char* pattern = trim(line);
+    size_t len = strlen(pattern);
+    if (len == 0) return false;
+
+    if (triggerCount >= TERMINAL_TRIGGER_MAX) {
+        log_msg(LOG_WARNING, "Terminal trigger '%s' ignored: max %d triggers", pattern, TERMINAL_TRIGGER_MAX);
+        return false;
+    }
+    if (len >= TERMINAL_TRIGGER_PATTERN_LEN) {
+        log_msg(LOG_WARNING, "Terminal trigger '%s' ignored: pattern longer than %d", pattern,
+                TERMINAL_TRIGGER_PATTERN_LEN - 1);
+        return false;
+    }
+    // Worst case every pattern byte is a new state (plus root)
+    if (patternBytes + len + 1 > TERMINAL_TRIGGER_MAX_STATES) {
+        log_msg(LOG_WARNING, "Terminal trigger '%s' ignored: pattern table full", pattern);
+        return false;
+    }
+
+    // Alphabet: count bytes not seen in earlier patterns
+    size_t newClasses = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = (uint8_t)pattern[i];
+        if (byteClass[b] == 0 && memchr(pattern, b, i) == nullptr) newClasses++;
+    }
+    if (classCount + newClasses > TERMINAL_TRIGGER_MAX_CLASSES) {
+        log_msg(LOG_WARNING, "Terminal trigger '%s' ignored: too many distinct characters", pattern);
+        return false;
+    }
+
+    Trigger& t = triggers[triggerCount];
+    memset(&t, 0, sizeof(t));
+    memcpy(t.pattern, pattern, len + 1);
+    t.ledColor = COLOR_RED;
+
+    // Actions (default: log)
+    if (actions) {
+        char* save = nullptr;
+        for (char* tok = strtok_r(actions, ",", &save); tok; tok = strtok_r(nullptr, ",", &save)) {
+            tok = trim(tok);
+            if (strcmp(tok, "log") == 0) {
+                t.actions |= TRIGGER_ACTION_LOG;
+            } else if (strcmp(tok, "udp") == 0) {
+                t.actions |= TRIGGER_ACTION_UDP;
+            } else if (strncmp(tok, "led", 3) == 0 && (tok[3] == '\0' || tok[3] == ':')) {
+                t.actions |= TRIGGER_ACTION_LED;
+                if (tok[3] == ':') {
+                    bool known = false;
+                    for (const auto& c : TRIGGER_COLORS) {
+                        if (strcmp(tok + 4, c.name) == 0) {
+                            t.ledColor = c.color;
+                            known = true;
+                            break;
+                        }
+                    }
+                    if (!known) {
+                        log_msg(LOG_WARNING, "Terminal trigger '%s': unknown color '%s'", pattern, tok + 4);
+                    }
+                }
+            } else if (*tok) {
+                log_msg(LOG_WARNING, "Terminal trigger '%s': unknown action '%s'", pattern, tok);
+            }
+        }
+    }
+    if (t.actions == 0) t.actions = TRIGGER_ACTION_LOG;
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = (uint8_t)pattern[i];
+        if (byteClass[b] == 0) byteClass[b] = classCount++;
+    }
+    patternBytes += len;
+    triggerCount++;
+    return true;
+}
+
+// Trie + failure links, flattened into a full transition table (DFA)
+void TerminalTriggers::buildAutomaton() {
+    size_t maxStates = patternBytes + 1;
+    delta = new uint8_t[maxStates * classCount];
+    output = new uint16_t[maxStates];
+    memset(delta, STATE_NONE, maxStates * classCount);
+    memset(output, 0, maxStates * sizeof(uint16_t));
+
+    // Trie
+    stateCount = 1;
+    for (uint8_t t = 0; t < triggerCount; t++) {
+        uint8_t s = 0;
+        for (const char* p = triggers[t].pattern; *p; p++) {
+            uint8_t* next = &delta[(size_t)s * classCount + byteClass[(uint8_t)*p]];
+            if (*next == STATE_NONE) *next = stateCount++;
+            s = *next;
+        }
+        output[s] |= (1u << t);
+    }
+
+    // Breadth-first: failure links and missing transitions. A state's failure target
+    // is shallower, so its row is already complete when the state is processed.
+    uint8_t fail[TERMINAL_TRIGGER_MAX_STATES];
+    uint8_t queue[TERMINAL_TRIGGER_MAX_STATES];
+    size_t head = 0, tail = 0;
+
+    for (uint8_t c = 0; c < classCount; c++) {
+        uint8_t u = delta[c];
+        if (u == STATE_NONE) {
+            delta[c] = 0;
+        } else {
+            fail[u] = 0;
+            queue[tail++] = u;
+        }
+    }
+
+    while (head < tail) {
+        uint8_t r = queue[head++];
+        output[r] |= output[fail[r]];
+
+        uint8_t* row = &delta[(size_t)r * classCount];
+        const uint8_t* failRow = &delta[(size_t)fail[r] * classCount];
+        for (uint8_t c = 0; c < classCount; c++) {
+            if (row[c] == STATE_NONE) {
+                row[c] = failRow[c];
+            } else {
+                fail[row[c]] = failRow[c];
+                queue[tail++] = row[c];
+            }
+        }
+    }
+}
+
+size_t TerminalTriggers::build(const char* spec) {
+    char buffer[TERMINAL_TRIGGER_SPEC_MAX + 1];
+    buffer[0] = '\0';
+    if (spec) {
+        strncpy(buffer, spec, sizeof(buffer) - 1);
+        buffer[sizeof(buffer) - 1] = '\0';
+    }
+
+    xSemaphoreTake(buildLock, portMAX_DELAY);
+
+    // Match bits of the old set would fire whatever trigger gets their index now
+    portENTER_CRITICAL(&pendingMux);
+    pendingMask = 0;
+    portEXIT_CRITICAL(&pendingMux);
+
+    freeAutomaton();
+    memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;   // Class 0 = byte not in any pattern
+    triggerCount = 0;
+    patternBytes = 0;
+
+    char* save = nullptr;
+    for (char* line = strtok_r(buffer, "\n", &save); line; line = strtok_r(nullptr, "\n", &save)) {
+        line = trim(line);
+        if (*line == '\0' || *line == '#') continue;
+        addTrigger(line);
+    }
+
+    if (triggerCount > 0) {
+        buildAutomaton();
+    }
+    xSemaphoreGive(buildLock);
+
+    if (triggerCount > 0) {
+        log_msg(LOG_INFO, "Terminal triggers: %u patterns, %u states, %u classes",
+                triggerCount, stateCount, classCount);
+    }
+    return triggerCount;
+}
@@ -0,0 +1,129 @@
+// Terminal trigger actions
+// Watches the UART1 console stream (Terminal protocol) for configured strings such as
+// "ARMED", "Error" or "PreArm:" and fires actions: LED flash, log line, UDP notification.
+//
+// Matching: Aho-Corasick automaton built once at pipeline init. Bytes are mapped to a
+// compact alphabet (bytes used by any pattern + one "other" class) and the goto/failure
+// function is flattened into a full transition table, so scan() costs one table lookup
+// per byte no matter how many patterns are configured. The automaton state survives
+// between chunks - a pattern split across two UART reads still matches.
+//
+// scan() runs on the bridge task and only records matches (bitmask). Actions run from
+// the scheduler via dispatch(), so the LED mutex, logging and UDP never stall the data
+// path. Each trigger fires at most once per dispatch interval. build() may run again on
+// the bridge task (live config); buildLock keeps dispatch() off a half-built trigger set.
+//
+// Config syntax (config.terminalTriggers, one trigger per line, '#' starts a comment):
+//   <pattern> | <action>[,<action>...]
+//   actions: log, udp, led[:color]
+//   colors:  red, green, blue, yellow, cyan, magenta, orange, white (default: red)
+//   e.g.     PreArm: | log,led:yellow
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/semphr.h>
+
+#define TERMINAL_TRIGGER_MAX            16   // Triggers (one bit each in match mask)
+#define TERMINAL_TRIGGER_PATTERN_LEN    32   // Pattern length including terminator
+#define TERMINAL_TRIGGER_MAX_STATES     255  // Automaton states (uint8_t, 0xFF reserved during build)
+#define TERMINAL_TRIGGER_MAX_CLASSES    64   // Distinct pattern bytes + "other"
+#define TERMINAL_TRIGGER_SPEC_MAX       512  // Config text length
+
+// Action bits
+#define TRIGGER_ACTION_LOG  0x01
+#define TRIGGER_ACTION_LED  0x02
+#define TRIGGER_ACTION_UDP  0x04
+
+class TerminalTriggers {
+private:
+    struct Trigger {
+        char pattern[TERMINAL_TRIGGER_PATTERN_LEN];
+        uint8_t actions;
+        uint32_t ledColor;
+        uint32_t hits;
+    };
+
+    Trigger triggers[TERMINAL_TRIGGER_MAX];
+    uint8_t triggerCount = 0;
+
+    // Automaton
+    uint8_t byteClass[256];          // Byte -> alphabet class (0 = not in any pattern)
+    uint8_t classCount = 0;
+    uint8_t stateCount = 0;
+    uint8_t* delta = nullptr;        // [state * classCount + class] -> next state
+    uint16_t* output = nullptr;      // [state] -> triggers matched when entering state
+    uint8_t state = 0;               // Current state, persists across chunks
+    size_t patternBytes = 0;         // Sum of pattern lengths (state bound)
+
+    // build() vs dispatch(): triggers[] and match bits belong to one trigger set
+    SemaphoreHandle_t buildLock = nullptr;
+
+    // Matches recorded by scan(), consumed by dispatch()
+    portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+    uint16_t pendingMask = 0;
+
+    // Statistics
+    uint32_t bytesScanned = 0;
+    uint32_t matches = 0;
+
+    static TerminalTriggers* instance;
+    TerminalTriggers();
+
+    TerminalTriggers(const TerminalTriggers&) = delete;
+    TerminalTriggers& operator=(const TerminalTriggers&) = delete;
+
+    bool addTrigger(char* line);
+    void buildAutomaton();
+    void freeAutomaton();
+    void fire(const Trigger& t);
+
+public:
+    static TerminalTriggers* getInstance() {
+        if (!instance) {
+            instance = new TerminalTriggers();
+        }
+        return instance;
+    }
+
+    // Parse config text and build the automaton (bridge task). Returns number of active triggers.
+    size_t build(const char* spec);
+
+    // Feed console bytes (bridge task)
+    void scan(const uint8_t* data, size_t len) {
+        if (!delta) return;
+
+        const uint8_t* table = delta;
+        const uint8_t cls = classCount;
+        uint8_t s = state;
+        uint16_t hit = 0;
+        uint32_t found = 0;
+
+        for (size_t i = 0; i < len; i++) {
+            s = table[(size_t)s * cls + byteClass[data[i]]];
+            if (output[s]) {
+                hit |= output[s];
+                found++;
+            }
+        }
+
+        state = s;
+        bytesScanned += len;
+        if (hit) {
+            matches += found;
+            portENTER_CRITICAL(&pendingMux);
+            pendingMask |= hit;
+            portEXIT_CRITICAL(&pendingMux);
+        }
+    }
+
+    // Run actions for recorded matches (scheduler)
+    void dispatch();
+
+    bool isActive() const { return delta != nullptr; }
+    size_t getTriggerCount() const { return triggerCount; }
+    size_t getStateCount() const { return stateCount; }
+    uint32_t getBytesScanned() const { return bytesScanned; }
+    uint32_t getMatches() const { return matches; }
+    const char* getPattern(size_t i) const { return (i < triggerCount) ? triggers[i].pattern : ""; }
+    uint32_t getHits(size_t i) const { return (i < triggerCount) ? triggers[i].hits : 0; }
+};
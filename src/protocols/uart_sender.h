@@ -40,6 +40,12 @@ public:
         return uartInterface->write(sendData, sendSize);
     }
 
+    size_t getDirectWriteSpace() override {
+        if (!uartInterface) return 0;
+        int space = uartInterface->availableForWrite();
+        return (space > 0) ? (size_t)space : 0;
+    }
+
     void processSendQueue(bool bulkMode = false) override {
         // UART sender may ignore bulkMode parameter
         uint32_t now = micros();
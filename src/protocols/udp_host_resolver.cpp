@@ -0,0 +1,198 @@
+#include "udp_host_resolver.h"
+#include "../logging.h"
+#include "../wifi/wifi_manager.h"
+#include "lwip/dns.h"
+#include "lwip/tcpip.h"
+
+UdpHostResolver* UdpHostResolver::instance = nullptr;
+
+static uint32_t requestGen(void* ctx) { return (uint32_t)(uintptr_t)ctx >> 8; }
+static size_t requestIdx(void* ctx) { return (uintptr_t)ctx & 0xFF; }
+
+// lwIP dns_found_callback (tcpip thread), ipaddr NULL on failure
+static void dnsFound(const char* name, const ip_addr_t* ipaddr, void* ctx) {
+    uint32_t ip = 0;
+    if (ipaddr && IP_IS_V4(ipaddr)) {
+        ip = ip_2_ip4(ipaddr)->addr;
+    }
+    UdpHostResolver::getInstance()->complete(ctx, ip);
+}
+
+bool UdpHostResolver::isHostname(const char* s) {
+    size_t len = strlen(s);
+    if (len == 0 || len >= UDP_HOST_NAME_LEN) return false;
+
+    bool letter = false;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        if (isalpha((unsigned char)c)) {
+            letter = true;
+        } else if (!isdigit((unsigned char)c) && c != '-' && c != '.') {
+            return false;
+        }
+    }
+    return letter;
+}
+
+void UdpHostResolver::setHosts(const char* const* names, size_t count) {
+    if (count > UDP_HOST_MAX) count = UDP_HOST_MAX;
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&mux);
+    bool same = count == this->count();
+    for (size_t i = 0; same && i < count; i++) {
+        same = strncmp(hosts[i].name, names[i], UDP_HOST_NAME_LEN - 1) == 0;
+    }
+    if (same) {
+        // Targets reloaded without hostname changes - keep addresses and pending lookups
+        portEXIT_CRITICAL(&mux);
+        return;
+    }
+
+    listGen++;
+    hostCount.store(0, std::memory_order_release);
+    for (size_t i = 0; i < count; i++) {
+        Host& h = hosts[i];
+        if (strncmp(h.name, names[i], UDP_HOST_NAME_LEN - 1) == 0 && h.ip.load(std::memory_order_relaxed)) {
+            // Same host in the same slot: keep sending to the last good address until refreshed
+            h.pending = false;
+            h.nextMs = now;
+            continue;
+        }
+        strncpy(h.name, names[i], UDP_HOST_NAME_LEN - 1);
+        h.name[UDP_HOST_NAME_LEN - 1] = '\0';
+        h.ip.store(0, std::memory_order_relaxed);
+        h.resolvedMs = 0;
+        h.nextMs = now;         // Resolve on the next tick
+        h.requestMs = 0;
+        h.pending = false;
+        h.event = HOST_EVENT_NONE;
+        h.lookups = 0;
+        h.failures = 0;
+        h.changes = 0;
+    }
+    hostCount.store(count, std::memory_order_release);
+    portEXIT_CRITICAL(&mux);
+}
+
+// tcpip thread: start the lookup, answer from the lwIP cache completes at once
+void UdpHostResolver::lookupInTcpip(void* ctx) {
+    UdpHostResolver* self = getInstance();
+    char name[UDP_HOST_NAME_LEN];
+    size_t idx = requestIdx(ctx);
+
+    portENTER_CRITICAL(&self->mux);
+    bool current = requestGen(ctx) == (self->listGen & 0xFFFFFF) && idx < self->count();
+    if (current) {
+        memcpy(name, self->hosts[idx].name, sizeof(name));
+    }
+    portEXIT_CRITICAL(&self->mux);
+    if (!current) return;
+
+    ip_addr_t addr;
+    err_t err = dns_gethostbyname_addrtype(name, &addr, dnsFound, ctx, LWIP_DNS_ADDRTYPE_IPV4);
+    if (err == ERR_OK) {
+        dnsFound(name, &addr, ctx);
+    } else if (err != ERR_INPROGRESS) {
+        self->complete(ctx, 0);
+    }
+}
+
+void UdpHostResolver::complete(void* ctx, uint32_t ip) {
+    size_t idx = requestIdx(ctx);
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&mux);
+    if (requestGen(ctx) == (listGen & 0xFFFFFF) && idx < count()) {
+        Host& h = hosts[idx];
+        if (ip) {
+            // Late answers after a timeout are still good addresses
+            uint32_t old = h.ip.load(std::memory_order_relaxed);
+            if (old != ip) {
+                h.ip.store(ip, std::memory_order_relaxed);
+                if (old) h.changes++;
+                h.event = old ? HOST_EVENT_CHANGED : HOST_EVENT_RESOLVED;
+            }
+            h.resolvedMs = now;
+            h.nextMs = now + UDP_HOST_TTL_MS;
+            h.pending = false;
+        } else if (h.pending) {
+            h.failures++;
+            h.event = HOST_EVENT_FAILED;
+            h.nextMs = now + UDP_HOST_RETRY_MS;
+            h.pending = false;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+}
+
+void UdpHostResolver::tick(uint32_t now) {
+    size_t n = count();
+    if (n == 0) return;
+    bool ready = wifiIsReady();
+
+    for (size_t i = 0; i < n; i++) {
+        Host& h = hosts[i];
+        bool start = false;
+        HostEvent event;
+        void* ctx;
+
+        portENTER_CRITICAL(&mux);
+        if (h.pending && (now - h.requestMs) >= UDP_HOST_TIMEOUT_MS) {
+            h.pending = false;
+            h.failures++;
+            h.event = HOST_EVENT_FAILED;
+            h.nextMs = now + UDP_HOST_RETRY_MS;
+        }
+        if (!h.pending && (int32_t)(now - h.nextMs) >= 0 && ready) {
+            h.pending = true;
+            h.requestMs = now;
+            h.lookups++;
+            start = true;
+        }
+        event = h.event;
+        h.event = HOST_EVENT_NONE;
+        ctx = packRequest(listGen & 0xFFFFFF, i);
+        portEXIT_CRITICAL(&mux);
+
+        if (event == HOST_EVENT_RESOLVED || event == HOST_EVENT_CHANGED) {
+            log_msg(LOG_INFO, "UDP target %s %s %s", h.name,
+                    event == HOST_EVENT_CHANGED ? "moved to" : "resolved to",
+                    IPAddress(h.ip.load(std::memory_order_relaxed)).toString().c_str());
+        } else if (event == HOST_EVENT_FAILED) {
+            uint32_t ip = h.ip.load(std::memory_order_relaxed);
+            log_msg(LOG_WARNING, "UDP target %s: lookup failed, %s", h.name,
+                    ip ? "keeping last address" : "not sending");
+        }
+
+        if (start && tcpip_try_callback(lookupInTcpip, ctx) != ERR_OK) {
+            // tcpip mailbox full - try again later
+            portENTER_CRITICAL(&mux);
+            h.pending = false;
+            h.nextMs = now + UDP_HOST_RETRY_MS;
+            portEXIT_CRITICAL(&mux);
+        }
+    }
+}
+
+void UdpHostResolver::appendJson(JsonArray arr) {
+    uint32_t now = millis();
+    size_t n = count();
+
+    for (size_t i = 0; i < n; i++) {
+        const Host& h = hosts[i];
+        JsonObject o = arr.add<JsonObject>();
+        uint32_t ip = h.ip.load(std::memory_order_relaxed);
+        o["host"] = h.name;
+        if (ip) {
+            o["ip"] = IPAddress(ip).toString();
+            o["ageS"] = (now - h.resolvedMs) / 1000;
+        } else {
+            o["ip"] = nullptr;
+        }
+        o["pending"] = h.pending;
+        o["lookups"] = h.lookups;
+        o["failures"] = h.failures;
+        o["changes"] = h.changes;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef UDP_HOST_RESOLVER_H
+#define UDP_HOST_RESOLVER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <stdint.h>
+
+// Hostname targets for Device4 UDP output (device4.target_ip may mix IPs and names).
+// Lookups go through the lwIP DNS client asynchronously: tick() (scheduler) posts
+// the request to the tcpip thread and the answer lands in an atomic, so the sender
+// only ever reads the last good address - it never waits for DNS. A failed or
+// timed out refresh keeps the previous address and is retried.
+#define UDP_HOST_MAX            4       // Same as UdpSender::MAX_UDP_TARGETS
+#define UDP_HOST_NAME_LEN       64
+#define UDP_HOST_TTL_MS         60000   // Refresh interval of a good address
+#define UDP_HOST_RETRY_MS       5000    // Retry interval after a failure
+#define UDP_HOST_TIMEOUT_MS     10000   // Lookup without answer counts as failed
+
+class UdpHostResolver {
+private:
+    enum HostEvent : uint8_t {
+        HOST_EVENT_NONE = 0,
+        HOST_EVENT_RESOLVED,
+        HOST_EVENT_CHANGED,
+        HOST_EVENT_FAILED,
+    };
+
+    struct Host {
+        char name[UDP_HOST_NAME_LEN];
+        std::atomic<uint32_t> ip{0};    // Last good IPv4 (0 = never resolved)
+        uint32_t resolvedMs;            // Last successful lookup
+        uint32_t nextMs;                // Next lookup due
+        uint32_t requestMs;             // Pending lookup started
+        bool pending;
+        HostEvent event;                // Logged by tick() - lookups finish in the tcpip thread
+        uint32_t lookups;
+        uint32_t failures;
+        uint32_t changes;
+    };
+
+    Host hosts[UDP_HOST_MAX];
+    std::atomic<uint8_t> hostCount{0};
+    uint32_t listGen = 0;           // Bumped by setHosts(), late answers for an old list are dropped
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    static UdpHostResolver* instance;
+    UdpHostResolver() = default;
+
+    UdpHostResolver(const UdpHostResolver&) = delete;
+    UdpHostResolver& operator=(const UdpHostResolver&) = delete;
+
+    // Request context: list generation and host index packed into the callback arg
+    static void* packRequest(uint32_t gen, size_t idx) {
+        return reinterpret_cast<void*>((uintptr_t)((gen << 8) | (idx & 0xFF)));
+    }
+
+    static void lookupInTcpip(void* ctx);
+
+public:
+    static UdpHostResolver* getInstance() {
+        if (!instance) {
+            instance = new UdpHostResolver();
+        }
+        return instance;
+    }
+
+    // Replace the hostname list (UdpSender::parseTargetIPs). Addresses start unresolved.
+    void setHosts(const char* const* names, size_t count);
+
+    // Sender task, lock-free
+    size_t count() const { return hostCount.load(std::memory_order_acquire); }
+    uint32_t address(size_t idx) const { return hosts[idx].ip.load(std::memory_order_relaxed); }
+
+    // Start due lookups, expire lookups without answer (scheduler, about once per second)
+    void tick(uint32_t now);
+
+    // Hostnames with address and lookup counters for the Web UI
+    void appendJson(JsonArray arr);
+
+    // Lookup finished (tcpip thread), ip 0 = failed
+    void complete(void* ctx, uint32_t ip);
+
+    // Accepted as a hostname target: letters, digits, '-' and '.', at least one letter
+    static bool isHostname(const char* s);
+};
+
+#endif // UDP_HOST_RESOLVER_H
@@ -0,0 +1,140 @@
+#include "udp_peer_table.h"
+#include "../logging.h"
+
+bool UdpPeerTable::enabled = false;
+UdpPeerTable* UdpPeerTable::instance = nullptr;
+
+UdpPeerTable::UdpPeerTable() {
+    memset(peers, 0, sizeof(peers));
+    memset(index, INDEX_EMPTY, sizeof(index));
+    for (size_t i = 0; i < UDP_PEER_MAX; i++) {
+        txPackets[i].store(0, std::memory_order_relaxed);
+        txBytes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+int UdpPeerTable::findSlot(uint32_t ip, uint16_t port) const {
+    size_t h = hashEndpoint(ip, port);
+    for (size_t probe = 0; probe < INDEX_SIZE; probe++) {
+        uint8_t slot = index[(h + probe) % INDEX_SIZE];
+        if (slot == INDEX_EMPTY) return -1;
+        if (peers[slot].ip == ip && peers[slot].port == port) return slot;
+    }
+    return -1;
+}
+
+// Removal leaves probe chains broken - rebuilding 8 entries is cheaper than tombstones
+void UdpPeerTable::rebuildIndex() {
+    memset(index, INDEX_EMPTY, sizeof(index));
+    for (uint8_t slot = 0; slot < UDP_PEER_MAX; slot++) {
+        if (!peers[slot].ip) continue;
+        size_t h = hashEndpoint(peers[slot].ip, peers[slot].port);
+        while (index[h] != INDEX_EMPTY) h = (h + 1) % INDEX_SIZE;
+        index[h] = slot;
+    }
+}
+
+size_t UdpPeerTable::expireLocked(uint32_t now) {
+    size_t removed = 0;
+    for (uint8_t slot = 0; slot < UDP_PEER_MAX; slot++) {
+        if (peers[slot].ip && (now - peers[slot].lastSeenMs) > UDP_PEER_TTL_MS) {
+            peers[slot].ip = 0;
+            removed++;
+        }
+    }
+    if (removed) {
+        count -= removed;
+        rebuildIndex();
+        gen.fetch_add(1, std::memory_order_release);
+    }
+    return removed;
+}
+
+void UdpPeerTable::learn(uint32_t ip, uint16_t port, size_t bytes) {
+    if (!ip) return;
+    uint32_t now = millis();
+    bool added = false;
+
+    portENTER_CRITICAL(&mux);
+    int slot = findSlot(ip, port);
+    if (slot < 0) {
+        if (count >= UDP_PEER_MAX) {
+            expireLocked(now);
+        }
+        if (count < UDP_PEER_MAX) {
+            for (uint8_t s = 0; s < UDP_PEER_MAX; s++) {
+                if (peers[s].ip) continue;
+                memset(&peers[s], 0, sizeof(UdpPeer));
+                peers[s].ip = ip;
+                peers[s].port = port;
+                peers[s].firstSeenMs = now;
+                txPackets[s].store(0, std::memory_order_relaxed);
+                txBytes[s].store(0, std::memory_order_relaxed);
+                count++;
+                rebuildIndex();
+                gen.fetch_add(1, std::memory_order_release);
+                slot = s;
+                added = true;
+                break;
+            }
+        } else {
+            rejected++;
+        }
+    }
+    if (slot >= 0) {
+        peers[slot].lastSeenMs = now;
+        peers[slot].rxPackets++;
+        peers[slot].rxBytes += bytes;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    if (added) {
+        log_msg(LOG_INFO, "UDP peer learned: %s:%u", IPAddress(ip).toString().c_str(), port);
+    }
+}
+
+size_t UdpPeerTable::copyEndpoints(UdpPeerEndpoint* out, size_t maxCount) {
+    size_t n = 0;
+    portENTER_CRITICAL(&mux);
+    for (uint8_t slot = 0; slot < UDP_PEER_MAX && n < maxCount; slot++) {
+        if (!peers[slot].ip) continue;
+        out[n].ip = peers[slot].ip;
+        out[n].port = peers[slot].port;
+        out[n].slot = slot;
+        n++;
+    }
+    portEXIT_CRITICAL(&mux);
+    return n;
+}
+
+void UdpPeerTable::expire(uint32_t now) {
+    portENTER_CRITICAL(&mux);
+    size_t removed = expireLocked(now);
+    portEXIT_CRITICAL(&mux);
+
+    if (removed) {
+        log_msg(LOG_INFO, "UDP peers expired: %zu (%zu left)", removed, count);
+    }
+}
+
+void UdpPeerTable::appendJson(JsonArray arr) {
+    UdpPeer copy[UDP_PEER_MAX];
+    portENTER_CRITICAL(&mux);
+    memcpy(copy, peers, sizeof(copy));
+    portEXIT_CRITICAL(&mux);
+
+    uint32_t now = millis();
+    for (size_t slot = 0; slot < UDP_PEER_MAX; slot++) {
+        const UdpPeer& p = copy[slot];
+        if (!p.ip) continue;
+        JsonObject o = arr.add<JsonObject>();
+        o["ip"] = IPAddress(p.ip).toString();
+        o["port"] = p.port;
+        o["idleMs"] = now - p.lastSeenMs;
+        o["ageS"] = (now - p.firstSeenMs) / 1000;
+        o["rxPackets"] = p.rxPackets;
+        o["rxBytes"] = p.rxBytes;
+        o["txPackets"] = txPackets[slot].load(std::memory_order_relaxed);
+        o["txBytes"] = txBytes[slot].load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef UDP_PEER_TABLE_H
+#define UDP_PEER_TABLE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <stdint.h>
+
+// Device4 reply-path learning: endpoints (ip:port) that send us datagrams are
+// remembered for UDP_PEER_TTL_MS and receive the output next to the configured
+// targets. learn() runs in the AsyncUDP task, expire() in the sender task, and
+// recordTx() on every task that sends UDP datagrams (tx counters are atomic).
+//
+// The sender keeps its own copy of the endpoint list and re-copies it only when
+// generation() changes (peer added or removed), so the send loop costs one
+// atomic load per datagram.
+#define UDP_PEER_MAX        8       // Learned peers kept at once
+#define UDP_PEER_TTL_MS     30000   // Peer dropped after this long without a datagram
+
+struct UdpPeer {
+    uint32_t ip;            // IPv4 as IPAddress stores it (0 = free slot)
+    uint16_t port;
+    uint32_t firstSeenMs;
+    uint32_t lastSeenMs;
+    uint32_t rxPackets;     // Written by learn()
+    uint32_t rxBytes;
+};
+
+// Endpoint as copied by the sender (slot for recordTx)
+struct UdpPeerEndpoint {
+    uint32_t ip;
+    uint16_t port;
+    uint8_t slot;
+};
+
+class UdpPeerTable {
+private:
+    // Open addressing index over the slots, twice the capacity keeps probes short
+    static constexpr size_t INDEX_SIZE = UDP_PEER_MAX * 2;
+    static constexpr uint8_t INDEX_EMPTY = 0xFF;
+
+    UdpPeer peers[UDP_PEER_MAX];
+    std::atomic<uint32_t> txPackets[UDP_PEER_MAX];     // recordTx(), zeroed when a slot is reused
+    std::atomic<uint32_t> txBytes[UDP_PEER_MAX];
+    uint8_t index[INDEX_SIZE];
+    size_t count = 0;
+    uint32_t rejected = 0;      // New peers refused while the table was full
+    std::atomic<uint32_t> gen{0};
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    static bool enabled;
+    static UdpPeerTable* instance;
+    UdpPeerTable();
+
+    UdpPeerTable(const UdpPeerTable&) = delete;
+    UdpPeerTable& operator=(const UdpPeerTable&) = delete;
+
+    static size_t hashEndpoint(uint32_t ip, uint16_t port) {
+        uint32_t h = (ip ^ ((uint32_t)port << 16) ^ port) * 2654435761u;  // Knuth multiplicative
+        return (h >> 16) % INDEX_SIZE;
+    }
+
+    int findSlot(uint32_t ip, uint16_t port) const;
+    void rebuildIndex();
+    size_t expireLocked(uint32_t now);
+
+public:
+    static UdpPeerTable* getInstance() {
+        if (!instance) {
+            instance = new UdpPeerTable();
+        }
+        return instance;
+    }
+
+    // Learning is on for the whole boot once enabled (config.device4_config.learn_peers)
+    static bool isEnabled() { return enabled; }
+    static void enable() { enabled = true; }
+
+    // Record a datagram from ip:port (AsyncUDP task)
+    void learn(uint32_t ip, uint16_t port, size_t bytes);
+
+    // Changes when a peer is added or removed
+    uint32_t generation() const { return gen.load(std::memory_order_acquire); }
+
+    // Copy current endpoints (sender task). Returns count.
+    size_t copyEndpoints(UdpPeerEndpoint* out, size_t maxCount);
+
+    // Count a datagram sent to a slot (any sending task, lock-free)
+    void recordTx(uint8_t slot, size_t bytes) {
+        txPackets[slot].fetch_add(1, std::memory_order_relaxed);
+        txBytes[slot].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Drop peers silent for UDP_PEER_TTL_MS (sender task, about once per second)
+    void expire(uint32_t now);
+
+    // Peers with age and counters for the Web UI
+    void appendJson(JsonArray arr);
+};
+
+#endif // UDP_PEER_TABLE_H
@@ -5,9 +5,13 @@
 #include "sbus_router.h"
 #include "protocol_types.h"
 #include "sbus_mavlink.h"
+#include "sbus_udp_envelope.h"
+#include "udp_peer_table.h"
+#include "udp_host_resolver.h"
 #include "../device_types.h"
 #include <ArduinoJson.h>
 #include <AsyncUDP.h>
+#include <atomic>
 #include "../types.h"
 #include "../wifi/wifi_manager.h"
 
@@ -17,10 +21,83 @@ private:
     // Direct UDP transport
     AsyncUDP* udpTransport;  // Passed from outside
 
-    // Multiple target IPs support (manual or auto-broadcast from scheduler)
+    // Multiple target IPs support (manual or auto-broadcast from scheduler).
+    // Replaced whole by publishTargets(). sendUdpDatagram() runs on several tasks
+    // (sender, bridge/esp_timer via sendDirect, scheduler via sendNotification), so
+    // it works on a copyDestinations() snapshot and never touches these directly.
     static constexpr size_t MAX_UDP_TARGETS = 4;
     IPAddress targetIPs[MAX_UDP_TARGETS];
     uint8_t targetCount = 0;
+    portMUX_TYPE targetMux = portMUX_INITIALIZER_UNLOCKED;
+
+    void publishTargets(const IPAddress* ips, uint8_t count) {
+        portENTER_CRITICAL(&targetMux);
+        for (uint8_t i = 0; i < count; i++) {
+            targetIPs[i] = ips[i];
+        }
+        targetCount = count;
+        peersStale = true;
+        portEXIT_CRITICAL(&targetMux);
+    }
+
+    // Snapshot of targets and learned peers for one datagram. The peer list is
+    // re-filtered here (under targetMux) when the table or the targets changed.
+    uint8_t copyDestinations(IPAddress* targets, UdpPeerEndpoint* peersOut, uint8_t& peersCopied,
+                             UdpPeerTable* table, uint16_t port) {
+        portENTER_CRITICAL(&targetMux);
+        uint8_t count = targetCount;
+        for (uint8_t i = 0; i < count; i++) {
+            targets[i] = targetIPs[i];
+        }
+        peersCopied = 0;
+        if (table) {
+            uint32_t gen = table->generation();
+            if (peersStale || gen != peerGeneration) {
+                peerGeneration = gen;
+                peersStale = false;
+                refreshPeers(table, port);
+            }
+            for (uint8_t i = 0; i < peerCount; i++) {
+                peersOut[i] = peerEndpoints[i];
+            }
+            peersCopied = peerCount;
+        }
+        portEXIT_CRITICAL(&targetMux);
+        return count;
+    }
+
+    // Hostname targets, addresses cached by UdpHostResolver (never resolved here)
+    UdpHostResolver* hostResolver = nullptr;
+
+    // Learned reply-path peers (UdpPeerTable), re-copied only when the table changes.
+    // All four guarded by targetMux.
+    UdpPeerEndpoint peerEndpoints[UDP_PEER_MAX];
+    uint8_t peerCount = 0;
+    uint32_t peerGeneration = 0;
+    bool peersStale = true;         // Force a copy (targets changed)
+    uint32_t lastPeerExpireMs = 0;
+
+    // Copy peers, skipping those already covered by a static target (ip + config port).
+    // Caller holds targetMux.
+    void refreshPeers(UdpPeerTable* table, uint16_t port) {
+        UdpPeerEndpoint all[UDP_PEER_MAX];
+        size_t n = table->copyEndpoints(all, UDP_PEER_MAX);
+        peerCount = 0;
+        for (size_t i = 0; i < n; i++) {
+            bool duplicate = false;
+            if (all[i].port == port) {
+                for (uint8_t t = 0; t < targetCount; t++) {
+                    if ((uint32_t)targetIPs[t] == all[i].ip) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+            }
+            if (!duplicate) {
+                peerEndpoints[peerCount++] = all[i];
+            }
+        }
+    }
 
     // Batch buffer constants
     static constexpr size_t MTU_SIZE = 1400;
@@ -74,6 +151,59 @@ private:
     uint32_t sendRateIntervalMs = 0;  // 0 = disabled (no rate limit)
     uint32_t lastSendMs = 0;
 
+    // SBUS envelope (sequence + timestamp) for ESP<->ESP links, binary format only
+    static constexpr uint8_t SBUS_HISTORY_SIZE = SBUS_UDP_MAX_REDUNDANCY;
+    bool sbusEnvelope = false;
+    uint32_t sbusSeq = 0;
+    uint8_t sbusRedundancy = 0;   // Previous frames repeated in each datagram (0-3)
+    uint8_t sbusHistory[SBUS_HISTORY_SIZE][SBUS_FRAME_SIZE];
+    uint8_t sbusHistoryHead = 0;  // Next write slot
+    uint8_t sbusHistoryCount = 0;
+
+    // Envelope settings from setSbusEnvelope() (bridge task), taken over by the task
+    // that writes SBUS frames (output scheduler task when active) before its next frame
+    static constexpr uint16_t SBUS_ENV_PENDING = 0x100;
+    static constexpr uint16_t SBUS_ENV_ENABLED = 0x80;
+    std::atomic<uint16_t> pendingEnvelope{0};
+
+    void applyPendingEnvelope() {
+        uint16_t pending = pendingEnvelope.exchange(0, std::memory_order_acquire);
+        if (!(pending & SBUS_ENV_PENDING)) return;
+
+        sbusRedundancy = pending & 0x7F;
+        sbusEnvelope = (pending & SBUS_ENV_ENABLED) || sbusRedundancy > 0;
+        sbusHistoryCount = 0;
+        sbusHistoryHead = 0;
+        log_msg(LOG_INFO, "UDP SBUS envelope %s (redundancy %u)",
+                sbusEnvelope ? "enabled" : "disabled", sbusRedundancy);
+    }
+
+    // One new frame per datagram - no batching, receiver de-jitters by timestamp.
+    // With redundancy, previous N frames ride along (oldest first) so a single
+    // lost datagram is recovered from the next one without extra latency.
+    void sendSbusEnvelope(const uint8_t* frame) {
+        uint8_t datagram[SBUS_UDP_ENV_HEADER_SIZE + SBUS_FRAME_SIZE * SBUS_UDP_ENV_MAX_FRAMES];
+        uint8_t prevCount = (sbusRedundancy < sbusHistoryCount) ? sbusRedundancy : sbusHistoryCount;
+
+        size_t len = sbusUdpEnvelopeWriteHeader(datagram, ++sbusSeq, micros(), prevCount + 1);
+        for (uint8_t i = prevCount; i > 0; i--) {
+            uint8_t idx = (sbusHistoryHead + SBUS_HISTORY_SIZE - i) % SBUS_HISTORY_SIZE;
+            memcpy(datagram + len, sbusHistory[idx], SBUS_FRAME_SIZE);
+            len += SBUS_FRAME_SIZE;
+        }
+        memcpy(datagram + len, frame, SBUS_FRAME_SIZE);
+        len += SBUS_FRAME_SIZE;
+
+        sendUdpDatagram(datagram, len);
+        totalSent++;
+
+        if (sbusRedundancy > 0) {
+            memcpy(sbusHistory[sbusHistoryHead], frame, SBUS_FRAME_SIZE);
+            sbusHistoryHead = (sbusHistoryHead + 1) % SBUS_HISTORY_SIZE;
+            if (sbusHistoryCount < SBUS_HISTORY_SIZE) sbusHistoryCount++;
+        }
+    }
+
     void flushBatch() {
         if (atomicBatchSize > 0) {
             // === DIAGNOSTIC START ===
@@ -224,6 +354,12 @@ public:
         }
 
         // --- SBUS-specific path: format conversion + batching ---
+        applyPendingEnvelope();
+        if (sbusEnvelope && sbusOutputFormat == SBUS_FMT_BINARY) {
+            sendSbusEnvelope(data);
+            return size;
+        }
+
         const uint8_t* sendData = data;
         size_t sendSize = size;
 
@@ -296,17 +432,33 @@ public:
         }
     }
 
-    // Parse comma-separated IP list into targetIPs array
+    // Enable SBUS envelope (sequence number + send timestamp), redundancy implies envelope.
+    // Applied by the SBUS writer before its next frame (see applyPendingEnvelope).
+    void setSbusEnvelope(bool enabled, uint8_t redundancy = 0) {
+        if (redundancy > SBUS_HISTORY_SIZE) redundancy = SBUS_HISTORY_SIZE;
+        pendingEnvelope.store(SBUS_ENV_PENDING | (enabled ? SBUS_ENV_ENABLED : 0) | redundancy,
+                              std::memory_order_release);
+    }
+
+    // Parse comma-separated list of IPs and hostnames (shared MAX_UDP_TARGETS limit)
+    // Parsed into a local list and published at once
     void parseTargetIPs(const char* ipList) {
-        targetCount = 0;
-        if (!ipList || ipList[0] == '\0') return;
+        IPAddress ips[MAX_UDP_TARGETS];
+        uint8_t ipCount = 0;
+        const char* hostNames[MAX_UDP_TARGETS];
+        size_t hostCount = 0;
+        if (!ipList || ipList[0] == '\0') {
+            publishTargets(ips, 0);
+            if (hostResolver) hostResolver->setHosts(hostNames, 0);
+            return;
+        }
 
         char buffer[96];
         strncpy(buffer, ipList, sizeof(buffer) - 1);
         buffer[sizeof(buffer) - 1] = '\0';
 
         char* token = strtok(buffer, ",");
-        while (token && targetCount < MAX_UDP_TARGETS) {
+        while (token && ipCount + hostCount < MAX_UDP_TARGETS) {
             // Skip leading spaces
             while (*token == ' ') token++;
             // Remove trailing spaces
@@ -314,13 +466,25 @@ public:
             while (end > token && *end == ' ') *end-- = '\0';
 
             if (strlen(token) > 0) {
-                if (targetIPs[targetCount].fromString(token)) {
-                    log_msg(LOG_DEBUG, "UDP target[%d]: %s", targetCount, token);
-                    targetCount++;
+                if (ips[ipCount].fromString(token)) {
+                    log_msg(LOG_DEBUG, "UDP target[%d]: %s", ipCount, token);
+                    ipCount++;
+                } else if (UdpHostResolver::isHostname(token)) {
+                    hostNames[hostCount++] = token;   // Points into buffer, copied by setHosts()
+                } else {
+                    log_msg(LOG_WARNING, "UDP target ignored: %s", token);
                 }
             }
             token = strtok(nullptr, ",");
         }
+
+        publishTargets(ips, ipCount);
+        if (hostCount > 0 && !hostResolver) {
+            hostResolver = UdpHostResolver::getInstance();
+        }
+        if (hostResolver) {
+            hostResolver->setHosts(hostNames, hostCount);
+        }
     }
 
     explicit UdpSender(AsyncUDP* udp) :
@@ -336,23 +500,27 @@ public:
             log_msg(LOG_INFO, "UdpSender: auto-broadcast mode");
         } else {
             parseTargetIPs(config.device4_config.target_ip);
-            log_msg(LOG_INFO, "UdpSender: %d target(s)", targetCount);
+            log_msg(LOG_INFO, "UdpSender: %d target(s), %u hostname(s)", targetCount,
+                    hostResolver ? (unsigned)hostResolver->count() : 0);
         }
     }
 
     // Set broadcast IP directly (called by scheduler for auto-broadcast mode)
     void setBroadcastIP(const IPAddress& ip) {
-        targetIPs[0] = ip;
-        targetCount = 1;
+        publishTargets(&ip, 1);
     }
 
-    // Reload targets from config (called by scheduler when IP changes)
-    void reloadTargets() {
-        extern Config config;
-        parseTargetIPs(config.device4_config.target_ip);
+    // Reload targets from a copy of device4.target_ip (bridge task, live config)
+    void reloadTargets(const char* targetList) {
+        parseTargetIPs(targetList);
         log_msg(LOG_DEBUG, "UDP targets reloaded: %d", targetCount);
     }
-    
+
+    // Out-of-band datagram to all targets (bypasses queue and batching)
+    void sendNotification(const uint8_t* data, size_t size) {
+        sendUdpDatagram(const_cast<uint8_t*>(data), size);
+    }
+
     ~UdpSender() {
         // Flush any pending batches before destruction
         flushAllBatches();
@@ -380,6 +548,11 @@ public:
         // Existing processing code continues here...
         uint32_t now = millis();
 
+        if (UdpPeerTable::isEnabled() && (now - lastPeerExpireMs) >= 1000) {
+            UdpPeerTable::getInstance()->expire(now);
+            lastPeerExpireMs = now;
+        }
+
         // Flush batches on bulk mode transition (functional, not diagnostic)
         if (bulkMode != lastBulkMode) {
             // === DIAGNOSTIC START ===
@@ -464,22 +637,55 @@ public:
     }
     
     void sendUdpDatagram(uint8_t* data, size_t size) {
-        if (!udpTransport || size == 0 || targetCount == 0) return;
+        if (!udpTransport || size == 0) return;
 
         extern Config config;
         uint16_t port = config.device4_config.port;
         size_t totalSentBytes = 0;
         uint8_t sentCount = 0;
 
+        UdpPeerTable* peers = UdpPeerTable::isEnabled() ? UdpPeerTable::getInstance() : nullptr;
+        IPAddress targets[MAX_UDP_TARGETS];
+        UdpPeerEndpoint peerList[UDP_PEER_MAX];
+        uint8_t peerListCount;
+        uint8_t staticCount = copyDestinations(targets, peerList, peerListCount, peers, port);
+
+        size_t hostCount = hostResolver ? hostResolver->count() : 0;
+        if (staticCount == 0 && peerListCount == 0 && hostCount == 0) return;
+
         // Send to all configured targets (manual IPs or broadcast from scheduler)
-        for (uint8_t i = 0; i < targetCount; i++) {
-            size_t sent = udpTransport->writeTo(data, size, targetIPs[i], port);
+        for (uint8_t i = 0; i < staticCount; i++) {
+            size_t sent = udpTransport->writeTo(data, size, targets[i], port);
             if (sent > 0) {
                 totalSentBytes += sent;
                 sentCount++;
             }
         }
 
+        // Hostname targets: last good address, skipped until the first lookup succeeds
+        for (size_t i = 0; i < hostCount; i++) {
+            uint32_t ip = hostResolver->address(i);
+            if (!ip) continue;
+            size_t sent = udpTransport->writeTo(data, size, IPAddress(ip), port);
+            if (sent > 0) {
+                totalSentBytes += sent;
+                sentCount++;
+            }
+        }
+
+        // Reply to learned peers at their source port
+        if (peers) {
+            for (uint8_t i = 0; i < peerListCount; i++) {
+                size_t sent = udpTransport->writeTo(data, size, IPAddress(peerList[i].ip),
+                                                    peerList[i].port);
+                if (sent > 0) {
+                    peers->recordTx(peerList[i].slot, sent);
+                    totalSentBytes += sent;
+                    sentCount++;
+                }
+            }
+        }
+
         if (sentCount == 0) {
             static uint32_t lastFailLog = 0;
             if (millis() - lastFailLog > 5000) {
@@ -153,6 +153,12 @@ public:
         return sent;
     }
 
+    size_t getDirectWriteSpace() override {
+        if (!usbInterface) return 0;
+        int space = usbInterface->availableForWrite();
+        return (space > 0) ? (size_t)space : 0;
+    }
+
     void processSendQueue(bool bulkMode = false) override {
         uint32_t now = millis();
 
@@ -9,12 +9,17 @@
 #include "defines.h"
 #include "types.h"
 #include "web/web_interface.h"
+#include "web/web_api.h"
+#include "web/stats_ws.h"
+#include "web/rc_ws.h"
 #include "wifi/wifi_manager.h"
 #include "protocols/protocol_pipeline.h"
 #include "protocols/udp_sender.h"
+#include "protocols/udp_host_resolver.h"
 #include "circular_buffer.h"
 #include "leds.h"
 #include "protocols/sbus_router.h"
+#include "protocols/terminal_triggers.h"
 #include "device_init.h"
 
 // External objects
@@ -36,8 +41,13 @@ static Task tUdpLoggerTask(100, TASK_FOREVER, nullptr);
 Task tLedMonitor(50, TASK_FOREVER, nullptr);  // 50ms interval for LED monitoring - exported for external control
 Task tSbusRouterTick(10, TASK_FOREVER, nullptr);  // Every 10ms - exported for external control
 static Task tBroadcastUpdate(3000, TASK_FOREVER, nullptr);  // Update broadcast IP every 3s
+static Task tUdpHostResolve(1000, TASK_FOREVER, nullptr);  // Hostname UDP targets (async DNS)
 static Task tHeapMonitor(5000, TASK_FOREVER, nullptr);  // DEBUG: heap monitor via Serial (disabled by default)
-static Task tTerminalWsPoll(50, TASK_FOREVER, nullptr);  // Terminal WebSocket push every 50ms
+static Task tTerminalWsPoll(50, TASK_FOREVER, nullptr);  // Terminal WebSocket push (config.terminalFlushMs)
+static Task tTerminalTriggers(50, TASK_FOREVER, nullptr);  // Terminal trigger actions
+static Task tStatusSnapshot(STATUS_SNAPSHOT_INTERVAL_MS, TASK_FOREVER, nullptr);  // /api/status cache refresh
+static Task tStatsWsPoll(STATS_WS_TICK_MS, TASK_FOREVER, nullptr);  // /ws/stats push
+static Task tRcWsPoll(RC_WS_TICK_MS, TASK_FOREVER, nullptr);  // /ws/rc push
 
 // Simple snapshot for LED comparison (not atomic)
 struct LedSnapshot {
@@ -149,7 +159,7 @@ void initializeScheduler() {
         ProtocolPipeline* pipeline = getProtocolPipeline();
         if (!pipeline) return;
 
-        PacketSender* sender = pipeline->getSender(IDX_DEVICE4);
+        UdpSender* sender = pipeline->getUdpSender();
         if (!sender) return;
 
         String broadcastStr = wifiGetBroadcastIP();
@@ -157,10 +167,15 @@ void initializeScheduler() {
 
         IPAddress broadcastIP;
         if (broadcastIP.fromString(broadcastStr)) {
-            ((UdpSender*)sender)->setBroadcastIP(broadcastIP);
+            sender->setBroadcastIP(broadcastIP);
         }
     });
 
+    tUdpHostResolve.set(1000, TASK_FOREVER, []{
+        // Only starts lookups - answers arrive in the tcpip thread
+        UdpHostResolver::getInstance()->tick(millis());
+    });
+
 #ifdef DEBUG
     // Heap monitor via Serial (disabled by default, enable with tHeapMonitor.enable())
     tHeapMonitor.set(5000, TASK_FOREVER, []{
@@ -170,10 +185,26 @@ void initializeScheduler() {
     });
 #endif
 
-    tTerminalWsPoll.set(50, TASK_FOREVER, []{
+    tTerminalWsPoll.set(config.terminalFlushMs, TASK_FOREVER, []{
         terminal_ws_poll();
     });
 
+    tTerminalTriggers.set(50, TASK_FOREVER, []{
+        TerminalTriggers::getInstance()->dispatch();
+    });
+
+    tStatusSnapshot.set(STATUS_SNAPSHOT_INTERVAL_MS, TASK_FOREVER, []{
+        web_api_status_tick();
+    });
+
+    tStatsWsPoll.set(STATS_WS_TICK_MS, TASK_FOREVER, []{
+        stats_ws_poll();
+    });
+
+    tRcWsPoll.set(RC_WS_TICK_MS, TASK_FOREVER, []{
+        rc_ws_poll();
+    });
+
     tUdpLoggerTask.set(100, TASK_FOREVER, []{
         if (config.device4.role != D4_LOG_NETWORK) return;
 
@@ -273,8 +304,13 @@ void initializeScheduler() {
     taskScheduler.addTask(tLedMonitor);
     taskScheduler.addTask(tSbusRouterTick);
     taskScheduler.addTask(tBroadcastUpdate);
+    taskScheduler.addTask(tUdpHostResolve);
     taskScheduler.addTask(tHeapMonitor);
     taskScheduler.addTask(tTerminalWsPoll);
+    taskScheduler.addTask(tTerminalTriggers);
+    taskScheduler.addTask(tStatusSnapshot);
+    taskScheduler.addTask(tStatsWsPoll);
+    taskScheduler.addTask(tRcWsPoll);
 
     // Enable basic tasks that run in all modes
     tCrashlogUpdate.enable();
@@ -299,6 +335,11 @@ void enableStandaloneTasks() {
         tSbusRouterTick.enable();
     }
 
+    // Terminal trigger actions (LED/log/UDP) work in both modes
+    if (config.protocolOptimization == PROTOCOL_TERMINAL && !config.terminalTriggers.isEmpty()) {
+        tTerminalTriggers.enable();
+    }
+
     // Disable network mode tasks
     tDnsProcess.disable();
     tWiFiTimeout.disable();
@@ -339,10 +380,25 @@ void enableNetworkTasks(bool temporaryNetwork) {
         tBroadcastUpdate.enable();
     }
 
+    // Hostname targets in device4.target_ip (idle while the list has none)
+    if (config.device4.role == D4_NETWORK_BRIDGE || config.device4.role == D4_LOG_NETWORK ||
+        config.device4.role == D4_SBUS_UDP_TX || config.device4.role == D4_CRSF_TEXT) {
+        tUdpHostResolve.enable();
+    }
+
     // Enable Terminal WebSocket polling if Terminal protocol is active
     if (config.protocolOptimization == PROTOCOL_TERMINAL) {
         tTerminalWsPoll.enable();
     }
+
+    if (config.protocolOptimization == PROTOCOL_TERMINAL && !config.terminalTriggers.isEmpty()) {
+        tTerminalTriggers.enable();
+    }
+
+    // Cached /api/status (idles itself when nobody polls)
+    tStatusSnapshot.enable();
+    tStatsWsPoll.enable();
+    tRcWsPoll.enable();
 }
 
 void disableNetworkTasks() {
@@ -351,9 +407,13 @@ void disableNetworkTasks() {
     tWiFiTimeout.disable();
     // Client mode tasks
     tBroadcastUpdate.disable();
+    tUdpHostResolve.disable();
     // Device 4 network tasks (both modes)
     tUdpLoggerTask.disable();
     tTerminalWsPoll.disable();
+    tStatusSnapshot.disable();
+    tStatsWsPoll.disable();
+    tRcWsPoll.disable();
 }
 
 void startWiFiTimeout() {
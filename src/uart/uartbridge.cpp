@@ -3,9 +3,11 @@
 #include "../adaptive_buffer.h"
 #include "../protocols/protocol_pipeline.h"
 #include "../protocols/sbus_fast_parser.h"
+#include "../protocols/sbus_udp_envelope.h"
 #include "../protocols/buffer_manager.h"
 #include "../device_init.h"
 #include "../diagnostics.h"
+#include "../boot_profile.h"
 #include "../logging.h"
 #include "../leds.h"
 #include "../defines.h"
@@ -74,6 +76,7 @@ void senderTask(void* parameter) {
 void uartBridgeTask(void* parameter) {
     // Wait for system initialization
     vTaskDelay(pdMS_TO_TICKS(1000));
+    boot_profile_mark(BOOT_PHASE_BRIDGE_START);
 
     log_msg(LOG_INFO, "UART task started on core %d", xPortGetCoreID());
 
@@ -112,6 +115,7 @@ void uartBridgeTask(void* parameter) {
     bool device3IsBridge = (config.device3.role == D3_UART3_BRIDGE ||
                             config.device3.role == D3_SBUS_IN ||
                             config.device3.role == D3_CRSF_BRIDGE);
+    bool device4IsSbusRx = (config.device4.role == D4_SBUS_UDP_RX);
 
     // Initialize BridgeContext
     BridgeContext ctx;
@@ -149,6 +153,7 @@ void uartBridgeTask(void* parameter) {
 
     // Initialize adaptive buffer timing
     initAdaptiveBuffer(&ctx, adaptiveBufferSize);
+    boot_profile_mark(BOOT_PHASE_BUFFERS);
 
     // Initialize protocol pipeline
     ctx.protocolPipeline = new ProtocolPipeline(&ctx);
@@ -156,6 +161,7 @@ void uartBridgeTask(void* parameter) {
 
     // Save pipeline pointer for sender task
     g_protocolPipeline = ctx.protocolPipeline;
+    boot_profile_finish();
 
     // Register SBUS outputs with router (after pipeline is ready)
     // Safe to call unconditionally - hasSbusDevice() check inside
@@ -216,6 +222,11 @@ void uartBridgeTask(void* parameter) {
             processDevice3UART(&ctx);
         }
 
+        // Release de-jittered SBUS envelope frames (no-op for raw datagrams)
+        if (device4IsSbusRx) {
+            SbusUdpReceiver::getInstance()->releaseDue(ctx.buffers.udpInputBuffer);
+        }
+
         // Process Device 4 input (UDP Bridge mode only)
         if (ctx.buffers.udpRxBuffer) {
             processDevice4UDP(&ctx);
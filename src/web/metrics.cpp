@@ -0,0 +1,255 @@
+#include "metrics.h"
+#include "config.h"
+#include "defines.h"
+#include "diagnostics.h"
+#include "../device_stats.h"
+#include "../device_types.h"
+#include "../wifi/wifi_manager.h"
+#include "protocols/protocol_pipeline.h"
+#include "protocols/protocol_stats.h"
+#include "protocols/packet_memory_pool.h"
+#include "protocols/mavlink_msg_stats.h"
+#include "esp_heap_caps.h"
+
+extern Config config;
+extern SystemState systemState;
+
+// Tasks reported in bridge_task_stack_free_bytes (missing ones are skipped)
+static const char* const METRICS_TASKS[] = {
+    "loopTask", "UART_Bridge_Task", "sender_task", "uart_dma_event",
+    "async_tcp", "wifi", "sys_evt",
+};
+
+// "# HELP" / "# TYPE" header of a metric family
+// Lines end with \n only - println() would add \r, which the exposition format rejects
+static void family(Print& out, const char* name, const char* type, const char* help) {
+    out.print("# HELP ");
+    out.print(name);
+    out.print(' ');
+    out.print(help);
+    out.print('\n');
+    out.print("# TYPE ");
+    out.print(name);
+    out.print(' ');
+    out.print(type);
+    out.print('\n');
+}
+
+// Label value with \, " and newline escaped
+static void labelValue(Print& out, const char* value) {
+    for (const char* p = value; *p; p++) {
+        if (*p == '\\' || *p == '"') {
+            out.print('\\');
+            out.print(*p);
+        } else if (*p == '\n') {
+            out.print("\\n");
+        } else {
+            out.print(*p);
+        }
+    }
+}
+
+// name{label="value",label2="value2"} sample - labels may be nullptr
+static void sample(Print& out, const char* name, uint64_t value,
+                   const char* label = nullptr, const char* labelVal = nullptr,
+                   const char* label2 = nullptr, const char* labelVal2 = nullptr) {
+    out.print(name);
+    if (label) {
+        out.print('{');
+        out.print(label);
+        out.print("=\"");
+        labelValue(out, labelVal);
+        out.print('"');
+        if (label2) {
+            out.print(',');
+            out.print(label2);
+            out.print("=\"");
+            labelValue(out, labelVal2);
+            out.print('"');
+        }
+        out.print('}');
+    }
+    out.print(' ');
+    out.print(value);
+    out.print('\n');
+}
+
+static void writeDeviceMetrics(Print& out) {
+    struct DeviceRow {
+        const char* name;
+        const DeviceStatistics::DeviceCounter* counter;
+        bool active;
+    };
+    const DeviceRow devices[] = {
+        {"device1", &g_deviceStats.device1, true},
+        {"device2", &g_deviceStats.device2, config.device2.role != D2_NONE},
+        {"device3", &g_deviceStats.device3, config.device3.role != D3_NONE},
+        {"device4", &g_deviceStats.device4, config.device4.role != D4_NONE},
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+        {"device5", &g_deviceStats.device5, config.device5_config.role != D5_NONE},
+#endif
+    };
+
+    family(out, "bridge_device_bytes_total", "counter", "Bytes moved by each device.");
+    for (const auto& d : devices) {
+        if (!d.active) continue;
+        sample(out, "bridge_device_bytes_total", d.counter->rxBytes.load(std::memory_order_relaxed),
+               "device", d.name, "direction", "rx");
+        sample(out, "bridge_device_bytes_total", d.counter->txBytes.load(std::memory_order_relaxed),
+               "device", d.name, "direction", "tx");
+    }
+
+    // Packet counters are only maintained for Device4 (UDP datagrams)
+    if (config.device4.role != D4_NONE) {
+        family(out, "bridge_device_packets_total", "counter", "Datagrams moved by Device4.");
+        sample(out, "bridge_device_packets_total", g_deviceStats.device4.rxPackets.load(std::memory_order_relaxed),
+               "device", "device4", "direction", "rx");
+        sample(out, "bridge_device_packets_total", g_deviceStats.device4.txPackets.load(std::memory_order_relaxed),
+               "device", "device4", "direction", "tx");
+    }
+}
+
+static void writePipelineMetrics(Print& out) {
+    BridgeContext* ctx = getBridgeContext();
+    if (!ctx) return;
+
+    ProtocolStats* stats = ctx->protocol.stats;
+    if (stats) {
+        family(out, "bridge_parser_bytes_total", "counter", "Bytes processed by the protocol parser.");
+        sample(out, "bridge_parser_bytes_total", stats->totalBytes);
+        family(out, "bridge_parser_packets_total", "counter", "Packets detected by the protocol parser.");
+        sample(out, "bridge_parser_packets_total", stats->packetsDetected);
+        family(out, "bridge_parser_errors_total", "counter", "Protocol parser detection errors.");
+        sample(out, "bridge_parser_errors_total", stats->detectionErrors);
+        family(out, "bridge_parser_resyncs_total", "counter", "Protocol parser resynchronizations.");
+        sample(out, "bridge_parser_resyncs_total", stats->resyncEvents);
+    }
+
+    ProtocolPipeline* pipeline = ctx->protocolPipeline;
+    if (!pipeline) return;
+
+    // Sender queues: one family at a time, as the format requires
+    static const struct {
+        const char* name;
+        const char* type;
+        const char* help;
+    } senderFamilies[] = {
+        {"bridge_sender_queue_packets", "gauge", "Packets waiting in the sender queue."},
+        {"bridge_sender_queue_bytes", "gauge", "Bytes waiting in the sender queue."},
+        {"bridge_sender_queue_max_packets", "gauge", "Highest sender queue depth seen."},
+        {"bridge_sender_sent_total", "counter", "Packets sent by the sender."},
+        {"bridge_sender_dropped_total", "counter", "Packets dropped by the sender (queue full)."},
+    };
+    for (size_t f = 0; f < sizeof(senderFamilies) / sizeof(senderFamilies[0]); f++) {
+        bool headerDone = false;
+        for (size_t i = 0; i < pipeline->getSenderCount(); i++) {
+            PacketSender* sender = pipeline->getSender(i);
+            if (!sender) continue;
+
+            if (!headerDone) {
+                family(out, senderFamilies[f].name, senderFamilies[f].type, senderFamilies[f].help);
+                headerDone = true;
+            }
+            uint64_t value;
+            switch (f) {
+                case 0:  value = sender->getQueueDepth(); break;
+                case 1:  value = sender->getQueueBytes(); break;
+                case 2:  value = sender->getMaxQueueDepth(); break;
+                case 3:  value = sender->getSentCount(); break;
+                default: value = sender->getDroppedCount(); break;
+            }
+            sample(out, senderFamilies[f].name, value, "sender", sender->getName());
+        }
+    }
+}
+
+static void writePoolMetrics(Print& out) {
+    PacketMemoryPool::PoolUsage pools[PacketMemoryPool::POOL_COUNT];
+    PacketMemoryPool::getInstance()->getUsage(pools);
+
+    char sizeLabel[8];
+    family(out, "bridge_pool_blocks", "gauge", "Blocks in each packet memory pool.");
+    for (const auto& p : pools) {
+        snprintf(sizeLabel, sizeof(sizeLabel), "%u", (unsigned)p.blockSize);
+        sample(out, "bridge_pool_blocks", p.blockCount, "block_size", sizeLabel);
+    }
+    family(out, "bridge_pool_blocks_in_use", "gauge", "Packet memory pool blocks currently allocated.");
+    for (const auto& p : pools) {
+        snprintf(sizeLabel, sizeof(sizeLabel), "%u", (unsigned)p.blockSize);
+        sample(out, "bridge_pool_blocks_in_use", p.allocCount - p.freeCount, "block_size", sizeLabel);
+    }
+    family(out, "bridge_pool_exhausted_total", "counter", "Pool allocations that fell back to the heap.");
+    for (const auto& p : pools) {
+        snprintf(sizeLabel, sizeof(sizeLabel), "%u", (unsigned)p.blockSize);
+        sample(out, "bridge_pool_exhausted_total", p.failCount, "block_size", sizeLabel);
+    }
+}
+
+static void writeSystemMetrics(Print& out) {
+    family(out, "bridge_info", "gauge", "Firmware version.");
+    sample(out, "bridge_info", 1, "version", DEVICE_VERSION);
+
+    family(out, "bridge_uptime_seconds", "gauge", "Seconds since boot.");
+    sample(out, "bridge_uptime_seconds",
+           (millis() - g_deviceStats.systemStartTime.load(std::memory_order_relaxed)) / 1000);
+
+    family(out, "bridge_heap_free_bytes", "gauge", "Free internal heap.");
+    sample(out, "bridge_heap_free_bytes", ESP.getFreeHeap());
+    family(out, "bridge_heap_min_free_bytes", "gauge", "Lowest free internal heap since boot.");
+    sample(out, "bridge_heap_min_free_bytes", ESP.getMinFreeHeap());
+    family(out, "bridge_heap_max_alloc_bytes", "gauge", "Largest allocatable internal heap block.");
+    sample(out, "bridge_heap_max_alloc_bytes", ESP.getMaxAllocHeap());
+
+    size_t psramTotal = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+    if (psramTotal > 0) {
+        family(out, "bridge_psram_free_bytes", "gauge", "Free PSRAM.");
+        sample(out, "bridge_psram_free_bytes", heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+    }
+
+    family(out, "bridge_task_stack_free_bytes", "gauge", "Task stack high-water mark (never used).");
+    for (const char* name : METRICS_TASKS) {
+        TaskHandle_t task = xTaskGetHandle(name);
+        if (task) {
+            sample(out, "bridge_task_stack_free_bytes", uxTaskGetStackHighWaterMark(task), "task", name);
+        }
+    }
+
+    if (config.wifi_mode == BRIDGE_WIFI_MODE_CLIENT && systemState.wifiClientConnected) {
+        // Gauge can be negative - the only signed value here
+        family(out, "bridge_wifi_rssi_dbm", "gauge", "WiFi client signal strength.");
+        out.print("bridge_wifi_rssi_dbm ");
+        out.print(wifiGetRSSI());
+        out.print('\n');
+    }
+}
+
+static void writeMavlinkMetrics(Print& out) {
+    if (!MavlinkMsgStats::isEnabled()) return;
+
+    MsgIdCounters total, untracked;
+    size_t tracked;
+    MavlinkMsgStats::getInstance()->getTotals(total, untracked, tracked);
+
+    // Totals only - per-msgid series would be high cardinality (see /api/mavlink/messages)
+    family(out, "bridge_mavlink_packets_total", "counter", "MAVLink packets through the pipeline.");
+    sample(out, "bridge_mavlink_packets_total", total.rxPackets, "direction", "rx");
+    sample(out, "bridge_mavlink_packets_total", total.txPackets, "direction", "tx");
+    family(out, "bridge_mavlink_dropped_total", "counter", "MAVLink packets rejected by full sender queues.");
+    sample(out, "bridge_mavlink_dropped_total", total.txDrops);
+    family(out, "bridge_mavlink_message_ids", "gauge", "Distinct MAVLink message ids seen.");
+    sample(out, "bridge_mavlink_message_ids", tracked);
+}
+
+void writeMetrics(Print& out) {
+    writeSystemMetrics(out);
+    writeDeviceMetrics(out);
+    writePipelineMetrics(out);
+    writePoolMetrics(out);
+    writeMavlinkMetrics(out);
+}
+
+void handleMetrics(AsyncWebServerRequest *request) {
+    AsyncResponseStream* response = request->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+    writeMetrics(*response);
+    request->send(response);
+}
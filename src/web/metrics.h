@@ -0,0 +1,13 @@
+// Prometheus text exposition (/metrics)
+// Counters and gauges written straight to the response with print() - no JSON document.
+// All metric names use the "bridge_" prefix; per-device/sender/pool/task values are labelled.
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// Render all metrics in text format 0.0.4
+void writeMetrics(Print& out);
+
+// GET /metrics
+void handleMetrics(AsyncWebServerRequest *request);
@@ -0,0 +1,152 @@
+#include "rc_ws.h"
+#include "logging.h"
+#include <ArduinoJson.h>
+
+struct RcWsClient {
+    uint32_t id;            // WebSocket client id, 0 = free slot
+    uint32_t intervalMs;
+    uint32_t nextMs;
+    uint32_t lastSentMs;
+    uint32_t sentSeq;       // rcChannels sequence of last frame
+    bool sentAny;
+};
+
+static AsyncWebSocket* rcWs = nullptr;
+
+// Client slots - written by WebSocket events (async_tcp task), read by poll (scheduler)
+static RcWsClient clients[RC_WS_MAX_CLIENTS];
+static portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void onRcWsEvent(AsyncWebSocket* ws, AsyncWebSocketClient* client,
+                        AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    uint32_t id = client->id();
+
+    if (type == WS_EVT_CONNECT) {
+        uint32_t now = millis();
+        bool added = false;
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id == 0) {
+                c = {id, 1000 / RC_WS_DEFAULT_RATE_HZ, now, 0, 0, false};
+                added = true;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&clientsMux);
+
+        if (!added) {
+            log_msg(LOG_WARNING, "RC WS: too many clients, #%u rejected", id);
+            client->close();
+            return;
+        }
+        log_msg(LOG_INFO, "RC WS client #%u connected", id);
+
+    } else if (type == WS_EVT_DISCONNECT) {
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id == id) c.id = 0;
+        }
+        portEXIT_CRITICAL(&clientsMux);
+        log_msg(LOG_INFO, "RC WS client #%u disconnected", id);
+
+    } else if (type == WS_EVT_DATA) {
+        // Rate request: single unfragmented text frame {"rate":hz}
+        AwsFrameInfo* info = (AwsFrameInfo*)arg;
+        if (info->opcode != WS_TEXT || !info->final || info->index != 0 || info->len != len) return;
+
+        JsonDocument req;
+        if (deserializeJson(req, data, len)) return;
+
+        uint32_t rate = req["rate"] | (uint32_t)0;
+        if (rate == 0) return;
+        rate = constrain(rate, (uint32_t)1, (uint32_t)RC_WS_MAX_RATE_HZ);
+
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id == id) c.intervalMs = 1000 / rate;
+        }
+        portEXIT_CRITICAL(&clientsMux);
+
+        log_msg(LOG_DEBUG, "RC WS client #%u: %lu Hz", id, (unsigned long)rate);
+    }
+}
+
+void rc_ws_attach(AsyncWebServer* server) {
+    if (rcWs) return;
+
+    memset(clients, 0, sizeof(clients));
+    rcWs = new AsyncWebSocket("/ws/rc");
+    rcWs->onEvent(onRcWsEvent);
+    server->addHandler(rcWs);
+    log_msg(LOG_INFO, "RC WebSocket endpoint created: /ws/rc");
+}
+
+void rc_ws_detach() {
+    if (!rcWs) return;
+
+    rcWs->closeAll();
+    rcWs = nullptr;  // Owned by server, deleted with it
+
+    portENTER_CRITICAL(&clientsMux);
+    memset(clients, 0, sizeof(clients));
+    portEXIT_CRITICAL(&clientsMux);
+}
+
+void rc_ws_poll() {
+    if (!rcWs) return;
+    rcWs->cleanupClients();
+    if (rcWs->count() == 0) return;
+
+    uint32_t now = millis();
+
+    RcWsClient due[RC_WS_MAX_CLIENTS];
+    size_t dueCount = 0;
+    portENTER_CRITICAL(&clientsMux);
+    for (const auto& c : clients) {
+        if (c.id && (int32_t)(now - c.nextMs) >= 0) {
+            due[dueCount++] = c;
+        }
+    }
+    portEXIT_CRITICAL(&clientsMux);
+    if (dueCount == 0) return;
+
+    // Raced with the writer on every attempt - try again next tick
+    RcChannelSnapshot rc;
+    if (!rc_channels_read(rc)) return;
+
+    uint8_t frame[RC_WS_FRAME_SIZE];
+    bool encoded = false;
+
+    for (size_t i = 0; i < dueCount; i++) {
+        RcWsClient& c = due[i];
+        bool changed = !c.sentAny || rc.seq != c.sentSeq;
+        bool keepalive = (now - c.lastSentMs) >= RC_WS_KEEPALIVE_MS;
+        bool sent = false;
+
+        if (changed || keepalive) {
+            AsyncWebSocketClient* client = rcWs->client(c.id);
+            // Busy client is skipped - it only ever needs the latest values
+            if (client && client->status() == WS_CONNECTED &&
+                client->canSend() && client->queueLen() < RC_WS_MAX_QUEUED) {
+                if (!encoded) {
+                    rc_ws_encode(rc, now, frame);
+                    encoded = true;
+                }
+                client->binary(frame, sizeof(frame));
+                sent = true;
+            }
+        }
+
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& slot : clients) {
+            if (slot.id != c.id) continue;
+            slot.nextMs = now + slot.intervalMs;
+            if (sent) {
+                slot.lastSentMs = now;
+                slot.sentSeq = rc.seq;
+                slot.sentAny = true;
+            }
+        }
+        portEXIT_CRITICAL(&clientsMux);
+    }
+}
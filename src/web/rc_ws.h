@@ -0,0 +1,33 @@
+// RC channel streaming over WebSocket (/ws/rc)
+// Pushes the latest RC channel values (rcChannels: active SBUS router input, CRSF or
+// MAVLink) as a packed binary frame at a client-selected rate of up to 100 Hz.
+// Values come from rc_channels_read() - a sequence-counter snapshot, so the bridge task
+// that publishes them never waits for the web side.
+//
+// Frame (RC_WS_FRAME_SIZE bytes, little-endian):
+//   [0]      source: (RC_SOURCE_* << 4) | input (SBUS router source id)
+//   [1]      flags:  RC_FLAG_* | RC_WS_FLAG_STALE
+//   [2..3]   age of the values in ms (0xFFFF = none yet / older)
+//   [4..25]  16 x 11-bit channels in microseconds (clamped to 0..2047), LSB first (SBUS bit order)
+//
+// Client -> server (text): {"rate":hz}   1..RC_WS_MAX_RATE_HZ, default RC_WS_DEFAULT_RATE_HZ
+// A frame is sent when the values changed, otherwise every RC_WS_KEEPALIVE_MS (age/stale).
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "rc_ws_frame.h"
+
+#define RC_WS_TICK_MS           10      // Scheduler poll interval (100 Hz)
+#define RC_WS_MAX_RATE_HZ       100
+#define RC_WS_DEFAULT_RATE_HZ   25
+#define RC_WS_KEEPALIVE_MS      1000
+#define RC_WS_MAX_CLIENTS       4
+#define RC_WS_MAX_QUEUED        2       // Frames waiting in AsyncWebSocket queue before skipping
+
+// Create /ws/rc on the server / drop it (web server stop)
+void rc_ws_attach(AsyncWebServer* server);
+void rc_ws_detach();
+
+// Push due frames to connected clients (scheduler)
+void rc_ws_poll();
@@ -0,0 +1,26 @@
+#include "rc_ws_frame.h"
+
+void rc_ws_encode(const RcChannelSnapshot& rc, uint32_t nowMs, uint8_t* out) {
+    uint32_t age = rc.lastUpdateMs ? nowMs - rc.lastUpdateMs : UINT32_MAX;
+
+    out[0] = (uint8_t)((rc.source << 4) | (rc.input & 0x0F));
+    out[1] = rc.flags | ((age > RC_WS_STALE_MS) ? RC_WS_FLAG_STALE : 0);
+    uint16_t age16 = (age > 0xFFFF) ? 0xFFFF : (uint16_t)age;
+    out[2] = age16 & 0xFF;
+    out[3] = age16 >> 8;
+
+    // 16 x 11 bits = 22 bytes, LSB first
+    uint8_t* p = out + 4;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (int i = 0; i < RC_CHANNEL_COUNT; i++) {
+        uint32_t v = (rc.channels[i] > 0x7FF) ? 0x7FF : rc.channels[i];
+        acc |= v << bits;
+        bits += 11;
+        while (bits >= 8) {
+            *p++ = acc & 0xFF;
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+}
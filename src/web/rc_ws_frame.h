@@ -0,0 +1,13 @@
+// /ws/rc binary frame encoder (frame layout: see rc_ws.h)
+// Kept apart from the WebSocket handling so it has no web server dependency.
+#pragma once
+
+#include <stdint.h>
+#include "../protocols/rc_channels.h"
+
+#define RC_WS_FRAME_SIZE        26
+#define RC_WS_STALE_MS          500     // No update for this long sets RC_WS_FLAG_STALE
+#define RC_WS_FLAG_STALE        0x80
+
+// Encode snapshot into out[RC_WS_FRAME_SIZE]
+void rc_ws_encode(const RcChannelSnapshot& rc, uint32_t nowMs, uint8_t* out);
@@ -0,0 +1,162 @@
+#include "stats_delta.h"
+#include "logging.h"
+
+static constexpr uint32_t FNV_OFFSET = 2166136261u;
+static constexpr uint32_t FNV_PRIME = 16777619u;
+
+// Print sink that hashes serialized JSON without a buffer
+class HashPrint : public Print {
+public:
+    uint32_t hash = FNV_OFFSET;
+
+    size_t write(uint8_t c) override {
+        hash = (hash ^ c) * FNV_PRIME;
+        return 1;
+    }
+
+    size_t write(const uint8_t* buf, size_t len) override {
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ buf[i]) * FNV_PRIME;
+        }
+        return len;
+    }
+};
+
+static uint32_t pathHash(uint32_t parent, const char* key) {
+    uint32_t h = (parent ^ '/') * FNV_PRIME;
+    while (*key) {
+        h = (h ^ (uint8_t)*key++) * FNV_PRIME;
+    }
+    return h ? h : 1;
+}
+
+static bool isSkipped(const char* key, const char* const* skipKeys, size_t skipCount) {
+    for (size_t i = 0; i < skipCount; i++) {
+        if (strcmp(key, skipKeys[i]) == 0) return true;
+    }
+    return false;
+}
+
+bool StatsDelta::begin() {
+    if (!leaves) {
+        leaves = static_cast<Leaf*>(calloc(STATS_WS_MAX_LEAVES, sizeof(Leaf)));
+        if (!leaves) return false;
+    } else {
+        memset(leaves, 0, STATS_WS_MAX_LEAVES * sizeof(Leaf));
+    }
+    sampleGen = 0;
+    fullGen = 0;
+    leavesFullLogged = false;
+    return true;
+}
+
+void StatsDelta::end() {
+    free(leaves);
+    leaves = nullptr;
+}
+
+// Open addressing lookup, nullptr if absent (or table full on insert)
+StatsDelta::Leaf* StatsDelta::findLeaf(uint32_t path, bool insert) const {
+    const size_t mask = STATS_WS_MAX_LEAVES - 1;
+    size_t slot = path & mask;
+    for (size_t i = 0; i < STATS_WS_MAX_LEAVES; i++, slot = (slot + 1) & mask) {
+        Leaf& leaf = leaves[slot];
+        if (leaf.path == path) return &leaf;
+        if (leaf.path == 0) {
+            if (!insert) return nullptr;
+            leaf = {path, 0, 0, 0};
+            return &leaf;
+        }
+    }
+    return nullptr;
+}
+
+// Update field table from current sample
+void StatsDelta::trackFields(JsonObjectConst obj, uint32_t parent) {
+    for (JsonPairConst kv : obj) {
+        uint32_t path = pathHash(parent, kv.key().c_str());
+        JsonVariantConst value = kv.value();
+
+        if (value.is<JsonObjectConst>()) {
+            trackFields(value.as<JsonObjectConst>(), path);
+            continue;
+        }
+
+        Leaf* leaf = findLeaf(path, true);
+        if (!leaf) {
+            // Untracked fields go into every delta
+            if (!leavesFullLogged) {
+                log_msg(LOG_WARNING, "Stats WS: more than %d fields, extra fields sent every time",
+                        STATS_WS_MAX_LEAVES);
+                leavesFullLogged = true;
+            }
+            continue;
+        }
+
+        HashPrint h;
+        serializeJson(value, h);
+        if (leaf->seenGen == 0 || leaf->value != h.hash) {
+            leaf->value = h.hash;
+            leaf->changedGen = sampleGen;
+        }
+        leaf->seenGen = sampleGen;
+    }
+}
+
+// Fields missing from this sample can't be expressed as a delta - resync everyone
+void StatsDelta::dropMissingFields() {
+    bool removed = false;
+    for (size_t i = 0; i < STATS_WS_MAX_LEAVES; i++) {
+        Leaf& leaf = leaves[i];
+        if (leaf.path && leaf.seenGen && leaf.seenGen != sampleGen) {
+            leaf.seenGen = 0;
+            removed = true;
+        }
+    }
+    if (removed) {
+        fullGen = sampleGen;
+    }
+}
+
+uint32_t StatsDelta::track(JsonObjectConst status) {
+    if (!leaves) return 0;
+    sampleGen++;
+    trackFields(status, FNV_OFFSET);
+    dropMissingFields();
+    return sampleGen;
+}
+
+bool StatsDelta::collectFields(JsonObjectConst src, JsonObject dst, uint32_t parent, uint32_t sinceGen,
+                               const char* const* skipKeys, size_t skipCount) const {
+    bool any = false;
+    for (JsonPairConst kv : src) {
+        const char* key = kv.key().c_str();
+        if (skipCount && isSkipped(key, skipKeys, skipCount)) continue;
+
+        uint32_t path = pathHash(parent, key);
+        JsonVariantConst value = kv.value();
+
+        if (value.is<JsonObjectConst>()) {
+            JsonObject child = dst[key].to<JsonObject>();
+            if (collectFields(value.as<JsonObjectConst>(), child, path, sinceGen, nullptr, 0)) {
+                any = true;
+            } else {
+                dst.remove(key);
+            }
+            continue;
+        }
+
+        Leaf* leaf = findLeaf(path, false);
+        if (!leaf || leaf->changedGen > sinceGen) {
+            dst[key] = value;
+            any = true;
+        }
+    }
+    return any;
+}
+
+bool StatsDelta::collect(JsonObjectConst src, JsonObject dst, uint32_t sinceSample,
+                         const char* const* skipKeys, size_t skipCount) const {
+    if (!leaves) return false;
+    return collectFields(src, dst, FNV_OFFSET, sinceSample, skipKeys, skipCount);
+}
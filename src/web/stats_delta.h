@@ -0,0 +1,51 @@
+// Field change tracking for /ws/stats deltas
+// Every leaf of the status document remembers (by path hash) the sample that last
+// changed its serialized value, so a client's delta is simply "fields changed after
+// the sample it got last". Nested objects are tracked per field, arrays as one value.
+// A field that disappears can't be expressed as a delta: fullSample() moves on and
+// clients behind it need a full snapshot.
+// Not thread-safe - one owner (the stats WebSocket poll).
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define STATS_WS_MAX_LEAVES         256     // Tracked fields (power of 2)
+
+class StatsDelta {
+public:
+    // Allocate the field table / release it. begin() starts again at sample 0.
+    bool begin();
+    void end();
+
+    // Record the next sample, returns its number (0 if not begun)
+    uint32_t track(JsonObjectConst status);
+
+    uint32_t sample() const { return sampleGen; }
+    uint32_t fullSample() const { return fullGen; }
+
+    // Copy fields changed after sinceSample into dst (sinceSample 0 = everything).
+    // Top-level keys listed in skipKeys are left out. Returns false if nothing changed.
+    bool collect(JsonObjectConst src, JsonObject dst, uint32_t sinceSample,
+                 const char* const* skipKeys = nullptr, size_t skipCount = 0) const;
+
+private:
+    // One tracked field (leaf of the status document)
+    struct Leaf {
+        uint32_t path;          // Path hash, 0 = free slot
+        uint32_t value;         // Hash of serialized value
+        uint32_t changedGen;    // Sample that last changed the value
+        uint32_t seenGen;       // Last sample containing the field, 0 = gone
+    };
+
+    Leaf* leaves = nullptr;
+    uint32_t sampleGen = 0;
+    uint32_t fullGen = 0;
+    bool leavesFullLogged = false;
+
+    Leaf* findLeaf(uint32_t path, bool insert) const;
+    void trackFields(JsonObjectConst obj, uint32_t parent);
+    void dropMissingFields();
+    bool collectFields(JsonObjectConst src, JsonObject dst, uint32_t parent, uint32_t sinceGen,
+                       const char* const* skipKeys, size_t skipCount) const;
+};
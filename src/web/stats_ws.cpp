@@ -0,0 +1,268 @@
+#include "stats_ws.h"
+#include "stats_delta.h"
+#include "web_api.h"
+#include "logging.h"
+#include "config.h"
+#include "../device_types.h"
+#include "esp_heap_caps.h"
+#include <ArduinoJson.h>
+
+extern Config config;
+
+// High-rate counters carried by the binary frame (order is the wire format)
+static const char* const STATS_WS_COUNTER_KEYS[] = {
+    "uptime", "freeRam", "totalTraffic",
+    "device1Rx", "device1Tx", "device2Rx", "device2Tx", "device3Rx", "device3Tx",
+    "device4RxBytes", "device4TxBytes", "device4RxPackets", "device4TxPackets",
+    "device5RxBytes", "device5TxBytes",
+};
+static constexpr size_t STATS_WS_COUNTER_COUNT = sizeof(STATS_WS_COUNTER_KEYS) / sizeof(STATS_WS_COUNTER_KEYS[0]);
+static constexpr size_t STATS_WS_BIN_SIZE = 8 + STATS_WS_COUNTER_COUNT * sizeof(uint32_t);
+
+struct StatsClient {
+    uint32_t id;            // WebSocket client id, 0 = free slot
+    uint32_t intervalMs;
+    uint32_t nextMs;
+    uint32_t sentGen;       // Sample covered by last frame, 0 = needs full snapshot
+    bool binary;            // Counters as binary frame
+};
+
+static AsyncWebSocket* statsWs = nullptr;
+static char* frameBuf = nullptr;
+static StatsDelta tracker;              // Field changes per sample, shared by all clients
+
+// Client slots - written by WebSocket events (async_tcp task), read by poll (scheduler)
+static StatsClient clients[STATS_WS_MAX_CLIENTS];
+static portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Wrap data as {"seq":N[,"full":true],"data":...} in frameBuf. Returns length, 0 if too large.
+static size_t buildFrame(JsonVariantConst data, bool full) {
+    int header = snprintf(frameBuf, STATS_WS_FRAME_SIZE,
+                          full ? "{\"seq\":%lu,\"full\":true,\"data\":" : "{\"seq\":%lu,\"data\":",
+                          (unsigned long)tracker.sample());
+    size_t body = measureJson(data);
+    if (header + body + 2 > STATS_WS_FRAME_SIZE) {
+        log_msg(LOG_WARNING, "Stats WS: frame of %zu bytes exceeds %d", header + body + 1, STATS_WS_FRAME_SIZE);
+        return 0;
+    }
+    serializeJson(data, frameBuf + header, STATS_WS_FRAME_SIZE - header);
+    frameBuf[header + body] = '}';
+    frameBuf[header + body + 1] = '\0';
+    return header + body + 1;
+}
+
+static void buildCounters(JsonObjectConst status, uint8_t* out) {
+    out[0] = STATS_WS_BIN_COUNTERS;
+    out[1] = STATS_WS_COUNTER_COUNT;
+    out[2] = 0;
+    out[3] = 0;
+    uint32_t seq = tracker.sample();
+    memcpy(out + 4, &seq, sizeof(uint32_t));            // ESP32 is little-endian
+    for (size_t i = 0; i < STATS_WS_COUNTER_COUNT; i++) {
+        uint32_t v = status[STATS_WS_COUNTER_KEYS[i]] | (uint32_t)0;
+        memcpy(out + 8 + i * sizeof(uint32_t), &v, sizeof(uint32_t));
+    }
+}
+
+static bool sbusInputConfigured() {
+    return config.device1.role == D1_SBUS_IN ||
+           config.device2.role == D2_SBUS_IN ||
+           config.device3.role == D3_SBUS_IN ||
+           config.device4.role == D4_SBUS_UDP_RX;
+}
+
+static void onStatsWsEvent(AsyncWebSocket* ws, AsyncWebSocketClient* client,
+                           AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    uint32_t id = client->id();
+
+    if (type == WS_EVT_CONNECT) {
+        uint32_t now = millis();
+        bool added = false;
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id == 0) {
+                c = {id, STATS_WS_DEFAULT_INTERVAL, now, 0, false};
+                added = true;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&clientsMux);
+
+        if (!added) {
+            log_msg(LOG_WARNING, "Stats WS: too many clients, #%u rejected", id);
+            client->close();
+            return;
+        }
+        log_msg(LOG_INFO, "Stats WS client #%u connected", id);
+
+    } else if (type == WS_EVT_DISCONNECT) {
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id == id) c.id = 0;
+        }
+        portEXIT_CRITICAL(&clientsMux);
+        log_msg(LOG_INFO, "Stats WS client #%u disconnected", id);
+
+    } else if (type == WS_EVT_DATA) {
+        // Settings: single unfragmented text frame
+        AwsFrameInfo* info = (AwsFrameInfo*)arg;
+        if (info->opcode != WS_TEXT || !info->final || info->index != 0 || info->len != len) return;
+
+        JsonDocument req;
+        if (deserializeJson(req, data, len)) return;
+
+        uint32_t interval = req["interval"] | (uint32_t)0;
+        if (interval) {
+            interval = constrain(interval, (uint32_t)STATS_WS_MIN_INTERVAL_MS, (uint32_t)STATS_WS_MAX_INTERVAL_MS);
+        }
+        bool setBinary = req["binary"].is<bool>();
+        bool binary = req["binary"] | false;
+        uint32_t now = millis();
+
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& c : clients) {
+            if (c.id != id) continue;
+            if (interval) {
+                c.intervalMs = interval;
+                c.nextMs = now;
+            }
+            if (setBinary && binary != c.binary) {
+                c.binary = binary;
+                c.sentGen = 0;      // Counters were left out of deltas - resend everything
+            }
+        }
+        portEXIT_CRITICAL(&clientsMux);
+
+        log_msg(LOG_DEBUG, "Stats WS client #%u: interval %lu ms, binary %d", id,
+                (unsigned long)(interval ? interval : STATS_WS_DEFAULT_INTERVAL), binary);
+    }
+}
+
+void stats_ws_attach(AsyncWebServer* server) {
+    if (statsWs) return;
+
+    bool tracking = tracker.begin();
+    frameBuf = static_cast<char*>(heap_caps_malloc(STATS_WS_FRAME_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!frameBuf) {
+        frameBuf = static_cast<char*>(heap_caps_malloc(STATS_WS_FRAME_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    if (!tracking || !frameBuf) {
+        log_msg(LOG_ERROR, "Stats WS: buffer allocation failed, /ws/stats disabled");
+        tracker.end();
+        free(frameBuf);
+        frameBuf = nullptr;
+        return;
+    }
+
+    memset(clients, 0, sizeof(clients));
+
+    statsWs = new AsyncWebSocket("/ws/stats");
+    statsWs->onEvent(onStatsWsEvent);
+    server->addHandler(statsWs);
+    log_msg(LOG_INFO, "Stats WebSocket endpoint created: /ws/stats");
+}
+
+void stats_ws_detach() {
+    if (!statsWs) return;
+
+    statsWs->closeAll();
+    statsWs = nullptr;  // Owned by server, deleted with it
+
+    portENTER_CRITICAL(&clientsMux);
+    memset(clients, 0, sizeof(clients));
+    portEXIT_CRITICAL(&clientsMux);
+
+    tracker.end();
+    free(frameBuf);
+    frameBuf = nullptr;
+}
+
+void stats_ws_poll() {
+    if (!statsWs) return;
+    statsWs->cleanupClients();
+    if (statsWs->count() == 0) return;
+
+    uint32_t now = millis();
+
+    StatsClient due[STATS_WS_MAX_CLIENTS];
+    size_t dueCount = 0;
+    portENTER_CRITICAL(&clientsMux);
+    for (const auto& c : clients) {
+        if (c.id && (int32_t)(now - c.nextMs) >= 0) {
+            due[dueCount++] = c;
+        }
+    }
+    portEXIT_CRITICAL(&clientsMux);
+    if (dueCount == 0) return;
+
+    // One sample shared by all due clients
+    JsonDocument doc;
+    populateStatusJson(doc);
+    if (sbusInputConfigured()) {
+        populateSbusStatus(doc["sbus"].to<JsonObject>());
+    }
+    JsonObjectConst status = doc.as<JsonObjectConst>();
+
+    uint32_t sampleGen = tracker.track(status);
+
+    uint8_t counters[STATS_WS_BIN_SIZE];
+    bool countersBuilt = false;
+
+    // Clients that start from the same sample share one frame
+    bool frameBuilt = false;
+    uint32_t frameSince = 0;
+    bool frameSkipCounters = false;
+    size_t frameLen = 0;
+
+    for (size_t i = 0; i < dueCount; i++) {
+        StatsClient& c = due[i];
+        uint32_t sentGen = c.sentGen;
+        bool sent = false;
+
+        AsyncWebSocketClient* client = statsWs->client(c.id);
+        if (client && client->status() == WS_CONNECTED &&
+            client->canSend() && client->queueLen() < STATS_WS_MAX_QUEUED) {
+
+            bool full = (c.sentGen == 0 || c.sentGen < tracker.fullSample());
+            uint32_t since = full ? 0 : c.sentGen;
+            bool skipCounters = c.binary && !full;
+
+            if (!frameBuilt || since != frameSince || skipCounters != frameSkipCounters) {
+                if (full) {
+                    frameLen = buildFrame(status, true);
+                } else {
+                    JsonDocument delta;
+                    JsonObject changes = delta.to<JsonObject>();
+                    frameLen = tracker.collect(status, changes, since, STATS_WS_COUNTER_KEYS,
+                                               skipCounters ? STATS_WS_COUNTER_COUNT : 0)
+                             ? buildFrame(changes, false) : 0;
+                }
+                frameBuilt = true;
+                frameSince = since;
+                frameSkipCounters = skipCounters;
+            }
+
+            if (frameLen) {
+                client->text(frameBuf, frameLen);
+            }
+            if (skipCounters) {
+                if (!countersBuilt) {
+                    buildCounters(status, counters);
+                    countersBuilt = true;
+                }
+                client->binary(counters, sizeof(counters));
+            }
+            sent = true;
+        }
+        // Busy client: skipped, its next frame covers everything it missed
+
+        portENTER_CRITICAL(&clientsMux);
+        for (auto& slot : clients) {
+            if (slot.id != c.id) continue;
+            slot.nextMs = now + slot.intervalMs;
+            // Settings change may have requested a resync meanwhile
+            if (sent && slot.sentGen == sentGen) slot.sentGen = sampleGen;
+        }
+        portEXIT_CRITICAL(&clientsMux);
+    }
+}
@@ -0,0 +1,39 @@
+// Live statistics push over WebSocket (/ws/stats)
+// Replaces HTTP polling of /api/status and /sbus/status while the page is open.
+//
+// Protocol (server -> client):
+//   {"seq":N,"full":true,"data":{...}}    complete status on connect (and after a field disappears)
+//   {"seq":N,"data":{...}}                only fields changed since this client's previous frame
+//   binary counters frame (opt-in), little-endian:
+//     [0] STATS_WS_BIN_COUNTERS  [1] count  [2..3] reserved  [4..7] seq  [8..] count x uint32
+//     values in STATS_WS_COUNTER_KEYS order; these keys are then left out of JSON deltas.
+//     Sent on every push after the JSON delta (if any), so the client can apply both at once.
+//
+// Client -> server (text): {"interval":ms,"binary":true|false}
+//   interval clamped to STATS_WS_MIN_INTERVAL_MS..STATS_WS_MAX_INTERVAL_MS (default 1000)
+//
+// "data" has the /api/status layout, plus "sbus" (/sbus/status layout) when an SBUS input
+// is configured. Nested objects are diffed per field, arrays are sent whole when any
+// element changed. Status is sampled once per tick for all due clients; a client whose
+// send queue is busy is skipped and its next frame covers everything it missed.
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#define STATS_WS_TICK_MS            50      // Scheduler poll interval
+#define STATS_WS_MIN_INTERVAL_MS    100     // 10 Hz max per client
+#define STATS_WS_MAX_INTERVAL_MS    10000
+#define STATS_WS_DEFAULT_INTERVAL   1000
+#define STATS_WS_MAX_CLIENTS        4
+#define STATS_WS_MAX_QUEUED         2       // Frames waiting in AsyncWebSocket queue before skipping
+#define STATS_WS_FRAME_SIZE         6144    // Largest JSON frame
+
+#define STATS_WS_BIN_COUNTERS       0x01    // Binary frame type
+
+// Create /ws/stats on the server / drop it (web server stop)
+void stats_ws_attach(AsyncWebServer* server);
+void stats_ws_detach();
+
+// Push due frames to connected clients (scheduler)
+void stats_ws_poll();
@@ -8,13 +8,19 @@
 #include "../uart/uartbridge.h"
 #include "defines.h"
 #include "crashlog.h"
+#include "boot_profile.h"
 #include "diagnostics.h"
 #include "scheduler_tasks.h"
 #include "../wifi/wifi_manager.h"
 #include "protocols/protocol_pipeline.h"
 #include "protocols/sbus_router.h"
 #include "protocols/sbus_fast_parser.h"
+#include "protocols/sbus_udp_envelope.h"
+#include "protocols/rc_text_format.h"
+#include "protocols/terminal_triggers.h"
 #include "protocols/rc_channels.h"
+#include "protocols/packet_capture.h"
+#include "protocols/mavlink_msg_stats.h"
 #if defined(MINIKIT_BT_ENABLED)
 #include "../bluetooth/bluetooth_spp.h"
 #endif
@@ -188,8 +194,13 @@ static void populateApiConfig(JsonDocument& doc) {
     doc["device4TargetIp"] = config.device4_config.target_ip;
     doc["device4Port"] = config.device4_config.port;
     doc["device4AutoBroadcast"] = config.device4_config.auto_broadcast;
+    doc["device4LearnPeers"] = config.device4_config.learn_peers;
+    doc["device4Transport"] = config.device4_config.transport;
+    doc["device4TcpSlowPolicy"] = config.device4_config.tcpSlowPolicy;
     doc["device4UdpTimeout"] = config.device4_config.udpSourceTimeout;
     doc["device4OutRate"] = config.device4_config.udpSendRate;
+    doc["device4SbusEnvelope"] = config.device4_config.sbusEnvelope;
+    doc["device4SbusRedundancy"] = config.device4_config.sbusRedundancy;
 
     // SBUS output format and rate options
     doc["device2SbusFormat"] = config.device2.sbusOutputFormat;
@@ -215,17 +226,27 @@ static void populateApiConfig(JsonDocument& doc) {
     doc["udpBatchingEnabled"] = config.udpBatchingEnabled;
     doc["mavlinkRouting"] = config.mavlinkRouting;
     doc["terminalAnsi"] = config.terminalAnsi;
+    doc["terminalFlushMs"] = config.terminalFlushMs;
+    doc["terminalTriggers"] = config.terminalTriggers;
+    doc["sbusOutputPeriod"] = config.sbusOutputPeriod;
+    doc["rcTextFormat"] = config.rcTextFormat;
+    JsonArray crsfRates = doc["crsfBinaryRates"].to<JsonArray>();
+    for (int i = 0; i < CRSF_RATE_GROUPS; i++) {
+        crsfRates.add(config.crsfBinaryRate[i]);
+    }
 
     // Log display count
     doc["logDisplayCount"] = LOG_DISPLAY_COUNT;
 }
 
+static uint32_t statusUptimeSeconds() {
+    return (millis() - g_deviceStats.systemStartTime.load(std::memory_order_relaxed)) / MS_TO_SECONDS;
+}
+
 // Populate JSON with runtime status (for /api/status)
+// uptime/freeRam change on every poll and would defeat the snapshot ETag -
+// /api/status sends them as headers, /ws/stats adds them via populateStatusJson()
 static void populateApiStatus(JsonDocument& doc) {
-    // Runtime system info
-    doc["uptime"] = (millis() - g_deviceStats.systemStartTime.load(std::memory_order_relaxed)) / MS_TO_SECONDS;
-    doc["freeRam"] = ESP.getFreeHeap();
-
     // WiFi client status
     if (config.wifi_mode == BRIDGE_WIFI_MODE_CLIENT) {
         doc["wifiClientConnected"] = systemState.wifiClientConnected;
@@ -334,25 +355,132 @@ static void populateApiStatus(JsonDocument& doc) {
 
     // UDP batching setting
     doc["udpBatchingEnabled"] = config.udpBatchingEnabled;
+}
+
+// Full runtime status including protocol statistics (for /ws/stats)
+void populateStatusJson(JsonDocument& doc) {
+    doc["uptime"] = statusUptimeSeconds();
+    doc["freeRam"] = ESP.getFreeHeap();
+    populateApiStatus(doc);
 
-    // Protocol statistics
     BridgeContext* ctx = getBridgeContext();
     if (ctx && ctx->protocolPipeline) {
         ctx->protocolPipeline->appendStatsToJson(doc);
     }
 }
 
+// =========================================================================
+// /api/status snapshot
+// =========================================================================
+// Status JSON is rendered into a preallocated buffer at most once per
+// STATUS_SNAPSHOT_INTERVAL_MS (scheduler, only while someone is polling) and every
+// request is served from that buffer. Protocol statistics - the bulk of the document -
+// are rendered into their own buffer and refreshed every STATUS_PROTOCOL_INTERVAL_MS.
+// Responses carry an ETag, an unchanged snapshot is answered with 304.
+
+static SemaphoreHandle_t statusMutex = nullptr;   // Guards everything below
+static char* statusBuf = nullptr;                 // Complete response body
+static size_t statusLen = 0;
+static char statusEtag[12] = "";                  // Quoted 32-bit hash
+static uint32_t statusBuiltMs = 0;
+static char* protocolBuf = nullptr;               // {"protocolStats":...}
+static size_t protocolLen = 0;
+static uint32_t protocolBuiltMs = 0;
+static volatile uint32_t statusLastRequestMs = 0;
+
+static char* allocStatusBuffer(size_t size) {
+    char* buf = static_cast<char*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!buf) {
+        buf = static_cast<char*>(heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    return buf;
+}
+
+// Serialize into fixed buffer, false if it does not fit
+static bool serializeToBuffer(JsonDocument& doc, char* buf, size_t size, size_t& len, const char* what) {
+    size_t needed = measureJson(doc);
+    if (needed >= size) {
+        log_msg(LOG_WARNING, "Status %s needs %zu bytes, buffer is %zu", what, needed, size);
+        len = 0;
+        return false;
+    }
+    len = serializeJson(doc, buf, size);
+    return true;
+}
+
+// Render snapshot (caller holds statusMutex)
+static void renderStatusSnapshot(uint32_t now) {
+    if (!statusBuf) {
+        statusBuf = allocStatusBuffer(STATUS_SNAPSHOT_SIZE);
+        protocolBuf = allocStatusBuffer(STATUS_PROTOCOL_SIZE);
+        if (!statusBuf || !protocolBuf) {
+            log_msg(LOG_ERROR, "Status snapshot: buffer allocation failed");
+            free(statusBuf);
+            free(protocolBuf);
+            statusBuf = nullptr;
+            protocolBuf = nullptr;
+            return;
+        }
+    }
+
+    // Expensive section: pipeline, parser and sender statistics
+    if (protocolLen == 0 || (now - protocolBuiltMs) >= STATUS_PROTOCOL_INTERVAL_MS) {
+        JsonDocument doc;
+        BridgeContext* ctx = getBridgeContext();
+        if (ctx && ctx->protocolPipeline) {
+            ctx->protocolPipeline->appendStatsToJson(doc);
+        }
+        if (doc.isNull() || !serializeToBuffer(doc, protocolBuf, STATUS_PROTOCOL_SIZE, protocolLen, "protocol stats")) {
+            protocolLen = 0;
+        }
+        protocolBuiltMs = now;
+    }
+
+    // Cheap section: counters and system info
+    JsonDocument doc;
+    populateApiStatus(doc);
+    size_t len;
+    if (!serializeToBuffer(doc, statusBuf, STATUS_SNAPSHOT_SIZE, len, "snapshot")) {
+        statusLen = 0;
+        return;
+    }
+
+    // Splice: {cheap} + {protocol} -> {cheap,protocol}
+    if (protocolLen > 2 && len + protocolLen - 1 < STATUS_SNAPSHOT_SIZE) {
+        statusBuf[len - 1] = ',';
+        memcpy(statusBuf + len, protocolBuf + 1, protocolLen - 1);
+        len += protocolLen - 1;
+    }
+    statusLen = len;
+    statusBuiltMs = now;
+
+    // FNV-1a over the body
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)statusBuf[i]) * 16777619u;
+    }
+    snprintf(statusEtag, sizeof(statusEtag), "\"%08lx\"", (unsigned long)hash);
+}
+
+// Refresh snapshot from scheduler (skipped while nobody polls)
+void web_api_status_tick() {
+    if (!statusMutex) return;
+
+    uint32_t now = millis();
+    if ((now - statusLastRequestMs) > STATUS_IDLE_MS) return;
+    if (xSemaphoreTake(statusMutex, 0) != pdTRUE) return;
+
+    renderStatusSnapshot(now);
+    xSemaphoreGive(statusMutex);
+}
+
 // Helper function to populate JsonDocument with logs data
 static void populateLogsJson(JsonDocument& doc) {
     JsonArray logs = doc["logs"].to<JsonArray>();
 
-    String logBuffer[LOG_DISPLAY_COUNT];
-    int actualCount = 0;
-    logging_get_recent_logs(logBuffer, LOG_DISPLAY_COUNT, &actualCount);
-
-    for (int i = 0; i < actualCount; i++) {
-        logs.add(logBuffer[i]);
-    }
+    logging_for_each_recent(LOG_DISPLAY_COUNT, [](const char* line, void* ctx) {
+        static_cast<JsonArray*>(ctx)->add(line);
+    }, &logs);
 }
 
 void writeLogsJson(Print& output) {
@@ -379,13 +507,49 @@ void handleApiStatus(AsyncWebServerRequest *request) {
         resetWiFiTimeout();
     }
 
-    JsonDocument doc;
-    populateApiStatus(doc);
+    uint32_t now = millis();
+    statusLastRequestMs = now;
 
-    auto* res = request->beginResponseStream("application/json");
-    res->addHeader("Connection", "close");
-    serializeJson(doc, *res);
-    request->send(res);
+    // Handlers run on the async_tcp task only, no creation race
+    if (!statusMutex) {
+        statusMutex = xSemaphoreCreateMutex();
+    }
+    if (!statusMutex || xSemaphoreTake(statusMutex, pdMS_TO_TICKS(STATUS_LOCK_TIMEOUT_MS)) != pdTRUE) {
+        sendJsonError(request, 503, "Status busy");
+        return;
+    }
+
+    // Scheduler keeps the snapshot fresh while polled - first request after idle renders here
+    if (statusLen == 0 || (now - statusBuiltMs) >= 2 * STATUS_SNAPSHOT_INTERVAL_MS) {
+        renderStatusSnapshot(now);
+    }
+
+    if (statusLen == 0) {
+        xSemaphoreGive(statusMutex);
+        sendJsonError(request, 500, "Status unavailable");
+        return;
+    }
+
+    AsyncWebServerResponse* response;
+    const AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+    if (ifNoneMatch && ifNoneMatch->value() == statusEtag) {
+        response = request->beginResponse(304);
+    } else {
+        auto* res = request->beginResponseStream("application/json");
+        res->write(reinterpret_cast<const uint8_t*>(statusBuf), statusLen);
+        response = res;
+    }
+    response->addHeader("ETag", statusEtag);
+    xSemaphoreGive(statusMutex);
+
+    // Outside the hashed body, so they are current on 304 too
+    response->addHeader("X-Uptime", String(statusUptimeSeconds()));
+    response->addHeader("X-Free-Ram", String(ESP.getFreeHeap()));
+
+    // Browser revalidates every poll (If-None-Match) instead of reusing the body
+    response->addHeader("Cache-Control", "no-cache");
+    response->addHeader("Connection", "close");
+    request->send(response);
 }
 
 // Handle logs request
@@ -398,6 +562,40 @@ void handleLogs(AsyncWebServerRequest *request) {
     request->send(res);
 }
 
+// Push settings that config_requires_reboot() lets through to the running system
+static void applyLiveConfig(const Config& before) {
+    uint8_t flags = 0;
+    if (config.mavlinkRouting != before.mavlinkRouting) flags |= RECONFIG_MAVLINK_ROUTING;
+    if (config.terminalTriggers != before.terminalTriggers) flags |= RECONFIG_TERMINAL_TRIGGERS;
+    if (config.udpBatchingEnabled != before.udpBatchingEnabled ||
+        config.device2.outRate != before.device2.outRate ||
+        config.device2.crsfFilter != before.device2.crsfFilter ||
+        strcmp(config.device4_config.target_ip, before.device4_config.target_ip) != 0 ||
+        config.device4_config.udpSendRate != before.device4_config.udpSendRate ||
+        config.device4_config.crsfFilter != before.device4_config.crsfFilter ||
+        config.device4_config.sbusEnvelope != before.device4_config.sbusEnvelope ||
+        config.device4_config.sbusRedundancy != before.device4_config.sbusRedundancy
+#if defined(MINIKIT_BT_ENABLED) || defined(BLE_ENABLED)
+        || config.device5_config.btSendRate != before.device5_config.btSendRate
+        || config.device5_config.crsfFilter != before.device5_config.crsfFilter
+#endif
+        ) {
+        flags |= RECONFIG_SENDERS;
+    }
+
+    BridgeContext* ctx = getBridgeContext();
+    if (flags && ctx && ctx->protocolPipeline) {
+        ctx->protocolPipeline->requestReconfigure(flags, config);
+    }
+
+    if (config.device4_config.udpSourceTimeout != before.device4_config.udpSourceTimeout) {
+        SbusRouter::getInstance()->setUdpSourceTimeout(config.device4_config.udpSourceTimeout);
+    }
+
+    // Log levels, terminal ANSI and RC text format are read from config directly
+    log_msg(LOG_INFO, "Configuration applied without restart");
+}
+
 // Handle save configuration (JSON body)
 void handleSaveJson(AsyncWebServerRequest *request) {
     log_msg(LOG_INFO, "Saving new configuration (JSON)...");
@@ -425,6 +623,7 @@ void handleSaveJson(AsyncWebServerRequest *request) {
     }
 
     bool configChanged = false;
+    const Config before = config;  // Decides restart vs live apply at the end
 
     // UART settings
     if (doc.containsKey("baudrate") && doc["baudrate"] != config.baudrate) {
@@ -588,8 +787,8 @@ void handleSaveJson(AsyncWebServerRequest *request) {
     if (doc.containsKey("device4_target_ip")) {
         const char* ip = doc["device4_target_ip"];
         if (strcmp(ip, config.device4_config.target_ip) != 0) {
-            strncpy(config.device4_config.target_ip, ip, IP_ADDRESS_BUFFER_SIZE);
-            config.device4_config.target_ip[IP_ADDRESS_BUFFER_SIZE] = '\0';
+            strncpy(config.device4_config.target_ip, ip, sizeof(config.device4_config.target_ip) - 1);
+            config.device4_config.target_ip[sizeof(config.device4_config.target_ip) - 1] = '\0';
             configChanged = true;
             log_msg(LOG_INFO, "Device 4 target IP: %s", ip);
         }
@@ -613,6 +812,33 @@ void handleSaveJson(AsyncWebServerRequest *request) {
         }
     }
 
+    if (doc.containsKey("device4_learn_peers")) {
+        bool newVal = doc["device4_learn_peers"];
+        if (newVal != config.device4_config.learn_peers) {
+            config.device4_config.learn_peers = newVal;
+            configChanged = true;
+            log_msg(LOG_INFO, "Device 4 peer learning: %s", newVal ? "enabled" : "disabled");
+        }
+    }
+
+    if (doc.containsKey("device4_transport")) {
+        uint8_t transport = doc["device4_transport"];
+        if (transport <= D4_TRANSPORT_TCP && transport != config.device4_config.transport) {
+            config.device4_config.transport = transport;
+            configChanged = true;
+            log_msg(LOG_INFO, "Device 4 transport: %s", transport == D4_TRANSPORT_TCP ? "TCP" : "UDP");
+        }
+    }
+
+    if (doc.containsKey("device4_tcp_slow_policy")) {
+        uint8_t policy = doc["device4_tcp_slow_policy"];
+        if (policy <= 1 && policy != config.device4_config.tcpSlowPolicy) {
+            config.device4_config.tcpSlowPolicy = policy;
+            configChanged = true;
+            log_msg(LOG_INFO, "Device 4 TCP slow clients: %s", policy ? "disconnect" : "drop");
+        }
+    }
+
     if (doc.containsKey("device4_udp_timeout")) {
         uint16_t timeout = doc["device4_udp_timeout"];
         if (timeout >= 100 && timeout <= 5000 && timeout != config.device4_config.udpSourceTimeout) {
@@ -631,6 +857,24 @@ void handleSaveJson(AsyncWebServerRequest *request) {
         }
     }
 
+    if (doc.containsKey("device4_sbus_envelope")) {
+        bool newVal = doc["device4_sbus_envelope"];
+        if (newVal != config.device4_config.sbusEnvelope) {
+            config.device4_config.sbusEnvelope = newVal;
+            configChanged = true;
+            log_msg(LOG_INFO, "Device 4 SBUS envelope: %s", newVal ? "enabled" : "disabled");
+        }
+    }
+
+    if (doc.containsKey("device4_sbus_redundancy")) {
+        uint8_t redundancy = doc["device4_sbus_redundancy"];
+        if (redundancy <= SBUS_UDP_MAX_REDUNDANCY && redundancy != config.device4_config.sbusRedundancy) {
+            config.device4_config.sbusRedundancy = redundancy;
+            configChanged = true;
+            log_msg(LOG_INFO, "Device 4 SBUS redundancy: %u", redundancy);
+        }
+    }
+
     if (doc.containsKey("device4_crsf_filter")) {
         uint8_t filter = doc["device4_crsf_filter"];
         if ((filter & ~CRSF_FILTER_ALL) == 0 && filter != config.device4_config.crsfFilter) {
@@ -705,6 +949,7 @@ void handleSaveJson(AsyncWebServerRequest *request) {
             log_msg(LOG_INFO, "Network log level: %s", getLogLevelName((LogLevel)level));
         }
     }
+    logging_update_level();
 
     // Protocol optimization
     if (doc.containsKey("protocol_optimization")) {
@@ -713,13 +958,7 @@ void handleSaveJson(AsyncWebServerRequest *request) {
             config.protocolOptimization = newProtocol;
             configChanged = true;
             log_msg(LOG_INFO, "Protocol optimization: %d", newProtocol);
-
-            BridgeContext* ctx = getBridgeContext();
-            if (ctx && ctx->protocolPipeline) {
-                delete ctx->protocolPipeline;
-                ctx->protocolPipeline = new ProtocolPipeline(ctx);
-                ctx->protocolPipeline->init(&config);
-            }
+            // Parsers are rebuilt by the restart (config_requires_reboot)
         }
     }
 
@@ -750,6 +989,58 @@ void handleSaveJson(AsyncWebServerRequest *request) {
         }
     }
 
+    if (doc.containsKey("terminal_flush_ms")) {
+        uint8_t flushMs = doc["terminal_flush_ms"];
+        if (flushMs >= 10 && flushMs <= 200 && flushMs != config.terminalFlushMs) {
+            config.terminalFlushMs = flushMs;
+            configChanged = true;
+            log_msg(LOG_INFO, "Terminal flush interval: %u ms", flushMs);
+        }
+    }
+
+    if (doc.containsKey("terminal_triggers")) {
+        String triggers = doc["terminal_triggers"].as<String>();
+        if (triggers.length() > TERMINAL_TRIGGER_SPEC_MAX) {
+            sendJsonError(request, 400, "Terminal triggers too long (max 512 characters)");
+            return;
+        }
+        if (triggers != config.terminalTriggers) {
+            config.terminalTriggers = triggers;
+            configChanged = true;
+            log_msg(LOG_INFO, "Terminal triggers updated");
+        }
+    }
+
+    if (doc.containsKey("sbus_output_period")) {
+        uint8_t period = doc["sbus_output_period"];
+        if (isValidSbusOutputPeriod(period) && period != config.sbusOutputPeriod) {
+            config.sbusOutputPeriod = period;
+            configChanged = true;
+            log_msg(LOG_INFO, "SBUS output period: %u ms", period);
+        }
+    }
+
+    if (doc.containsKey("rc_text_format")) {
+        uint8_t fmt = doc["rc_text_format"];
+        if (fmt <= RC_TEXT_R2D2 && fmt != config.rcTextFormat) {
+            config.rcTextFormat = fmt;
+            configChanged = true;
+            log_msg(LOG_INFO, "RC text format: %s", fmt == RC_TEXT_R2D2 ? "R2D2" : "ESP-Bridge");
+        }
+    }
+
+    if (doc["crsf_binary_rates"].is<JsonArray>()) {
+        JsonArray rates = doc["crsf_binary_rates"];
+        for (int i = 0; i < CRSF_RATE_GROUPS && i < (int)rates.size(); i++) {
+            uint8_t hz = (uint8_t)constrain((int)(rates[i] | 0), 0, 100);
+            if (hz != config.crsfBinaryRate[i]) {
+                config.crsfBinaryRate[i] = hz;
+                configChanged = true;
+                log_msg(LOG_INFO, "CRSF binary rate group %d: %u Hz", i, hz);
+            }
+        }
+    }
+
     // WiFi settings
     if (doc.containsKey("ssid")) {
         String newSSID = doc["ssid"].as<String>();
@@ -891,7 +1182,12 @@ void handleSaveJson(AsyncWebServerRequest *request) {
         }
     }
 
-    if (configChanged) {
+    if (configChanged && !config_requires_reboot(&before, &config)) {
+        config_save(&config);
+        applyLiveConfig(before);
+        request->send(200, "application/json",
+            "{\"status\":\"ok\",\"message\":\"Configuration applied\",\"reboot\":false}");
+    } else if (configChanged) {
         cancelWiFiTimeout();
         config_save(&config);
 
@@ -915,6 +1211,7 @@ void handleResetStats(AsyncWebServerRequest *request) {
         ctx->protocol.stats->reset();
         log_msg(LOG_INFO, "Protocol statistics reset");
     }
+    MavlinkMsgStats::getInstance()->requestReset();
 
     logging_clear();
 
@@ -934,6 +1231,16 @@ void handleClearCrashLog(AsyncWebServerRequest *request) {
     sendJsonOk(request);
 }
 
+// GET /api/boot - boot phase timings, this boot and the previous ones kept in RTC memory
+void handleBootProfile(AsyncWebServerRequest *request) {
+    JsonDocument doc;
+    boot_profile_to_json(doc);
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
 // Handle browser time sync (once per boot)
 void handleTimeSync(AsyncWebServerRequest *request) {
     if (!request->hasParam("epoch")) {
@@ -1042,8 +1349,20 @@ void handleImportConfig(AsyncWebServerRequest *request) {
     delete importData;
     request->_tempObject = nullptr;
 
-    // Apply imported configuration
+    // Apply imported configuration - same live/restart split as handleSaveJson
+    const Config before = config;
     config = tempConfig;
+
+    if (!config_requires_reboot(&before, &config)) {
+        config_save(&config);
+        applyLiveConfig(before);
+        log_msg(LOG_INFO, "Configuration imported and applied without restart");
+        request->send(200, "application/json",
+            "{\"status\":\"ok\",\"message\":\"Configuration imported and applied\",\"reboot\":false}");
+        return;
+    }
+
+    cancelWiFiTimeout();
     config_save(&config);
 
     log_msg(LOG_INFO, "Configuration imported successfully, restarting...");
@@ -1136,11 +1455,8 @@ static void addSbusSourceToJson(JsonArray& sources, SbusRouter* router,
     src["framesReceived"] = router->getSourceFramesReceived(sourceId);
 }
 
-// Get current SBUS source status
-void handleSbusStatus(AsyncWebServerRequest *request) {
-    JsonDocument doc;
-    doc["status"] = "ok";
-
+// SBUS router state, sources and link statistics (for /sbus/status and /ws/stats)
+void populateSbusStatus(JsonObject doc) {
     SbusRouter* router = SbusRouter::getInstance();
 
     // Router state
@@ -1164,6 +1480,47 @@ void handleSbusStatus(AsyncWebServerRequest *request) {
     doc["framesRouted"] = router->getFramesRouted();
     doc["repeatedFrames"] = router->getRepeatedFrames();
 
+    // UDP link quality (envelope mode only)
+    if (config.device4.role == D4_SBUS_UDP_RX && SbusUdpReceiver::getInstance()->isActive()) {
+        SbusUdpReceiver::Stats ls = SbusUdpReceiver::getInstance()->getStats();
+        JsonObject link = doc["udpLink"].to<JsonObject>();
+        link["datagrams"] = ls.datagrams;
+        link["framesAccepted"] = ls.framesAccepted;
+        link["framesLost"] = ls.framesLost;
+        link["framesRecovered"] = ls.framesRecovered;
+        link["datagramsLost"] = ls.datagramsLost;
+        link["framesStale"] = ls.framesStale;
+        link["duplicates"] = ls.duplicates;
+        link["lateReleases"] = ls.lateReleases;
+        link["overflows"] = ls.overflows;
+        uint32_t expected = ls.framesAccepted + ls.framesLost;
+        link["lossPercent"] = expected ? (ls.framesLost * 100.0f / expected) : 0.0f;
+        link["jitterUs"] = ls.jitterUs;
+        link["playoutDelayUs"] = ls.playoutDelayUs;
+    }
+
+    // Output scheduler (fixed cadence)
+    if (router->isOutputSchedulerActive()) {
+        JsonObject sched = doc["scheduler"].to<JsonObject>();
+        sched["periodMs"] = router->getOutputPeriodMs();
+        sched["emitted"] = router->getSchedulerEmitted();
+        sched["repeated"] = router->getSchedulerRepeated();
+        sched["skipped"] = router->getSchedulerSkipped();
+        sched["jitterMaxUs"] = router->getJitterMaxUs();
+        // Buckets: <50, <100, <250, <500, <1000, >=1000 us
+        JsonArray hist = sched["jitterHist"].to<JsonArray>();
+        const uint32_t* h = router->getJitterHistogram();
+        for (size_t i = 0; i < SBUS_JITTER_BUCKETS; i++) hist.add(h[i]);
+    }
+}
+
+// Get current SBUS source status
+void handleSbusStatus(AsyncWebServerRequest *request) {
+    JsonDocument doc;
+    JsonObject root = doc.to<JsonObject>();
+    root["status"] = "ok";
+    populateSbusStatus(root);
+
     String response;
     serializeJson(doc, response);
     request->send(200, "application/json", response);
@@ -1171,14 +1528,183 @@ void handleSbusStatus(AsyncWebServerRequest *request) {
 
 // Get RC channel values for web UI monitor
 void handleRcChannels(AsyncWebServerRequest *request) {
+    RcChannelSnapshot rc;
+    if (!rc_channels_read(rc)) {
+        sendJsonError(request, 503, "RC channels busy");
+        return;
+    }
+
     JsonDocument doc;
     JsonArray ch = doc["ch"].to<JsonArray>();
     for (int i = 0; i < RC_CHANNEL_COUNT; i++) {
-        ch.add(rcChannels.channels[i]);
+        ch.add(rc.channels[i]);
     }
-    doc["age"] = rcChannels.lastUpdateMs ? millis() - rcChannels.lastUpdateMs : -1;
+    doc["age"] = rc.lastUpdateMs ? millis() - rc.lastUpdateMs : -1;
+    doc["source"] = rc.source;
+    doc["flags"] = rc.flags;
 
     String response;
     serializeJson(doc, response);
     request->send(200, "application/json", response);
 }
+
+static void addMsgIdCounters(JsonObject obj, const MsgIdCounters& c) {
+    obj["rxPackets"] = c.rxPackets;
+    obj["rxBytes"] = c.rxBytes;
+    obj["txPackets"] = c.txPackets;
+    obj["txBytes"] = c.txBytes;
+    obj["txDrops"] = c.txDrops;
+    JsonArray rx = obj["rxByIface"].to<JsonArray>();
+    JsonArray tx = obj["txBySender"].to<JsonArray>();
+    for (int i = 0; i < MAX_SENDERS; i++) {
+        rx.add(c.rxByIface[i]);
+        tx.add(c.txBySender[i]);
+    }
+}
+
+// Per-msgid MAVLink traffic: /api/mavlink/messages?top=10&sort=bytes|packets|drops
+void handleMavlinkMessages(AsyncWebServerRequest *request) {
+    MavlinkMsgStats* msgStats = MavlinkMsgStats::getInstance();
+    if (!MavlinkMsgStats::isEnabled()) {
+        sendJsonError(request, 404, "MAVLink protocol not enabled");
+        return;
+    }
+
+    size_t top = MSG_STATS_TOP_DEFAULT;
+    if (request->hasParam("top")) {
+        top = constrain(request->getParam("top")->value().toInt(), 1, MSG_STATS_TOP_MAX);
+    }
+    MavlinkMsgStats::SortKey key = MavlinkMsgStats::SORT_BYTES;
+    if (request->hasParam("sort")) {
+        String sort = request->getParam("sort")->value();
+        if (sort == "packets") key = MavlinkMsgStats::SORT_PACKETS;
+        else if (sort == "drops") key = MavlinkMsgStats::SORT_DROPS;
+        else if (sort != "bytes") {
+            sendJsonError(request, 400, "Invalid sort (bytes, packets, drops)");
+            return;
+        }
+    }
+
+    static MsgIdStat entries[MSG_STATS_TOP_MAX];    // Handlers run on the async_tcp task only
+    size_t count = msgStats->getTop(entries, top, key);
+
+    MsgIdCounters total, untracked;
+    size_t tracked;
+    msgStats->getTotals(total, untracked, tracked);
+
+    JsonDocument doc;
+    JsonArray names = doc["interfaces"].to<JsonArray>();
+    for (int i = 0; i < MAX_SENDERS; i++) {
+        names.add(PacketCapture::interfaceName(i));
+    }
+    doc["tracked"] = tracked;
+    addMsgIdCounters(doc["total"].to<JsonObject>(), total);
+    addMsgIdCounters(doc["untracked"].to<JsonObject>(), untracked);
+
+    JsonArray messages = doc["messages"].to<JsonArray>();
+    for (size_t i = 0; i < count; i++) {
+        JsonObject m = messages.add<JsonObject>();
+        m["id"] = entries[i].msgId;
+        addMsgIdCounters(m, entries[i].counters);
+    }
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
+// Parse /capture.pcapng filter parameters. False (with message) on invalid input.
+static bool parseCaptureFilter(AsyncWebServerRequest* request, CaptureFilter& filter, const char*& error) {
+    if (request->hasParam("dir")) {
+        String dir = request->getParam("dir")->value();
+        if (dir == "in") filter.dirMask = CAPTURE_DIR_IN;
+        else if (dir == "out") filter.dirMask = CAPTURE_DIR_OUT;
+        else if (dir != "both") { error = "Invalid dir (in, out, both)"; return false; }
+    }
+
+    if (request->hasParam("proto")) {
+        String proto = request->getParam("proto")->value();
+        if (proto == "mavlink") filter.protocol = (int8_t)PacketProtocol::MAVLINK;
+        else if (proto == "raw") filter.protocol = (int8_t)PacketProtocol::RAW;
+        else if (proto != "any") { error = "Invalid proto (mavlink, raw, any)"; return false; }
+    }
+
+    // Comma-separated lists: iface=uart1,udp  msgid=0,30,33
+    if (request->hasParam("iface")) {
+        String list = request->getParam("iface")->value();
+        int pos = 0;
+        while (pos <= (int)list.length()) {
+            int comma = list.indexOf(',', pos);
+            if (comma < 0) comma = list.length();
+            String name = list.substring(pos, comma);
+            name.trim();
+            pos = comma + 1;
+            if (name.length() == 0) continue;
+
+            uint8_t i = 0;
+            while (i < CAPTURE_IFACE_COUNT && !name.equalsIgnoreCase(PacketCapture::interfaceName(i))) i++;
+            if (i == CAPTURE_IFACE_COUNT) { error = "Unknown iface"; return false; }
+            filter.ifaceMask |= (1 << i);
+        }
+    }
+
+    if (request->hasParam("msgid")) {
+        String list = request->getParam("msgid")->value();
+        int pos = 0;
+        while (pos <= (int)list.length()) {
+            int comma = list.indexOf(',', pos);
+            if (comma < 0) comma = list.length();
+            String id = list.substring(pos, comma);
+            id.trim();
+            pos = comma + 1;
+            if (id.length() == 0) continue;
+
+            if (filter.msgIdCount >= CAPTURE_MAX_MSGIDS) { error = "Too many msgid values"; return false; }
+            long value = id.toInt();
+            if (value < 0 || value > 0xFFFF || (value == 0 && id != "0")) { error = "Invalid msgid"; return false; }
+            filter.msgIds[filter.msgIdCount++] = (uint16_t)value;
+        }
+    }
+
+    return true;
+}
+
+// Live capture as pcapng: /capture.pcapng?seconds=60&dir=&iface=&proto=&msgid=
+// Streams until the duration ends (seconds=0: until the client disconnects).
+void handleCapture(AsyncWebServerRequest *request) {
+    CaptureFilter filter;
+    const char* error = nullptr;
+    if (!parseCaptureFilter(request, filter, error)) {
+        sendJsonError(request, 400, error);
+        return;
+    }
+
+    uint32_t seconds = CAPTURE_DEFAULT_SECONDS;
+    if (request->hasParam("seconds")) {
+        seconds = request->getParam("seconds")->value().toInt();
+        if (seconds > CAPTURE_MAX_SECONDS) seconds = CAPTURE_MAX_SECONDS;
+    }
+
+    PacketCapture* capture = PacketCapture::getInstance();
+    if (PacketCapture::isActive()) {
+        sendJsonError(request, 409, "Capture already running");
+        return;
+    }
+    uint32_t session = capture->start(filter, seconds * 1000);
+    if (!session) {
+        sendJsonError(request, 503, "Capture unavailable");
+        return;
+    }
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/x-pcapng",
+        [session](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            size_t len = PacketCapture::getInstance()->read(session, buffer, maxLen);
+            return (len == CAPTURE_READ_WAIT) ? RESPONSE_TRY_AGAIN : len;
+        });
+    response->addHeader("Content-Disposition", "attachment; filename=\"capture.pcapng\"");
+    response->addHeader("Cache-Control", "no-cache");
+    request->onDisconnect([session]() {
+        PacketCapture::getInstance()->stop(session);
+    });
+    request->send(response);
+}
@@ -3,19 +3,35 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 
 // Web API constants
 #define MS_TO_SECONDS           1000
-#define IP_ADDRESS_BUFFER_SIZE  15
+
+// /api/status snapshot
+#define STATUS_SNAPSHOT_SIZE            7168    // Complete response body
+#define STATUS_PROTOCOL_SIZE            5120    // Protocol statistics section (incl. up to 8 UDP peers)
+#define STATUS_SNAPSHOT_INTERVAL_MS     1000    // Counters/system info refresh
+#define STATUS_PROTOCOL_INTERVAL_MS     2000    // Protocol statistics refresh
+#define STATUS_IDLE_MS                  15000   // Stop refreshing when nobody polls
+#define STATUS_LOCK_TIMEOUT_MS          100
 
 // Generate logs JSON
 void writeLogsJson(Print& output);
 
+// Refresh cached /api/status snapshot (scheduler)
+void web_api_status_tick();
+
+// Status content shared with /ws/stats
+void populateStatusJson(JsonDocument& doc);
+void populateSbusStatus(JsonObject doc);
+
 // API handlers for async web server
 void handleLogs(AsyncWebServerRequest *request);
 void handleSaveJson(AsyncWebServerRequest *request);
 void handleResetStats(AsyncWebServerRequest *request);
 void handleCrashLogJson(AsyncWebServerRequest *request);
+void handleBootProfile(AsyncWebServerRequest *request);
 void handleClearCrashLog(AsyncWebServerRequest *request);
 void handleExportConfig(AsyncWebServerRequest *request);
 void handleFactoryReset(AsyncWebServerRequest *request);
@@ -25,6 +41,8 @@ void handleSbusSetSource(AsyncWebServerRequest *request);
 void handleSbusSetMode(AsyncWebServerRequest *request);
 void handleSbusStatus(AsyncWebServerRequest *request);
 void handleRcChannels(AsyncWebServerRequest *request);
+void handleCapture(AsyncWebServerRequest *request);
+void handleMavlinkMessages(AsyncWebServerRequest *request);
 void handleTestCrash(AsyncWebServerRequest *request);
 
 // New split API endpoints (Alpine.js refactoring)
@@ -3,12 +3,16 @@
 #include <LittleFS.h>
 #include <Preferences.h>
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 #include "esp_heap_caps.h"
 
 // Local includes
 #include "web_interface.h"
 #include "web_api.h"
 #include "web_ota.h"
+#include "stats_ws.h"
+#include "rc_ws.h"
+#include "metrics.h"
 #include "logging.h"
 #include "config.h"
 #include "defines.h"
@@ -35,6 +39,21 @@ extern UsbInterface* usbInterface;
 AsyncWebServer* server = nullptr;
 AsyncWebSocket* terminalWs = nullptr;
 
+// Terminal WS client ids - written by WebSocket events (async_tcp task), read by
+// poll (scheduler). Clients are looked up by id, never by walking getClients().
+static uint32_t terminalClientIds[TerminalBuffer::MAX_READERS];
+static portMUX_TYPE terminalClientsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static size_t copyTerminalClientIds(uint32_t* ids) {
+    size_t count = 0;
+    portENTER_CRITICAL(&terminalClientsMux);
+    for (uint32_t id : terminalClientIds) {
+        if (id) ids[count++] = id;
+    }
+    portEXIT_CRITICAL(&terminalClientsMux);
+    return count;
+}
+
 // Indicates whether the web server was successfully started
 static bool webServerInitialized = false;
 
@@ -178,6 +197,10 @@ void webserver_init(Config* config, SystemState* state) {
     server->on("/api/config", HTTP_GET, handleApiConfig);
     server->on("/api/status", HTTP_GET, handleApiStatus);
     server->on("/api/rc/channels", HTTP_GET, handleRcChannels);
+    server->on("/capture.pcapng", HTTP_GET, handleCapture);
+    server->on("/api/mavlink/messages", HTTP_GET, handleMavlinkMessages);
+    server->on("/metrics", HTTP_GET, handleMetrics);
+    server->on("/api/boot", HTTP_GET, handleBootProfile);
 
     // Serve static files with gzip compression
     server->on("/style.css", HTTP_GET, [](AsyncWebServerRequest *request){
@@ -229,18 +252,27 @@ void webserver_init(Config* config, SystemState* state) {
                                AwsEventType type, void *arg, uint8_t *data, size_t len) {
             if (type == WS_EVT_CONNECT) {
                 log_msg(LOG_INFO, "Terminal WS client #%u connected", client->id());
-                // Send buffered history to new client
-                TerminalBuffer* termBuf = TerminalBuffer::getInstance();
-                uint8_t histBuf[512];
-                size_t offset = 0;
-                size_t got;
-                while ((got = termBuf->readHistory(histBuf, sizeof(histBuf), offset)) > 0) {
-                    client->binary(histBuf, got);
-                    offset += got;
+                // Own cursor at oldest buffered byte - history replays via regular poll
+                if (!TerminalBuffer::getInstance()->attachReader(client->id(), true)) {
+                    log_msg(LOG_WARNING, "Terminal WS: too many clients, #%u gets no data", client->id());
+                    return;
                 }
-                termBuf->resetWsReader();
+                portENTER_CRITICAL(&terminalClientsMux);
+                for (uint32_t& id : terminalClientIds) {
+                    if (id == 0) {
+                        id = client->id();
+                        break;
+                    }
+                }
+                portEXIT_CRITICAL(&terminalClientsMux);
             } else if (type == WS_EVT_DISCONNECT) {
                 log_msg(LOG_INFO, "Terminal WS client #%u disconnected", client->id());
+                portENTER_CRITICAL(&terminalClientsMux);
+                for (uint32_t& id : terminalClientIds) {
+                    if (id == client->id()) id = 0;
+                }
+                portEXIT_CRITICAL(&terminalClientsMux);
+                TerminalBuffer::getInstance()->detachReader(client->id());
             } else if (type == WS_EVT_DATA) {
                 // Forward browser input to UART1 TX
                 AwsFrameInfo *info = (AwsFrameInfo*)arg;
@@ -254,9 +286,16 @@ void webserver_init(Config* config, SystemState* state) {
         });
         server->addHandler(terminalWs);
         server->on("/terminal_clear", HTTP_GET, handleTerminalClear);
+        server->on("/terminal_stats", HTTP_GET, handleTerminalStats);
         log_msg(LOG_INFO, "Terminal WebSocket endpoint created: /ws/terminal");
     }
 
+    // Live statistics push (replaces status polling while the page is open)
+    stats_ws_attach(server);
+
+    // Live RC channel stream (binary, up to 100 Hz)
+    rc_ws_attach(server);
+
     // Setup not found handler for captive portal
     server->onNotFound(handleNotFound);
 
@@ -275,34 +314,82 @@ void webserver_stop() {
         terminalWs->closeAll();
         terminalWs = nullptr;  // Owned by server, deleted with it
     }
+    stats_ws_detach();
+    rc_ws_detach();
     server->end();
     delete server;
     server = nullptr;
     webServerInitialized = false;
 }
 
+// Terminal WS frame size: one TCP segment (lwIP default MSS)
+static constexpr size_t TERMINAL_WS_FRAME_SIZE = 1436;
+// Per-client limit of frames waiting in AsyncWebSocket queue before client counts as congested
+static constexpr size_t TERMINAL_WS_MAX_QUEUED = 4;
+
 // Push terminal buffer data to connected WebSocket clients
+// Runs every terminal flush interval: each client gets MSS-sized frames from its own
+// cursor. Congested clients are skipped - their data stays in the ring (coalesced into
+// the next frames) and they get a drop note if the ring overruns them.
 void terminal_ws_poll() {
     if (!terminalWs || terminalWs->count() == 0) return;
 
     TerminalBuffer* termBuf = TerminalBuffer::getInstance();
-    size_t avail = termBuf->available();
-    if (avail == 0) return;
-
-    // Drain all available data in chunks
-    uint8_t buf[512];
-    while (avail > 0) {
-        size_t toRead = min(avail, sizeof(buf));
-        size_t got = termBuf->readNew(buf, toRead);
-        if (got == 0) break;
-        terminalWs->binaryAll(buf, got);
-        avail = termBuf->available();
+    static uint8_t buf[TERMINAL_WS_FRAME_SIZE];
+
+    uint32_t ids[TerminalBuffer::MAX_READERS];
+    size_t count = copyTerminalClientIds(ids);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t id = ids[i];
+        AsyncWebSocketClient* client = terminalWs->client(id);
+        if (!client || client->status() != WS_CONNECTED) continue;
+
+        while (client->canSend() && client->queueLen() < TERMINAL_WS_MAX_QUEUED) {
+            size_t overrun;
+            size_t got = termBuf->readFor(id, buf, sizeof(buf), &overrun);
+            if (overrun > 0) {
+                // Tell lagging client exactly how much it missed
+                char note[48];
+                int n = snprintf(note, sizeof(note), "\r\n[terminal: %u bytes dropped]\r\n", (unsigned)overrun);
+                client->text(note, n);
+            }
+            if (got == 0) break;
+            client->binary(buf, got);
+        }
     }
 
     // Periodic cleanup of disconnected clients
     terminalWs->cleanupClients();
 }
 
+// Per-client terminal lag (for /terminal_stats)
+void handleTerminalStats(AsyncWebServerRequest *request) {
+    JsonDocument doc;
+    JsonArray clients = doc["clients"].to<JsonArray>();
+
+    if (terminalWs) {
+        TerminalBuffer* termBuf = TerminalBuffer::getInstance();
+        uint32_t ids[TerminalBuffer::MAX_READERS];
+        size_t count = copyTerminalClientIds(ids);
+        for (size_t i = 0; i < count; i++) {
+            AsyncWebSocketClient* client = terminalWs->client(ids[i]);
+            if (!client || client->status() != WS_CONNECTED) continue;
+            JsonObject c = clients.add<JsonObject>();
+            c["id"] = ids[i];
+            c["lagBytes"] = termBuf->availableFor(ids[i]);
+            c["droppedBytes"] = termBuf->droppedFor(ids[i]);
+            c["queueLen"] = client->queueLen();
+            c["congested"] = !client->canSend();
+        }
+    }
+    doc["flushMs"] = config.terminalFlushMs;
+
+    String json;
+    serializeJson(doc, json);
+    request->send(200, "application/json", json);
+}
+
 // Drop terminal ring buffer history (called from web UI clear button)
 void handleTerminalClear(AsyncWebServerRequest *request) {
     TerminalBuffer::getInstance()->clear();
@@ -32,6 +32,7 @@ void handleSuccess(AsyncWebServerRequest *request);
 void handleNotFound(AsyncWebServerRequest *request);
 void handleReboot(AsyncWebServerRequest *request);
 void handleTerminalClear(AsyncWebServerRequest *request);
+void handleTerminalStats(AsyncWebServerRequest *request);
 
 // Static file handlers
 void handleCSS(AsyncWebServerRequest *request);
@@ -3,8 +3,8 @@
  *
  * Stores:
  * - app: static configuration, device roles, board info
- * - status: runtime data (uptime, stats, traffic) - polled every 5s
- * - sbus: SBUS routing state - polled every 5s if SBUS active
+ * - status: runtime data (uptime, stats, traffic) - pushed via /ws/stats, polled every 5s as fallback
+ * - sbus: SBUS routing state - pushed with status, polled every 5s if SBUS active and push unavailable
  */
 
 // Default SBUS text output rate (Hz) - string for x-model compatibility
@@ -18,14 +18,22 @@ const TRACKED_FIELDS = [
     'wifiNetwork0Ssid', 'wifiNetwork0Pass', 'wifiNetwork1Ssid', 'wifiNetwork1Pass',
     'wifiNetwork2Ssid', 'wifiNetwork2Pass', 'wifiNetwork3Ssid', 'wifiNetwork3Pass',
     'wifiNetwork4Ssid', 'wifiNetwork4Pass',
-    'protocolOptimization', 'mavlinkRouting', 'terminalAnsi', 'sbusTimingKeeper',
+    'protocolOptimization', 'mavlinkRouting', 'terminalAnsi', 'terminalFlushMs', 'terminalTriggers', 'sbusTimingKeeper', 'sbusOutputPeriod', 'rcTextFormat', 'crsfBinaryRates',
     'device4TargetIP', 'device4TargetPort', 'device4SbusFormat',
-    'device4AutoBroadcast', 'device4UdpTimeout', 'udpBatching',
+    'device4AutoBroadcast', 'device4LearnPeers', 'device4Transport', 'device4TcpSlowPolicy', 'device4UdpTimeout', 'udpBatching', 'device4SbusEnvelope', 'device4SbusRedundancy',
     'device2OutRate', 'device3OutRate', 'device4OutRate', 'btSendRate', 'crsfFilter',
     'logLevelWeb', 'logLevelUart', 'logLevelNetwork',
     'usbMode'
 ];
 
+// /ws/stats binary counters frame: value order (matches STATS_WS_COUNTER_KEYS in firmware)
+const STATS_COUNTER_KEYS = [
+    'uptime', 'freeRam', 'totalTraffic',
+    'device1Rx', 'device1Tx', 'device2Rx', 'device2Tx', 'device3Rx', 'device3Tx',
+    'device4RxBytes', 'device4TxBytes', 'device4RxPackets', 'device4TxPackets',
+    'device5RxBytes', 'device5TxBytes'
+];
+
 document.addEventListener('alpine:init', () => {
 
     // =========================================================================
@@ -60,7 +68,12 @@ document.addEventListener('alpine:init', () => {
         device4TargetPort: '14550',
         device4SbusFormat: '0',
         device4AutoBroadcast: false,
+        device4LearnPeers: false,
+        device4Transport: '0',       // 0 = UDP, 1 = TCP server (Bridge role)
+        device4TcpSlowPolicy: '0',   // 0 = drop packets, 1 = disconnect
         device4UdpTimeout: '1000',
+        device4SbusEnvelope: false,
+        device4SbusRedundancy: '0',
         udpBatching: true,
 
         // USB mode (Device 2 USB role)
@@ -100,7 +113,14 @@ document.addEventListener('alpine:init', () => {
         protocolOptimization: '0',
         mavlinkRouting: false,
         terminalAnsi: false,
+        terminalFlushMs: '50',
+        terminalTriggers: '',
         sbusTimingKeeper: false,
+        sbusOutputPeriod: '0',
+        rcTextFormat: '0',
+        // CRSF binary per-group max rate (Hz, 0 = unlimited): RC, LQ, BAT, GPS, ATT, FM
+        // Comma-joined string so dirty checking compares by value
+        crsfBinaryRates: '0,0,0,0,0,0',
 
         // Log levels (-1=OFF, 0=ERROR, 1=WARNING, 2=INFO, 3=DEBUG)
         logLevelWeb: '1',
@@ -160,6 +180,21 @@ document.addEventListener('alpine:init', () => {
                    this.device5Role === '3';     // D5_BT_CRSF_TEXT
         },
 
+        // Computed: show CRSF binary rate limits (CRSF bridge output active)
+        get showCrsfBinaryRates() {
+            if (!this.isCrsfActive) return false;
+            return this.device2Role === '8' ||   // D2_USB_CRSF_BRIDGE
+                   this.device3Role === '6';     // D3_CRSF_BRIDGE
+        },
+
+        // CRSF binary rate helpers
+        crsfRateGet(i) { return this.crsfBinaryRates.split(',')[i] ?? '0'; },
+        crsfRateSet(i, value) {
+            const rates = this.crsfBinaryRates.split(',');
+            rates[i] = value;
+            this.crsfBinaryRates = rates.join(',');
+        },
+
         // CRSF filter helpers
         crsfFilterHas(bit) { return (this.crsfFilter & bit) !== 0; },
         crsfFilterToggle(bit) {
@@ -181,6 +216,11 @@ document.addEventListener('alpine:init', () => {
                    this.device4Role === '4';             // D4_SBUS_UDP_RX
         },
 
+        // Computed: has a source for binary SBUS outputs (SBUS input or CRSF -> SBUS conversion)
+        get hasSbusOutSource() {
+            return this.hasSbusInput || this.isCrsfActive;
+        },
+
         // Computed: has SBUS output
         get hasSbusOutput() {
             return this.device2Role === '4' ||           // D2_SBUS_OUT
@@ -192,7 +232,7 @@ document.addEventListener('alpine:init', () => {
 
         // Computed: show SBUS config warning
         get showSbusWarning() {
-            return this.hasSbusOutput && !this.hasSbusInput;
+            return this.hasSbusOutput && !this.hasSbusOutSource;
         },
 
         // Computed: has UART devices (for UART config visibility)
@@ -227,10 +267,15 @@ document.addEventListener('alpine:init', () => {
             return this.btSupported || this.bleSupported;
         },
 
-        // Computed: show Auto Broadcast checkbox (Client mode + TX role)
+        // Computed: show Auto Broadcast checkbox (Client mode + TX role, not TCP)
         get showAutoBroadcast() {
             const baseRole = this.device4Role?.split('_')[0];
-            return this.wifiMode === '1' && (baseRole === '1' || baseRole === '3');
+            return this.wifiMode === '1' && (baseRole === '3' || (baseRole === '1' && !this.device4IsTcpServer));
+        },
+
+        // Computed: Device 4 Bridge runs as TCP server (no targets, clients connect)
+        get device4IsTcpServer() {
+            return this.device4Role === '1' && this.device4Transport === '1';
         },
 
         // Computed: show USB Mode block (Device 2 is USB)
@@ -599,7 +644,7 @@ document.addEventListener('alpine:init', () => {
                 { value: '0', label: 'Disabled', disabled: false },
                 { value: '1', label: 'Bridge', disabled: inputMode },
                 { value: '2', label: 'UDP Logger', disabled: false },
-                { value: '3_0', label: 'SBUS Output', disabled: noSbusIn },
+                { value: '3_0', label: 'SBUS Output', disabled: !this.hasSbusOutSource },
                 { value: '3_1', label: 'SBUS Text Output', disabled: noSbusIn },
                 { value: '4', label: 'SBUS Input', disabled: noSbusIn },
                 { value: '5', label: 'CRSF Text Output', disabled: !crsf }
@@ -649,7 +694,7 @@ document.addEventListener('alpine:init', () => {
                 { value: '2', label: 'USB', disabled: d1IsInput },
                 { value: '6', label: 'USB Logger', disabled: false },
                 { value: '3', label: 'SBUS Input', disabled: !this.uart2Available || isCrsf },
-                { value: '4', label: 'SBUS Output', disabled: !this.uart2Available || isCrsf || noSbusIn },
+                { value: '4', label: 'SBUS Output', disabled: !this.uart2Available || !this.hasSbusOutSource },
                 { value: '5', label: 'USB SBUS Text Output', disabled: isCrsf || noSbusIn },
                 { value: '7', label: 'USB CRSF Text Output', disabled: !isCrsf },
                 { value: '8', label: 'USB CRSF Bridge', disabled: !isCrsf }
@@ -667,7 +712,7 @@ document.addEventListener('alpine:init', () => {
                 { value: '2', label: 'UART3 Bridge', disabled: d1SbusOrCrsf },
                 { value: '3', label: 'UART3 Logger', disabled: false },
                 { value: '4', label: 'SBUS Input', disabled: isCrsf },
-                { value: '5_0', label: 'SBUS Output', disabled: isCrsf || noSbusIn },
+                { value: '5_0', label: 'SBUS Output', disabled: !this.hasSbusOutSource },
                 { value: '5_1', label: 'SBUS Text Output', disabled: isCrsf || noSbusIn },
                 { value: '6', label: 'CRSF Bridge', disabled: !isCrsf }
             ];
@@ -682,17 +727,17 @@ document.addEventListener('alpine:init', () => {
         _doCheckAutoSbusIn() {
             // Reset SBUS output roles when no SBUS input source exists
             if (!this.hasSbusInput) {
-                // Reset D2 SBUS output roles
-                if (this.device2Role === '4' || this.device2Role === '5') {
+                // Reset D2 SBUS output roles (binary output kept for CRSF -> SBUS)
+                if (this.device2Role === '5' || (this.device2Role === '4' && !this.isCrsfActive)) {
                     this.device2Role = '0';
                 }
                 // Reset D3 SBUS output roles
-                if (this.device3Role?.startsWith('5')) {
+                if (this.device3Role === '5_1' || (this.device3Role?.startsWith('5') && !this.isCrsfActive)) {
                     this.device3Role = '0';
                 }
                 // Reset D4 SBUS roles
                 const d4Base = this.device4Role?.split('_')[0];
-                if (d4Base === '3' || d4Base === '4') {
+                if (this.device4Role === '3_1' || d4Base === '4' || (d4Base === '3' && !this.isCrsfActive)) {
                     this.device4Role = '0';
                 }
                 // Reset D5 SBUS Text
@@ -771,7 +816,12 @@ document.addEventListener('alpine:init', () => {
                 this.device4TargetPort = String(data.device4Port ?? data.device4TargetPort ?? 14550);
                 this.device4SbusFormat = String(data.device4SbusFormat ?? '0');
                 this.device4AutoBroadcast = data.device4AutoBroadcast ?? false;
+                this.device4LearnPeers = data.device4LearnPeers ?? false;
+                this.device4Transport = String(data.device4Transport ?? 0);
+                this.device4TcpSlowPolicy = String(data.device4TcpSlowPolicy ?? 0);
                 this.device4UdpTimeout = String(data.device4UdpTimeout ?? 1000);
+                this.device4SbusEnvelope = data.device4SbusEnvelope ?? false;
+                this.device4SbusRedundancy = String(data.device4SbusRedundancy ?? 0);
                 this.udpBatching = data.udpBatchingEnabled ?? true;
 
                 // USB mode
@@ -811,7 +861,12 @@ document.addEventListener('alpine:init', () => {
                 this.protocolOptimization = String(data.protocolOptimization ?? 0);
                 this.mavlinkRouting = data.mavlinkRouting ?? false;
                 this.terminalAnsi = data.terminalAnsi ?? false;
+                this.terminalFlushMs = String(data.terminalFlushMs ?? 50);
+                this.terminalTriggers = data.terminalTriggers ?? '';
                 this.sbusTimingKeeper = data.sbusTimingKeeper ?? false;
+                this.sbusOutputPeriod = String(data.sbusOutputPeriod ?? 0);
+                this.rcTextFormat = String(data.rcTextFormat ?? 0);
+                this.crsfBinaryRates = (data.crsfBinaryRates ?? [0, 0, 0, 0, 0, 0]).join(',');
 
                 // Log levels (convert to string for x-model select compatibility)
                 this.logLevelWeb = String(data.logLevelWeb ?? 1);
@@ -926,6 +981,11 @@ document.addEventListener('alpine:init', () => {
                 protocol_optimization: parseInt(this.protocolOptimization),
                 mavlink_routing: this.mavlinkRouting,
                 terminal_ansi: this.terminalAnsi,
+                terminal_flush_ms: parseInt(this.terminalFlushMs),
+                terminal_triggers: this.terminalTriggers,
+                sbus_output_period: parseInt(this.sbusOutputPeriod),
+                rc_text_format: parseInt(this.rcTextFormat),
+                crsf_binary_rates: this.crsfBinaryRates.split(',').map(v => parseInt(v)),
                 udp_batching: this.udpBatching,
 
                 // Log levels
@@ -937,7 +997,12 @@ document.addEventListener('alpine:init', () => {
                 device4_target_ip: this.device4TargetIP,
                 device4_port: parseInt(this.device4TargetPort),
                 device4_auto_broadcast: this.device4AutoBroadcast,
+                device4_learn_peers: this.device4LearnPeers,
+                device4_transport: parseInt(this.device4Transport),
+                device4_tcp_slow_policy: parseInt(this.device4TcpSlowPolicy),
                 device4_udp_timeout: parseInt(this.device4UdpTimeout),
+                device4_sbus_envelope: this.device4SbusEnvelope,
+                device4_sbus_redundancy: parseInt(this.device4SbusRedundancy),
 
                 // USB mode
                 usbmode: this.usbMode
@@ -981,18 +1046,23 @@ document.addEventListener('alpine:init', () => {
             // Device 4 IP validation (only for TX roles when visible and not auto broadcast)
             if (this.showDevice4Network) {
                 const baseRole = this.device4Role?.split('_')[0];
-                // TX roles need valid IP (unless auto broadcast is enabled)
-                if (baseRole !== '4' && !this.device4AutoBroadcast) {
+                // TX roles need valid IP (unless auto broadcast is enabled or Bridge is a TCP server)
+                if (baseRole !== '4' && !this.device4AutoBroadcast && !this.device4IsTcpServer) {
                     const ip = this.device4TargetIP?.trim();
                     if (!ip) {
+                        // Bridge with peer learning can run on learned peers only
+                        if (baseRole === '1' && this.device4LearnPeers) {
+                            return null;
+                        }
                         return 'Target IP required';
                     }
-                    // Validate IP format (single IP or comma-separated)
+                    // Validate IP or hostname format (single or comma-separated)
                     const ipPattern = /^(?:[0-9]{1,3}\.){3}[0-9]{1,3}$/;
+                    const hostPattern = /^(?=.*[A-Za-z])[A-Za-z0-9.-]{1,63}$/;
                     const ips = ip.split(',').map(s => s.trim());
                     for (const singleIp of ips) {
-                        if (!ipPattern.test(singleIp)) {
-                            return `Invalid IP: ${singleIp}`;
+                        if (!ipPattern.test(singleIp) && !hostPattern.test(singleIp)) {
+                            return `Invalid IP or hostname: ${singleIp}`;
                         }
                     }
                 }
@@ -1025,9 +1095,10 @@ document.addEventListener('alpine:init', () => {
                     throw new Error(errorMsg);
                 }
 
-                // Server will reboot, update snapshot for clean state
+                // Applied live or device reboots - either way the saved state is current
+                const result = await response.json().catch(() => ({}));
                 this._takeSnapshot();
-                return { success: true };
+                return { success: true, reboot: result.reboot !== false };
             } catch (err) {
                 console.error('Save error:', err);
                 throw err;
@@ -1042,6 +1113,11 @@ document.addEventListener('alpine:init', () => {
         // Polling
         pollInterval: null,
 
+        // Live push (/ws/stats) - HTTP polling only runs while it is down
+        _statsWs: null,
+        _statsData: {},
+        _statsRetry: null,
+
         // System info
         uptime: 0,
         freeRam: 0,
@@ -1167,6 +1243,9 @@ document.addEventListener('alpine:init', () => {
         // UDP batching
         udpBatchingEnabled: false,
         udpBatchingStats: null,  // { avgPacketsPerBatch, maxPacketsInBatch, batchEfficiency }
+        udpPeers: [],            // Learned reply-path peers { ip, port, idleMs, rxPackets, txPackets, ... }
+        udpHosts: [],            // Hostname targets { host, ip, ageS, pending, lookups, failures, changes }
+        tcpServer: null,         // { port, slowPolicy, rejected, slowDisconnects, clients: [...] }
 
         // Logs
         logs: [],
@@ -1281,6 +1360,7 @@ document.addEventListener('alpine:init', () => {
         startPolling() {
             this.fetchStatus();
             this.pollInterval = setInterval(() => this.fetchStatus(), 5000);
+            this.statsConnect();
         },
 
         // Stop polling
@@ -1289,96 +1369,175 @@ document.addEventListener('alpine:init', () => {
                 clearInterval(this.pollInterval);
                 this.pollInterval = null;
             }
+            if (this._statsRetry) {
+                clearTimeout(this._statsRetry);
+                this._statsRetry = null;
+            }
+            if (this._statsWs) {
+                this._statsWs.onclose = null;
+                this._statsWs.close();
+                this._statsWs = null;
+            }
+        },
+
+        // Live statistics: full snapshot on connect, changed fields after that
+        statsConnect() {
+            if (this._statsWs) return;
+            const proto = location.protocol === 'https:' ? 'wss:' : 'ws:';
+            const ws = new WebSocket(`${proto}//${location.host}/ws/stats`);
+            ws.binaryType = 'arraybuffer';
+            ws.onopen = () => {
+                this._statsWs = ws;
+                ws.send(JSON.stringify({ interval: 1000, binary: true }));
+            };
+            ws.onmessage = (e) => {
+                if (e.data instanceof ArrayBuffer) {
+                    this.applyStatsCounters(e.data);
+                } else {
+                    const msg = JSON.parse(e.data);
+                    if (!msg.full) {
+                        // Delta - applied with the counters frame that follows it
+                        this.mergeStats(this._statsData, msg.data);
+                        return;
+                    }
+                    this._statsData = msg.data;
+                }
+                this.applyStatus(this._statsData);
+                if (this._statsData.sbus) {
+                    Alpine.store('sbus').applyStatus(this._statsData.sbus);
+                }
+            };
+            ws.onclose = () => {
+                this._statsWs = null;
+                // Polling covers the gap, retry push later
+                this._statsRetry = setTimeout(() => {
+                    this._statsRetry = null;
+                    this.statsConnect();
+                }, 10000);
+            };
+        },
+
+        // Deep merge of a delta (nested objects per field, arrays replaced whole)
+        mergeStats(target, delta) {
+            for (const [key, value] of Object.entries(delta)) {
+                if (value && typeof value === 'object' && !Array.isArray(value) &&
+                    target[key] && typeof target[key] === 'object' && !Array.isArray(target[key])) {
+                    this.mergeStats(target[key], value);
+                } else {
+                    target[key] = value;
+                }
+            }
+        },
+
+        // Binary counters frame: type, count, 2 reserved, seq, count x uint32 (little-endian)
+        applyStatsCounters(buf) {
+            const view = new DataView(buf);
+            if (view.byteLength < 8 || view.getUint8(0) !== 0x01) return;
+            const count = Math.min(view.getUint8(1), STATS_COUNTER_KEYS.length, (view.byteLength - 8) / 4);
+            for (let i = 0; i < count; i++) {
+                this._statsData[STATS_COUNTER_KEYS[i]] = view.getUint32(8 + i * 4, true);
+            }
         },
 
-        // Fetch status from API
+        // Fetch status from API (skipped while push is connected)
         async fetchStatus() {
+            if (this._statsWs) return;
             try {
                 const response = await fetch('/api/status');
                 if (!response.ok) return;
+                // uptime/freeRam come as headers so the body (and its ETag) stays cacheable
                 const data = await response.json();
-
-                // Save previous values for activity indicators
-                this._prev.device1Rx = this.device1Rx;
-                this._prev.device1Tx = this.device1Tx;
-                this._prev.device2Rx = this.device2Rx;
-                this._prev.device2Tx = this.device2Tx;
-                this._prev.device3Rx = this.device3Rx;
-                this._prev.device3Tx = this.device3Tx;
-                this._prev.device4RxBytes = this.device4RxBytes;
-                this._prev.device4TxBytes = this.device4TxBytes;
-                this._prev.device5RxBytes = this.device5RxBytes;
-                this._prev.device5TxBytes = this.device5TxBytes;
-
-                this.uptime = data.uptime ?? 0;
-                this.freeRam = data.freeRam ?? 0;
-
-                // WiFi
-                this.wifiClientConnected = data.wifiClientConnected ?? false;
-                this.connectedSSID = data.connectedSSID || '';
-                this.ipAddress = data.ipAddress || '';
-                this.rssiPercent = data.rssiPercent ?? 0;
-                this.tempNetworkMode = data.tempNetworkMode ?? false;
-
-                // BT
-                this.btInitialized = data.btInitialized ?? false;
-                this.btConnected = data.btConnected ?? false;
-
-                // UART
-                this.uartConfig = data.uartConfig || '';
-                this.flowControl = data.flowControl || '';
-
-                // Device role names
-                this.device1RoleName = data.device1RoleName || '-';
-                this.device2RoleName = data.device2RoleName || '-';
-                this.device3RoleName = data.device3RoleName || '-';
-                this.device4RoleName = data.device4RoleName || '-';
-                this.device5RoleName = data.device5RoleName || '-';
-
-                // Device roles (numeric)
-                this.device2Role = parseInt(data.device2Role) || 0;
-                this.device3Role = parseInt(data.device3Role) || 0;
-                this.device4Role = parseInt(data.device4Role) || 0;
-                this.device5Role = parseInt(data.device5Role) || 0;
-
-                // Device stats
-                this.device1Rx = data.device1Rx ?? 0;
-                this.device1Tx = data.device1Tx ?? 0;
-                this.device2Rx = data.device2Rx ?? 0;
-                this.device2Tx = data.device2Tx ?? 0;
-                this.device3Rx = data.device3Rx ?? 0;
-                this.device3Tx = data.device3Tx ?? 0;
-
-                // Device 4
-                this.device4TxBytes = data.device4TxBytes ?? 0;
-                this.device4TxPackets = data.device4TxPackets ?? 0;
-                this.device4RxBytes = data.device4RxBytes ?? 0;
-                this.device4RxPackets = data.device4RxPackets ?? 0;
-
-                // Device 5 (Bluetooth)
-                this.device5TxBytes = data.device5TxBytes ?? 0;
-                this.device5RxBytes = data.device5RxBytes ?? 0;
-
-                // Total
-                this.totalTraffic = data.totalTraffic ?? 0;
-                this.lastActivity = data.lastActivity || 'Never';
-
-                // UDP batching
-                this.udpBatchingEnabled = data.udpBatchingEnabled ?? false;
-
-                // Protocol stats (if present)
-                if (data.protocolStats) {
-                    this.protocolStats = data.protocolStats;
-                    // Extract UDP batching stats
-                    if (data.protocolStats.udpBatching) {
-                        this.udpBatchingStats = data.protocolStats.udpBatching;
-                    }
-                }
+                data.uptime = Number(response.headers.get('X-Uptime')) || 0;
+                data.freeRam = Number(response.headers.get('X-Free-Ram')) || 0;
+                this.applyStatus(data);
             } catch (err) {
                 console.error('Failed to fetch status:', err);
             }
         },
 
+        // Apply /api/status layout to store
+        applyStatus(data) {
+            // Save previous values for activity indicators
+            this._prev.device1Rx = this.device1Rx;
+            this._prev.device1Tx = this.device1Tx;
+            this._prev.device2Rx = this.device2Rx;
+            this._prev.device2Tx = this.device2Tx;
+            this._prev.device3Rx = this.device3Rx;
+            this._prev.device3Tx = this.device3Tx;
+            this._prev.device4RxBytes = this.device4RxBytes;
+            this._prev.device4TxBytes = this.device4TxBytes;
+            this._prev.device5RxBytes = this.device5RxBytes;
+            this._prev.device5TxBytes = this.device5TxBytes;
+
+            this.uptime = data.uptime ?? 0;
+            this.freeRam = data.freeRam ?? 0;
+
+            // WiFi
+            this.wifiClientConnected = data.wifiClientConnected ?? false;
+            this.connectedSSID = data.connectedSSID || '';
+            this.ipAddress = data.ipAddress || '';
+            this.rssiPercent = data.rssiPercent ?? 0;
+            this.tempNetworkMode = data.tempNetworkMode ?? false;
+
+            // BT
+            this.btInitialized = data.btInitialized ?? false;
+            this.btConnected = data.btConnected ?? false;
+
+            // UART
+            this.uartConfig = data.uartConfig || '';
+            this.flowControl = data.flowControl || '';
+
+            // Device role names
+            this.device1RoleName = data.device1RoleName || '-';
+            this.device2RoleName = data.device2RoleName || '-';
+            this.device3RoleName = data.device3RoleName || '-';
+            this.device4RoleName = data.device4RoleName || '-';
+            this.device5RoleName = data.device5RoleName || '-';
+
+            // Device roles (numeric)
+            this.device2Role = parseInt(data.device2Role) || 0;
+            this.device3Role = parseInt(data.device3Role) || 0;
+            this.device4Role = parseInt(data.device4Role) || 0;
+            this.device5Role = parseInt(data.device5Role) || 0;
+
+            // Device stats
+            this.device1Rx = data.device1Rx ?? 0;
+            this.device1Tx = data.device1Tx ?? 0;
+            this.device2Rx = data.device2Rx ?? 0;
+            this.device2Tx = data.device2Tx ?? 0;
+            this.device3Rx = data.device3Rx ?? 0;
+            this.device3Tx = data.device3Tx ?? 0;
+
+            // Device 4
+            this.device4TxBytes = data.device4TxBytes ?? 0;
+            this.device4TxPackets = data.device4TxPackets ?? 0;
+            this.device4RxBytes = data.device4RxBytes ?? 0;
+            this.device4RxPackets = data.device4RxPackets ?? 0;
+
+            // Device 5 (Bluetooth)
+            this.device5TxBytes = data.device5TxBytes ?? 0;
+            this.device5RxBytes = data.device5RxBytes ?? 0;
+
+            // Total
+            this.totalTraffic = data.totalTraffic ?? 0;
+            this.lastActivity = data.lastActivity || 'Never';
+
+            // UDP batching
+            this.udpBatchingEnabled = data.udpBatchingEnabled ?? false;
+
+            // Protocol stats (if present)
+            if (data.protocolStats) {
+                this.protocolStats = data.protocolStats;
+                // Extract UDP batching stats
+                if (data.protocolStats.udpBatching) {
+                    this.udpBatchingStats = data.protocolStats.udpBatching;
+                }
+                this.udpPeers = data.protocolStats.udpPeers || [];
+                this.udpHosts = data.protocolStats.udpHosts || [];
+                this.tcpServer = data.protocolStats.tcpServer || null;
+            }
+        },
+
         // Reset statistics
         async resetStatistics() {
             try {
@@ -1510,24 +1669,29 @@ document.addEventListener('alpine:init', () => {
             }
         },
 
-        // Fetch SBUS status
+        // Fetch SBUS status (skipped while /ws/stats pushes it)
         async fetchStatus() {
+            const status = Alpine.store('status');
+            if (status._statsWs && status._statsData.sbus) return;
             try {
                 const response = await fetch('/sbus/status');
                 if (!response.ok) return;
-                const data = await response.json();
-
-                this.mode = data.mode ?? 0;
-                this.state = data.state ?? 0;
-                this.activeSource = data.activeSource ?? 0;
-                this.sources = data.sources || [];
-                this.framesRouted = data.framesRouted ?? 0;
-                this.repeatedFrames = data.repeatedFrames ?? 0;
+                this.applyStatus(await response.json());
             } catch (err) {
                 console.error('Failed to fetch SBUS status:', err);
             }
         },
 
+        // Apply /sbus/status layout to store
+        applyStatus(data) {
+            this.mode = data.mode ?? 0;
+            this.state = data.state ?? 0;
+            this.activeSource = data.activeSource ?? 0;
+            this.sources = data.sources || [];
+            this.framesRouted = data.framesRouted ?? 0;
+            this.repeatedFrames = data.repeatedFrames ?? 0;
+        },
+
         // Set SBUS source
         async setSource(sourceId) {
             try {
@@ -1565,13 +1729,23 @@ document.addEventListener('alpine:init', () => {
     Alpine.store('rc', {
         channels: new Array(16).fill(0),
         age: -1,
+        flags: 0,
         pollInterval: null,
 
+        // Binary stream (/ws/rc) - HTTP polling only while it is down
+        rate: '25',
+        _ws: null,
+
         // Is data stale (no update for >2 seconds)
         get isStale() {
             return this.age < 0 || this.age > 2000;
         },
 
+        // Source reports failsafe
+        get isFailsafe() {
+            return (this.flags & 0x01) !== 0;
+        },
+
         // Bar width percentage for a channel (988-2012 us range)
         barPercent(value) {
             if (!value) return 0;
@@ -1582,6 +1756,7 @@ document.addEventListener('alpine:init', () => {
             if (this.pollInterval) return;
             this.fetchChannels();
             this.pollInterval = setInterval(() => this.fetchChannels(), 500);
+            this.wsConnect();
         },
 
         stopPolling() {
@@ -1589,15 +1764,63 @@ document.addEventListener('alpine:init', () => {
                 clearInterval(this.pollInterval);
                 this.pollInterval = null;
             }
+            if (this._ws) {
+                this._ws.onclose = null;
+                this._ws.close();
+                this._ws = null;
+            }
+        },
+
+        wsConnect() {
+            if (this._ws) return;
+            const proto = location.protocol === 'https:' ? 'wss:' : 'ws:';
+            const ws = new WebSocket(`${proto}//${location.host}/ws/rc`);
+            ws.binaryType = 'arraybuffer';
+            ws.onopen = () => {
+                this._ws = ws;
+                this.setRate(this.rate);
+            };
+            ws.onmessage = (e) => {
+                if (e.data instanceof ArrayBuffer) this.applyFrame(e.data);
+            };
+            ws.onclose = () => { this._ws = null; };
+        },
+
+        setRate(rate) {
+            this.rate = String(rate);
+            if (this._ws) this._ws.send(JSON.stringify({ rate: parseInt(rate) }));
+        },
+
+        // Frame: source, flags, age (uint16 LE), 16 x 11-bit channels LSB first
+        applyFrame(buf) {
+            const b = new Uint8Array(buf);
+            if (b.length < 26) return;
+            const ch = new Array(16);
+            let acc = 0, bits = 0, idx = 4;
+            for (let i = 0; i < 16; i++) {
+                while (bits < 11) {
+                    acc |= b[idx++] << bits;
+                    bits += 8;
+                }
+                ch[i] = acc & 0x7FF;
+                acc >>>= 11;
+                bits -= 11;
+            }
+            const age = b[2] | (b[3] << 8);
+            this.channels = ch;
+            this.flags = b[1];
+            this.age = (age === 0xFFFF) ? -1 : age;
         },
 
         async fetchChannels() {
+            if (this._ws) return;
             try {
                 const response = await fetch('/api/rc/channels');
                 if (!response.ok) return;
                 const data = await response.json();
                 this.channels = data.ch || new Array(16).fill(0);
                 this.age = data.age ?? -1;
+                this.flags = data.flags ?? 0;
             } catch (err) {
                 // Silently ignore fetch errors
             }
@@ -7,6 +7,7 @@
 #include "diagnostics.h"
 #include "scheduler_tasks.h"
 #include "../web/web_interface.h"
+#include "../protocols/tcp_server_transport.h"
 
 // ESP-IDF headers
 #include "esp_wifi.h"
@@ -695,6 +696,10 @@ void wifiStop() {
     if (udpTransport) {
         udpTransport->close();
     }
+    extern TcpServerTransport* tcpServerTransport;
+    if (tcpServerTransport) {
+        tcpServerTransport->end();
+    }
 
     // 4. Clean up DNS server
     if (dnsServer) {
@@ -0,0 +1,68 @@
+// Host build stand-in for the Arduino core (native unit tests only)
+// Covers what the pure-logic units use: String, Print, time, min/max/constrain.
+// millis()/micros() run on a fake clock the tests advance explicitly.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include "freertos/FreeRTOS.h"
+#include "esp_heap_caps.h"
+
+using std::min;
+using std::max;
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+namespace native_clock {
+inline uint64_t nowUs = 0;
+inline void advanceUs(uint64_t us) { nowUs += us; }
+inline void advanceMs(uint32_t ms) { nowUs += (uint64_t)ms * 1000; }
+}
+
+inline uint32_t micros() { return (uint32_t)native_clock::nowUs; }
+inline uint32_t millis() { return (uint32_t)(native_clock::nowUs / 1000); }
+inline void delay(uint32_t ms) { native_clock::advanceMs(ms); }
+
+inline void esp_restart() { abort(); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*buf++);
+        return n;
+    }
+};
+
+class String {
+public:
+    String() {}
+    String(const char* s) : str(s ? s : "") {}
+    String(const char* s, size_t len) : str(s, len) {}
+    String(const std::string& s) : str(s) {}
+
+    const char* c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.length(); }
+    char charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+    bool operator==(const String& o) const { return str == o.str; }
+    bool operator!=(const String& o) const { return str != o.str; }
+    String& operator+=(const String& o) { str += o.str; return *this; }
+
+    void trim() {
+        size_t b = str.find_first_not_of(" \t\r\n");
+        size_t e = str.find_last_not_of(" \t\r\n");
+        str = (b == std::string::npos) ? std::string() : str.substr(b, e - b + 1);
+    }
+
+private:
+    std::string str;
+};
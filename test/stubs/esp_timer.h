@@ -0,0 +1,9 @@
+// Host build stand-in: esp_timer time follows the fake Arduino clock
+#pragma once
+
+#include <stdint.h>
+#include "Arduino.h"
+
+typedef struct esp_timer* esp_timer_handle_t;
+
+inline int64_t esp_timer_get_time() { return (int64_t)native_clock::nowUs; }
@@ -0,0 +1,19 @@
+// Host build stand-in: single-threaded tests, locks are no-ops
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef void* TaskHandle_t;
+
+#define pdTRUE          1
+#define pdFALSE         0
+#define portMAX_DELAY   0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+typedef struct { int locked; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portMUX_INITIALIZE(mux) ((mux)->locked = 0)
+#define portENTER_CRITICAL(mux) ((mux)->locked++)
+#define portEXIT_CRITICAL(mux)  ((mux)->locked--)
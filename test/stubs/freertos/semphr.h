@@ -0,0 +1,11 @@
+// Host build stand-in: mutexes always succeed
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int dummy; return &dummy; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+inline void vSemaphoreDelete(SemaphoreHandle_t) {}
@@ -0,0 +1,214 @@
+// pcapng stream of PacketCapture: block framing, IDBs, EPB fields and options.
+// With tshark installed the stream is also loaded by Wireshark's reader.
+#include <unity.h>
+#include <vector>
+#include "native_runtime.h"
+#include "packet_capture.h"
+
+static const uint32_t PCAPNG_SHB = 0x0A0D0D0A;
+static const uint32_t PCAPNG_IDB = 0x00000001;
+static const uint32_t PCAPNG_EPB = 0x00000006;
+
+static uint32_t session = 0;
+
+static uint16_t get16(const uint8_t* p) { uint16_t v; memcpy(&v, p, 2); return v; }
+static uint32_t get32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+struct Block {
+    uint32_t type;
+    const uint8_t* body;    // After type + length
+    uint32_t bodyLen;       // Without the trailing length
+};
+
+// Split stream into blocks, checking the framing of every block
+static std::vector<Block> splitBlocks(const std::vector<uint8_t>& s) {
+    std::vector<Block> blocks;
+    size_t pos = 0;
+    while (pos < s.size()) {
+        TEST_ASSERT_TRUE(pos + 12 <= s.size());
+        uint32_t total = get32(&s[pos + 4]);
+        TEST_ASSERT_EQUAL_UINT32(0, total % 4);
+        TEST_ASSERT_TRUE(total >= 12 && pos + total <= s.size());
+        TEST_ASSERT_EQUAL_UINT32(total, get32(&s[pos + total - 4]));
+        blocks.push_back({get32(&s[pos]), &s[pos + 8], total - 12});
+        pos += total;
+    }
+    return blocks;
+}
+
+// Find option code in an options area, nullptr if absent (checks padding and opt_endofopt)
+static const uint8_t* findOption(const uint8_t* opts, size_t len, uint16_t code, uint16_t* optLen) {
+    const uint8_t* found = nullptr;
+    size_t pos = 0;
+    while (pos + 4 <= len) {
+        uint16_t c = get16(opts + pos);
+        uint16_t l = get16(opts + pos + 2);
+        if (c == 0) {
+            TEST_ASSERT_EQUAL_UINT16(0, l);
+            TEST_ASSERT_EQUAL_size_t(len, pos + 4);
+            return found;
+        }
+        if (c == code && !found) {
+            found = opts + pos + 4;
+            *optLen = l;
+        }
+        pos += 4 + ((l + 3) & ~3u);
+    }
+    TEST_ASSERT_TRUE_MESSAGE(false, "options not terminated by opt_endofopt");
+    return nullptr;
+}
+
+static std::vector<uint8_t> drain() {
+    std::vector<uint8_t> out;
+    uint8_t chunk[333];     // Odd size - blocks get split across reads
+    for (;;) {
+        size_t n = PacketCapture::getInstance()->read(session, chunk, sizeof(chunk));
+        if (n == 0 || n == CAPTURE_READ_WAIT) break;
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    return out;
+}
+
+static void tapPacket(const uint8_t* data, size_t len, uint8_t iface, uint8_t dir, bool rejected) {
+    ParsedPacket p;
+    p.data = const_cast<uint8_t*>(data);
+    p.size = len;
+    p.protocol = PacketProtocol::RAW;
+    p.parseTimeMicros = (dir == CAPTURE_DIR_IN) ? micros() : 0;
+    PacketCapture::tap(p, iface, dir, rejected);
+}
+
+void setUp() {
+    native_clock::nowUs = 5000000;
+    session = PacketCapture::getInstance()->start(CaptureFilter(), 0);
+    TEST_ASSERT_NOT_EQUAL(0, session);
+}
+
+void tearDown() {
+    PacketCapture::getInstance()->stop(session);
+}
+
+void test_header_is_shb_and_one_idb_per_interface() {
+    std::vector<uint8_t> s = drain();
+    std::vector<Block> blocks = splitBlocks(s);
+    TEST_ASSERT_EQUAL_size_t(1 + CAPTURE_IFACE_COUNT, blocks.size());
+
+    const Block& shb = blocks[0];
+    TEST_ASSERT_EQUAL_HEX32(PCAPNG_SHB, shb.type);
+    TEST_ASSERT_EQUAL_HEX32(0x1A2B3C4D, get32(shb.body));
+    TEST_ASSERT_EQUAL_UINT16(1, get16(shb.body + 4));
+    TEST_ASSERT_EQUAL_UINT16(0, get16(shb.body + 6));
+    uint16_t len = 0;
+    const uint8_t* appl = findOption(shb.body + 16, shb.bodyLen - 16, 4, &len);
+    TEST_ASSERT_NOT_NULL(appl);
+    TEST_ASSERT_TRUE(len > 0);
+
+    for (uint8_t i = 0; i < CAPTURE_IFACE_COUNT; i++) {
+        const Block& idb = blocks[1 + i];
+        TEST_ASSERT_EQUAL_HEX32(PCAPNG_IDB, idb.type);
+        TEST_ASSERT_EQUAL_UINT16(CAPTURE_LINKTYPE, get16(idb.body));
+        TEST_ASSERT_EQUAL_UINT32(CAPTURE_SNAPLEN, get32(idb.body + 4));
+        const uint8_t* name = findOption(idb.body + 8, idb.bodyLen - 8, 2, &len);
+        TEST_ASSERT_NOT_NULL(name);
+        TEST_ASSERT_EQUAL_size_t(strlen(PacketCapture::interfaceName(i)), len);
+        TEST_ASSERT_EQUAL_MEMORY(PacketCapture::interfaceName(i), name, len);
+    }
+}
+
+void test_packet_blocks_carry_payload_direction_and_comment() {
+    uint8_t small[5] = {0xFD, 0x01, 0x02, 0x03, 0x04};
+    uint8_t big[CAPTURE_SNAPLEN + 20];
+    for (size_t i = 0; i < sizeof(big); i++) big[i] = (uint8_t)i;
+
+    tapPacket(small, sizeof(small), IDX_DEVICE4, CAPTURE_DIR_IN, false);
+    native_clock::advanceUs(1234);
+    tapPacket(big, sizeof(big), IDX_UART1, CAPTURE_DIR_OUT, true);
+    tapPacket(small, sizeof(small), PHYS_NONE, CAPTURE_DIR_IN, false);
+
+    std::vector<uint8_t> s = drain();
+    std::vector<Block> blocks = splitBlocks(s);
+    TEST_ASSERT_EQUAL_size_t(1 + CAPTURE_IFACE_COUNT + 3, blocks.size());
+
+    const Block* epb[3];
+    for (int i = 0; i < 3; i++) {
+        epb[i] = &blocks[1 + CAPTURE_IFACE_COUNT + i];
+        TEST_ASSERT_EQUAL_HEX32(PCAPNG_EPB, epb[i]->type);
+    }
+
+    // Inbound, padded payload, no comment
+    const uint8_t* b = epb[0]->body;
+    TEST_ASSERT_EQUAL_UINT32(IDX_DEVICE4, get32(b));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(small), get32(b + 12));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(small), get32(b + 16));
+    TEST_ASSERT_EQUAL_MEMORY(small, b + 20, sizeof(small));
+    TEST_ASSERT_EQUAL_UINT8(0, b[20 + 5]);
+    TEST_ASSERT_EQUAL_UINT8(0, b[20 + 7]);
+    size_t optOff = 20 + 8;
+    uint16_t len = 0;
+    const uint8_t* flags = findOption(b + optOff, epb[0]->bodyLen - optOff, 2, &len);
+    TEST_ASSERT_NOT_NULL(flags);
+    TEST_ASSERT_EQUAL_UINT16(4, len);
+    TEST_ASSERT_EQUAL_UINT32(CAPTURE_DIR_IN, get32(flags));
+    TEST_ASSERT_NULL(findOption(b + optOff, epb[0]->bodyLen - optOff, 1, &len));
+    uint64_t ts0 = ((uint64_t)get32(b + 4) << 32) | get32(b + 8);
+
+    // Outbound, cut at snaplen, rejected -> comment
+    b = epb[1]->body;
+    TEST_ASSERT_EQUAL_UINT32(IDX_UART1, get32(b));
+    TEST_ASSERT_EQUAL_UINT32(CAPTURE_SNAPLEN, get32(b + 12));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(big), get32(b + 16));
+    TEST_ASSERT_EQUAL_MEMORY(big, b + 20, CAPTURE_SNAPLEN);
+    optOff = 20 + CAPTURE_SNAPLEN;
+    flags = findOption(b + optOff, epb[1]->bodyLen - optOff, 2, &len);
+    TEST_ASSERT_NOT_NULL(flags);
+    TEST_ASSERT_EQUAL_UINT32(CAPTURE_DIR_OUT, get32(flags));
+    const uint8_t* comment = findOption(b + optOff, epb[1]->bodyLen - optOff, 1, &len);
+    TEST_ASSERT_NOT_NULL(comment);
+    TEST_ASSERT_EQUAL_size_t(strlen("sender queue full"), len);
+    uint64_t ts1 = ((uint64_t)get32(b + 4) << 32) | get32(b + 8);
+    TEST_ASSERT_EQUAL_UINT32(1234, (uint32_t)(ts1 - ts0));
+
+    // No physical interface -> "internal"
+    TEST_ASSERT_EQUAL_UINT32(CAPTURE_IFACE_INTERNAL, get32(epb[2]->body));
+}
+
+void test_stream_loads_in_tshark() {
+    if (system("command -v tshark > /dev/null 2>&1") != 0) {
+        TEST_IGNORE_MESSAGE("tshark not installed");
+    }
+
+    uint8_t payload[12] = {0xFE, 0x09, 0x00, 0x01, 0x01, 0x00, 0, 0, 0, 0, 0, 0};
+    tapPacket(payload, sizeof(payload), IDX_DEVICE2_USB, CAPTURE_DIR_IN, false);
+    tapPacket(payload, sizeof(payload), IDX_DEVICE3, CAPTURE_DIR_OUT, true);
+    std::vector<uint8_t> s = drain();
+
+    char path[] = "/tmp/capture_test_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    FILE* f = fdopen(fd, "wb");
+    fwrite(s.data(), 1, s.size(), f);
+    fclose(f);
+
+    char cmd[128];
+    snprintf(cmd, sizeof(cmd), "tshark -r %s -T fields -e frame.len 2>&1", path);
+    FILE* p = popen(cmd, "r");
+    TEST_ASSERT_NOT_NULL(p);
+    char line[64];
+    int frames = 0;
+    while (fgets(line, sizeof(line), p)) {
+        TEST_ASSERT_EQUAL_INT(12, atoi(line));
+        frames++;
+    }
+    int status = pclose(p);
+    remove(path);
+    TEST_ASSERT_EQUAL_INT(0, status);
+    TEST_ASSERT_EQUAL_INT(2, frames);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_header_is_shb_and_one_idb_per_interface);
+    RUN_TEST(test_packet_blocks_carry_payload_direction_and_comment);
+    RUN_TEST(test_stream_loads_in_tshark);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+// /ws/rc binary frame: header bytes, staleness, 11-bit channel packing.
+// Channels use the SBUS bit layout, so the SBUS unpacker decodes them.
+#include <unity.h>
+#include <string.h>
+#include "native_runtime.h"
+#include "web/rc_ws_frame.h"
+#include "sbus_common.h"
+
+static RcChannelSnapshot makeSnapshot(uint32_t lastUpdateMs) {
+    RcChannelSnapshot rc;
+    memset(&rc, 0, sizeof(rc));
+    for (int i = 0; i < RC_CHANNEL_COUNT; i++) {
+        rc.channels[i] = (uint16_t)(988 + i * 64);
+    }
+    rc.lastUpdateMs = lastUpdateMs;
+    rc.source = RC_SOURCE_SBUS;
+    rc.input = 2;
+    return rc;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_header_source_input_and_age() {
+    RcChannelSnapshot rc = makeSnapshot(10000);
+    rc.flags = RC_FLAG_FAILSAFE;
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 10123, out);
+
+    TEST_ASSERT_EQUAL_HEX8((RC_SOURCE_SBUS << 4) | 2, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(RC_FLAG_FAILSAFE, out[1]);
+    TEST_ASSERT_EQUAL_UINT16(123, out[2] | (out[3] << 8));
+}
+
+void test_input_is_masked_to_nibble() {
+    RcChannelSnapshot rc = makeSnapshot(100);
+    rc.source = RC_SOURCE_MAVLINK;
+    rc.input = 0x1F;
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 100, out);
+    TEST_ASSERT_EQUAL_HEX8((RC_SOURCE_MAVLINK << 4) | 0x0F, out[0]);
+}
+
+void test_stale_flag_after_timeout() {
+    RcChannelSnapshot rc = makeSnapshot(1000);
+    uint8_t out[RC_WS_FRAME_SIZE];
+
+    rc_ws_encode(rc, 1000 + RC_WS_STALE_MS, out);
+    TEST_ASSERT_EQUAL_HEX8(0, out[1] & RC_WS_FLAG_STALE);
+
+    rc_ws_encode(rc, 1000 + RC_WS_STALE_MS + 1, out);
+    TEST_ASSERT_EQUAL_HEX8(RC_WS_FLAG_STALE, out[1] & RC_WS_FLAG_STALE);
+}
+
+void test_age_saturates() {
+    RcChannelSnapshot rc = makeSnapshot(1000);
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 1000 + 100000, out);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, out[2] | (out[3] << 8));
+}
+
+void test_never_updated_is_stale() {
+    RcChannelSnapshot rc = makeSnapshot(0);
+    rc.source = RC_SOURCE_NONE;
+    rc.input = 0;
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 5, out);
+
+    TEST_ASSERT_EQUAL_HEX8(0, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(RC_WS_FLAG_STALE, out[1]);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, out[2] | (out[3] << 8));
+}
+
+void test_channels_round_trip() {
+    RcChannelSnapshot rc = makeSnapshot(1);
+    rc.channels[0] = 0;
+    rc.channels[15] = 0x7FF;
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 1, out);
+
+    uint16_t decoded[RC_CHANNEL_COUNT];
+    unpackSbusChannels(out + 4, decoded);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(rc.channels, decoded, RC_CHANNEL_COUNT);
+}
+
+void test_channels_clamped_to_11_bits() {
+    RcChannelSnapshot rc = makeSnapshot(1);
+    rc.channels[3] = 0xFFFF;
+    rc.channels[4] = 0x800;
+    uint8_t out[RC_WS_FRAME_SIZE];
+    rc_ws_encode(rc, 1, out);
+
+    uint16_t decoded[RC_CHANNEL_COUNT];
+    unpackSbusChannels(out + 4, decoded);
+    TEST_ASSERT_EQUAL_UINT16(0x7FF, decoded[3]);
+    TEST_ASSERT_EQUAL_UINT16(0x7FF, decoded[4]);
+    // Neighbours untouched by the oversized values
+    TEST_ASSERT_EQUAL_UINT16(rc.channels[2], decoded[2]);
+    TEST_ASSERT_EQUAL_UINT16(rc.channels[5], decoded[5]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_header_source_input_and_age);
+    RUN_TEST(test_input_is_masked_to_nibble);
+    RUN_TEST(test_stale_flag_after_timeout);
+    RUN_TEST(test_age_saturates);
+    RUN_TEST(test_never_updated_is_stale);
+    RUN_TEST(test_channels_round_trip);
+    RUN_TEST(test_channels_clamped_to_11_bits);
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+// SbusFastParser framing: hunting, locking, resync after a bad frame, gap confirmation.
+// SbusRouter is replaced by a recorder, so only the parser's frame boundaries are tested.
+#include <unity.h>
+#include <vector>
+#include <array>
+#include "native_runtime.h"
+#include "sbus_fast_parser.h"
+
+// Recording router (the real one lives in sbus_router.cpp)
+typedef std::array<uint8_t, SBUS_FRAME_SIZE> Frame;
+static std::vector<Frame> routed;
+static uint8_t routedSource = 0xFF;
+
+SbusRouter* SbusRouter::instance = nullptr;
+SbusRouter::SbusRouter() {}
+bool SbusRouter::routeFrame(const uint8_t* frame, uint8_t sourceId) {
+    Frame f;
+    memcpy(f.data(), frame, SBUS_FRAME_SIZE);
+    routed.push_back(f);
+    routedSource = sourceId;
+    return true;
+}
+
+static CircularBuffer* buffer = nullptr;
+static SbusFastParser* parser = nullptr;
+
+static Frame makeFrame(uint16_t base, uint8_t flags = 0, uint8_t end = 0x00) {
+    uint16_t ch[SBUS_CHANNELS];
+    for (int i = 0; i < SBUS_CHANNELS; i++) ch[i] = (uint16_t)((base + i * 37) & 0x7FF);
+    Frame f;
+    f[0] = SBUS_START_BYTE;
+    packSbusChannels(ch, &f[1]);
+    f[23] = flags;
+    f[24] = end;
+    return f;
+}
+
+static void feed(const uint8_t* data, size_t len) {
+    buffer->write(data, len);
+}
+
+static void feed(const Frame& f) {
+    feed(f.data(), f.size());
+}
+
+static void process() {
+    while (parser->tryFastProcess(buffer, nullptr)) {}
+}
+
+static void assertRouted(size_t index, const Frame& expected) {
+    TEST_ASSERT_TRUE(index < routed.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), routed[index].data(), SBUS_FRAME_SIZE);
+}
+
+void setUp() {
+    native_clock::nowUs = 1000000;
+    routed.clear();
+    routedSource = 0xFF;
+    buffer = new CircularBuffer();
+    buffer->init(1024);
+    parser = new SbusFastParser(SBUS_SOURCE_DEVICE2);
+}
+
+void tearDown() {
+    delete parser;
+    delete buffer;
+}
+
+void test_locks_after_leading_garbage() {
+    const uint8_t garbage[] = {0xAA, 0x55, 0x01, 0x02};
+    Frame a = makeFrame(200), b = makeFrame(400), c = makeFrame(600);
+    feed(garbage, sizeof(garbage));
+    feed(a);
+    feed(b);
+    feed(c);
+    process();
+
+    TEST_ASSERT_EQUAL_size_t(3, routed.size());
+    assertRouted(0, a);
+    assertRouted(1, b);
+    assertRouted(2, c);
+    TEST_ASSERT_TRUE(parser->isLocked());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(garbage), parser->getResyncBytes());
+    TEST_ASSERT_EQUAL_UINT32(3, parser->getValidFrames());
+    TEST_ASSERT_EQUAL_UINT8(SBUS_SOURCE_DEVICE2, routedSource);
+}
+
+void test_false_start_byte_in_garbage_is_skipped() {
+    // 0x0F inside the noise must not produce a frame
+    const uint8_t garbage[] = {0x0F, 0x33, 0x0F, 0x00, 0x0F};
+    Frame a = makeFrame(1000), b = makeFrame(1100), c = makeFrame(1200);
+    feed(garbage, sizeof(garbage));
+    feed(a);
+    feed(b);
+    feed(c);
+    process();
+
+    TEST_ASSERT_EQUAL_size_t(3, routed.size());
+    assertRouted(0, a);
+    assertRouted(1, b);
+    assertRouted(2, c);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(garbage), parser->getResyncBytes());
+}
+
+void test_single_frame_waits_for_gap() {
+    Frame a = makeFrame(300);
+    feed(a);
+
+    // Next start byte unknown and the line not quiet yet: undecided
+    TEST_ASSERT_FALSE(parser->tryFastProcess(buffer, nullptr));
+    TEST_ASSERT_EQUAL_size_t(0, routed.size());
+
+    native_clock::advanceUs(2500);
+    process();
+    TEST_ASSERT_EQUAL_size_t(1, routed.size());
+    assertRouted(0, a);
+    TEST_ASSERT_TRUE(parser->isLocked());
+}
+
+void test_bad_frame_drops_lock_and_resyncs() {
+    Frame a = makeFrame(10), b = makeFrame(20);
+    feed(a);
+    feed(b);
+    process();
+    TEST_ASSERT_TRUE(parser->isLocked());
+
+    Frame bad = makeFrame(30, 0, 0x55);     // Invalid end byte
+    Frame c = makeFrame(40), d = makeFrame(50);
+    feed(bad);
+    feed(c);
+    feed(d);
+    process();
+
+    TEST_ASSERT_EQUAL_UINT32(1, parser->getSyncLosses());
+    TEST_ASSERT_EQUAL_size_t(4, routed.size());
+    assertRouted(2, c);
+    assertRouted(3, d);
+    TEST_ASSERT_TRUE(parser->isLocked());
+}
+
+void test_publishes_channels_in_microseconds() {
+    Frame a = makeFrame(172, SBUS_FLAG_FAILSAFE), b = makeFrame(992);
+    feed(a);
+    feed(b);
+    process();
+
+    TEST_ASSERT_EQUAL_size_t(2, routed.size());
+    // Last routed frame wins
+    TEST_ASSERT_EQUAL_UINT8(RC_SOURCE_SBUS, rcChannels.source);
+    TEST_ASSERT_EQUAL_UINT8(SBUS_SOURCE_DEVICE2, rcChannels.input);
+    TEST_ASSERT_EQUAL_UINT8(0, rcChannels.flags);
+    TEST_ASSERT_EQUAL_UINT16(sbusToUs(992), rcChannels.channels[0]);
+    TEST_ASSERT_EQUAL_UINT16(sbusToUs(992 + 37), rcChannels.channels[1]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_locks_after_leading_garbage);
+    RUN_TEST(test_false_start_byte_in_garbage_is_skipped);
+    RUN_TEST(test_single_frame_waits_for_gap);
+    RUN_TEST(test_bad_frame_drops_lock_and_resyncs);
+    RUN_TEST(test_publishes_channels_in_microseconds);
+    return UNITY_END();
+}
@@ -0,0 +1,193 @@
+// StatsDelta: per-field change tracking behind the /ws/stats deltas.
+#include <unity.h>
+#include <ArduinoJson.h>
+#include "native_runtime.h"
+#include "web/stats_delta.h"
+
+static StatsDelta* delta = nullptr;
+
+static void fillStatus(JsonDocument& doc, int rssi, double lat, int secondDevice) {
+    doc.clear();
+    doc["uptime"] = 100;
+    doc["wifiRssi"] = rssi;
+    doc["mode"] = "bridge";
+    JsonObject gps = doc["gps"].to<JsonObject>();
+    gps["lat"] = lat;
+    gps["lon"] = 8.5;
+    JsonArray devices = doc["devices"].to<JsonArray>();
+    devices.add(1);
+    devices.add(secondDevice);
+}
+
+// Delta of the current document since 'since' into out (returns collect() result)
+static bool collectSince(const JsonDocument& status, JsonDocument& out, uint32_t since,
+                         const char* const* skipKeys = nullptr, size_t skipCount = 0) {
+    out.clear();
+    JsonObject dst = out.to<JsonObject>();
+    return delta->collect(status.as<JsonObjectConst>(), dst, since, skipKeys, skipCount);
+}
+
+void setUp() {
+    delta = new StatsDelta();
+    TEST_ASSERT_TRUE(delta->begin());
+}
+
+void tearDown() {
+    delta->end();
+    delete delta;
+}
+
+void test_not_begun_tracks_nothing() {
+    StatsDelta idle;
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    TEST_ASSERT_EQUAL_UINT32(0, idle.track(status.as<JsonObjectConst>()));
+    JsonObject dst = out.to<JsonObject>();
+    TEST_ASSERT_FALSE(idle.collect(status.as<JsonObjectConst>(), dst, 0));
+}
+
+void test_first_sample_is_complete() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    TEST_ASSERT_EQUAL_UINT32(1, delta->track(status.as<JsonObjectConst>()));
+    TEST_ASSERT_EQUAL_UINT32(1, delta->sample());
+    TEST_ASSERT_EQUAL_UINT32(0, delta->fullSample());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, 0));
+    TEST_ASSERT_EQUAL_size_t(status.size(), out.size());
+    TEST_ASSERT_EQUAL_INT(-60, out["wifiRssi"].as<int>());
+    TEST_ASSERT_EQUAL_STRING("bridge", out["mode"].as<const char*>());
+    TEST_ASSERT_EQUAL_size_t(2, out["gps"].size());
+    TEST_ASSERT_EQUAL_size_t(2, out["devices"].size());
+}
+
+void test_unchanged_sample_has_no_delta() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    uint32_t first = delta->track(status.as<JsonObjectConst>());
+    fillStatus(status, -60, 47.1, 2);
+    TEST_ASSERT_EQUAL_UINT32(first + 1, delta->track(status.as<JsonObjectConst>()));
+
+    TEST_ASSERT_FALSE(collectSince(status, out, first));
+    TEST_ASSERT_EQUAL_size_t(0, out.size());
+}
+
+void test_nested_change_sends_only_that_path() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    uint32_t first = delta->track(status.as<JsonObjectConst>());
+    fillStatus(status, -60, 47.2, 2);
+    delta->track(status.as<JsonObjectConst>());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, first));
+    TEST_ASSERT_EQUAL_size_t(1, out.size());
+    TEST_ASSERT_EQUAL_size_t(1, out["gps"].size());
+    TEST_ASSERT_EQUAL_FLOAT(47.2f, out["gps"]["lat"].as<float>());
+    TEST_ASSERT_TRUE(out["gps"]["lon"].isNull());
+}
+
+void test_array_change_sends_whole_array() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    uint32_t first = delta->track(status.as<JsonObjectConst>());
+    fillStatus(status, -60, 47.1, 3);
+    delta->track(status.as<JsonObjectConst>());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, first));
+    TEST_ASSERT_EQUAL_size_t(1, out.size());
+    TEST_ASSERT_EQUAL_size_t(2, out["devices"].size());
+    TEST_ASSERT_EQUAL_INT(1, out["devices"][0].as<int>());
+    TEST_ASSERT_EQUAL_INT(3, out["devices"][1].as<int>());
+}
+
+void test_client_behind_several_samples_gets_union() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    uint32_t first = delta->track(status.as<JsonObjectConst>());
+    fillStatus(status, -61, 47.1, 2);
+    uint32_t second = delta->track(status.as<JsonObjectConst>());
+    fillStatus(status, -61, 47.3, 2);
+    delta->track(status.as<JsonObjectConst>());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, first));
+    TEST_ASSERT_EQUAL_size_t(2, out.size());
+    TEST_ASSERT_EQUAL_INT(-61, out["wifiRssi"].as<int>());
+    TEST_ASSERT_EQUAL_FLOAT(47.3f, out["gps"]["lat"].as<float>());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, second));
+    TEST_ASSERT_EQUAL_size_t(1, out.size());
+    TEST_ASSERT_TRUE(out["wifiRssi"].isNull());
+}
+
+void test_skip_keys_are_left_out() {
+    static const char* const skip[] = {"uptime", "gps"};
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    delta->track(status.as<JsonObjectConst>());
+
+    TEST_ASSERT_TRUE(collectSince(status, out, 0, skip, 2));
+    TEST_ASSERT_TRUE(out["uptime"].isNull());
+    TEST_ASSERT_TRUE(out["gps"].isNull());
+    TEST_ASSERT_EQUAL_INT(-60, out["wifiRssi"].as<int>());
+}
+
+void test_missing_field_requires_full_sample() {
+    JsonDocument status, out;
+    fillStatus(status, -60, 47.1, 2);
+    delta->track(status.as<JsonObjectConst>());
+    TEST_ASSERT_EQUAL_UINT32(0, delta->fullSample());
+
+    fillStatus(status, -60, 47.1, 2);
+    status.remove("mode");
+    uint32_t dropped = delta->track(status.as<JsonObjectConst>());
+    TEST_ASSERT_EQUAL_UINT32(dropped, delta->fullSample());
+
+    // Field coming back counts as changed
+    fillStatus(status, -60, 47.1, 2);
+    uint32_t back = delta->track(status.as<JsonObjectConst>());
+    TEST_ASSERT_EQUAL_UINT32(dropped, delta->fullSample());
+    TEST_ASSERT_TRUE(collectSince(status, out, back - 1));
+    TEST_ASSERT_EQUAL_STRING("bridge", out["mode"].as<const char*>());
+    TEST_ASSERT_EQUAL_size_t(1, out.size());
+}
+
+void test_untracked_fields_always_sent() {
+    const size_t extra = 10;
+    JsonDocument status, out;
+    char key[16];
+    for (size_t i = 0; i < STATS_WS_MAX_LEAVES + extra; i++) {
+        snprintf(key, sizeof(key), "f%u", (unsigned)i);
+        status[key] = 0;
+    }
+    uint32_t first = delta->track(status.as<JsonObjectConst>());
+    delta->track(status.as<JsonObjectConst>());
+
+    // Table full: fields beyond it can't be compared and go into every delta
+    TEST_ASSERT_TRUE(collectSince(status, out, first));
+    TEST_ASSERT_EQUAL_size_t(extra, out.size());
+}
+
+void test_begin_restarts_sample_numbers() {
+    JsonDocument status;
+    fillStatus(status, -60, 47.1, 2);
+    delta->track(status.as<JsonObjectConst>());
+    delta->track(status.as<JsonObjectConst>());
+    TEST_ASSERT_TRUE(delta->begin());
+    TEST_ASSERT_EQUAL_UINT32(0, delta->sample());
+    TEST_ASSERT_EQUAL_UINT32(1, delta->track(status.as<JsonObjectConst>()));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_not_begun_tracks_nothing);
+    RUN_TEST(test_first_sample_is_complete);
+    RUN_TEST(test_unchanged_sample_has_no_delta);
+    RUN_TEST(test_nested_change_sends_only_that_path);
+    RUN_TEST(test_array_change_sends_whole_array);
+    RUN_TEST(test_client_behind_several_samples_gets_union);
+    RUN_TEST(test_skip_keys_are_left_out);
+    RUN_TEST(test_missing_field_requires_full_sample);
+    RUN_TEST(test_untracked_fields_always_sent);
+    RUN_TEST(test_begin_restarts_sample_numbers);
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+// TerminalBuffer: per-client cursors, history replay, overrun accounting, wraparound.
+// Host builds get the 4 KB internal-RAM ring (no PSRAM in the stubs).
+#include <unity.h>
+#include <string.h>
+#include "native_runtime.h"
+#include "terminal_parser.h"
+
+static TerminalBuffer* tb = nullptr;
+static size_t cap = 0;
+
+static void writeStr(const char* s) {
+    tb->write(reinterpret_cast<const uint8_t*>(s), strlen(s));
+}
+
+// Fill with a counting pattern continuing from 'offset'
+static void writePattern(size_t offset, size_t len) {
+    uint8_t chunk[256];
+    while (len) {
+        size_t n = len < sizeof(chunk) ? len : sizeof(chunk);
+        for (size_t i = 0; i < n; i++) chunk[i] = (uint8_t)(offset + i);
+        tb->write(chunk, n);
+        offset += n;
+        len -= n;
+    }
+}
+
+static void assertPattern(const uint8_t* data, size_t offset, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != (uint8_t)(offset + i)) {
+            TEST_FAIL_MESSAGE("pattern mismatch");
+        }
+    }
+}
+
+void setUp() {
+    tb = new TerminalBuffer();
+    tb->init();
+    cap = tb->getCapacity();
+}
+
+void tearDown() {
+    delete tb;
+}
+
+void test_capacity_without_psram() {
+    TEST_ASSERT_EQUAL_size_t(4096, cap);
+}
+
+void test_readers_have_independent_cursors() {
+    TEST_ASSERT_TRUE(tb->attachReader(1, false));
+    TEST_ASSERT_TRUE(tb->attachReader(2, false));
+    writeStr("hello world");
+
+    uint8_t out[32];
+    TEST_ASSERT_EQUAL_size_t(5, tb->readFor(1, out, 5));
+    TEST_ASSERT_EQUAL_MEMORY("hello", out, 5);
+    TEST_ASSERT_EQUAL_size_t(6, tb->availableFor(1));
+    TEST_ASSERT_EQUAL_size_t(11, tb->availableFor(2));
+
+    TEST_ASSERT_EQUAL_size_t(11, tb->readFor(2, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("hello world", out, 11);
+    TEST_ASSERT_EQUAL_size_t(6, tb->readFor(1, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(" world", out, 6);
+    TEST_ASSERT_EQUAL_size_t(0, tb->readFor(1, out, sizeof(out)));
+}
+
+void test_replay_vs_live_attach() {
+    writeStr("history");
+    TEST_ASSERT_TRUE(tb->attachReader(1, true));
+    TEST_ASSERT_TRUE(tb->attachReader(2, false));
+    writeStr("+live");
+
+    uint8_t out[32];
+    TEST_ASSERT_EQUAL_size_t(12, tb->readFor(1, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("history+live", out, 12);
+    TEST_ASSERT_EQUAL_size_t(5, tb->readFor(2, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("+live", out, 5);
+}
+
+void test_unknown_and_detached_readers_get_nothing() {
+    writeStr("data");
+    uint8_t out[8];
+    TEST_ASSERT_EQUAL_size_t(0, tb->readFor(7, out, sizeof(out)));
+
+    TEST_ASSERT_TRUE(tb->attachReader(7, true));
+    tb->detachReader(7);
+    TEST_ASSERT_EQUAL_size_t(0, tb->readFor(7, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_size_t(0, tb->availableFor(7));
+}
+
+void test_reader_slots_are_limited() {
+    for (uint32_t id = 1; id <= TerminalBuffer::MAX_READERS; id++) {
+        TEST_ASSERT_TRUE(tb->attachReader(id, false));
+    }
+    TEST_ASSERT_FALSE(tb->attachReader(100, false));
+    // Re-attaching an existing client reuses its slot
+    TEST_ASSERT_TRUE(tb->attachReader(1, true));
+    tb->detachReader(3);
+    TEST_ASSERT_TRUE(tb->attachReader(100, false));
+}
+
+void test_wraparound_keeps_byte_order() {
+    static uint8_t out[4096];
+    TEST_ASSERT_TRUE(tb->attachReader(1, false));
+
+    writePattern(0, cap - 100);
+    TEST_ASSERT_EQUAL_size_t(cap - 100, tb->readFor(1, out, sizeof(out)));
+    assertPattern(out, 0, cap - 100);
+
+    // Crosses the end of the ring
+    writePattern(cap - 100, 300);
+    size_t overrun = 1;
+    TEST_ASSERT_EQUAL_size_t(300, tb->readFor(1, out, sizeof(out), &overrun));
+    TEST_ASSERT_EQUAL_size_t(0, overrun);
+    assertPattern(out, cap - 100, 300);
+}
+
+void test_lagging_reader_reports_overrun_once() {
+    static uint8_t out[4096];
+    TEST_ASSERT_TRUE(tb->attachReader(1, false));
+    TEST_ASSERT_TRUE(tb->attachReader(2, false));
+
+    writePattern(0, cap + 500);
+    TEST_ASSERT_EQUAL_size_t(cap + 500, tb->availableFor(1));
+
+    size_t overrun = 0;
+    TEST_ASSERT_EQUAL_size_t(cap, tb->readFor(1, out, sizeof(out), &overrun));
+    TEST_ASSERT_EQUAL_size_t(500, overrun);
+    assertPattern(out, 500, cap);
+    TEST_ASSERT_EQUAL_UINT32(500, tb->droppedFor(1));
+
+    // Already reported: next read carries no overrun
+    writeStr("x");
+    TEST_ASSERT_EQUAL_size_t(1, tb->readFor(1, out, sizeof(out), &overrun));
+    TEST_ASSERT_EQUAL_size_t(0, overrun);
+    TEST_ASSERT_EQUAL_UINT32(500, tb->droppedFor(1));
+
+    // The other reader lost its own share, independently
+    TEST_ASSERT_EQUAL_size_t(cap, tb->readFor(2, out, sizeof(out), &overrun));
+    TEST_ASSERT_EQUAL_size_t(501, overrun);
+}
+
+void test_oversized_write_keeps_tail() {
+    static uint8_t out[4096];
+    TEST_ASSERT_TRUE(tb->attachReader(1, false));
+
+    static uint8_t big[8192];
+    for (size_t i = 0; i < sizeof(big); i++) big[i] = (uint8_t)i;
+    tb->write(big, sizeof(big));
+
+    size_t overrun = 0;
+    TEST_ASSERT_EQUAL_size_t(cap, tb->readFor(1, out, sizeof(out), &overrun));
+    TEST_ASSERT_EQUAL_size_t(sizeof(big) - cap, overrun);
+    assertPattern(out, sizeof(big) - cap, cap);
+}
+
+void test_clear_drops_history() {
+    writeStr("old data");
+    TEST_ASSERT_TRUE(tb->attachReader(1, true));
+    tb->clear();
+    TEST_ASSERT_EQUAL_size_t(0, tb->availableFor(1));
+
+    TEST_ASSERT_TRUE(tb->attachReader(2, true));
+    writeStr("new");
+    uint8_t out[16];
+    TEST_ASSERT_EQUAL_size_t(3, tb->readFor(2, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("new", out, 3);
+    TEST_ASSERT_EQUAL_size_t(3, tb->readFor(1, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("new", out, 3);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_capacity_without_psram);
+    RUN_TEST(test_readers_have_independent_cursors);
+    RUN_TEST(test_replay_vs_live_attach);
+    RUN_TEST(test_unknown_and_detached_readers_get_nothing);
+    RUN_TEST(test_reader_slots_are_limited);
+    RUN_TEST(test_wraparound_keeps_byte_order);
+    RUN_TEST(test_lagging_reader_reports_overrun_once);
+    RUN_TEST(test_oversized_write_keeps_tail);
+    RUN_TEST(test_clear_drops_history);
+    return UNITY_END();
+}
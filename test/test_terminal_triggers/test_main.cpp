@@ -0,0 +1,134 @@
+// TerminalTriggers: config parsing and the Aho-Corasick matcher.
+// Actions (dispatch) need the pipeline, LEDs and UDP and are not linked here -
+// matching is observed through the scan statistics.
+#include <unity.h>
+#include <string.h>
+#include "native_runtime.h"
+#include "terminal_triggers.h"
+
+static TerminalTriggers* tt = nullptr;
+
+// Matches found by one scan (counters are cumulative)
+static uint32_t scanStr(const char* s) {
+    uint32_t before = tt->getMatches();
+    tt->scan(reinterpret_cast<const uint8_t*>(s), strlen(s));
+    return tt->getMatches() - before;
+}
+
+void setUp() {
+    tt = TerminalTriggers::getInstance();
+}
+
+void tearDown() {
+    tt->build("");
+}
+
+void test_empty_spec_is_inactive() {
+    TEST_ASSERT_EQUAL_size_t(0, tt->build(""));
+    TEST_ASSERT_FALSE(tt->isActive());
+    TEST_ASSERT_EQUAL_size_t(0, tt->build(nullptr));
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("anything"));
+}
+
+void test_parses_lines_comments_and_actions() {
+    const char* spec =
+        "# console triggers\n"
+        "\n"
+        "  ARMED | log,led:green  \n"
+        "PreArm: | udp\n"
+        "Error\n"
+        "   # indented comment\n";
+    TEST_ASSERT_EQUAL_size_t(3, tt->build(spec));
+    TEST_ASSERT_TRUE(tt->isActive());
+    TEST_ASSERT_EQUAL_STRING("ARMED", tt->getPattern(0));
+    TEST_ASSERT_EQUAL_STRING("PreArm:", tt->getPattern(1));
+    TEST_ASSERT_EQUAL_STRING("Error", tt->getPattern(2));
+    TEST_ASSERT_EQUAL_STRING("", tt->getPattern(3));
+}
+
+void test_rejects_overlong_pattern() {
+    char spec[128];
+    char longPattern[TERMINAL_TRIGGER_PATTERN_LEN + 1];
+    memset(longPattern, 'x', TERMINAL_TRIGGER_PATTERN_LEN);
+    longPattern[TERMINAL_TRIGGER_PATTERN_LEN] = '\0';
+    snprintf(spec, sizeof(spec), "%s | log\nok | log\n", longPattern);
+
+    TEST_ASSERT_EQUAL_size_t(1, tt->build(spec));
+    TEST_ASSERT_EQUAL_STRING("ok", tt->getPattern(0));
+}
+
+void test_limits_trigger_count() {
+    char spec[TERMINAL_TRIGGER_SPEC_MAX];
+    size_t pos = 0;
+    for (int i = 0; i < TERMINAL_TRIGGER_MAX + 4; i++) {
+        pos += snprintf(spec + pos, sizeof(spec) - pos, "t%02d\n", i);
+    }
+    TEST_ASSERT_EQUAL_size_t(TERMINAL_TRIGGER_MAX, tt->build(spec));
+}
+
+void test_trie_shares_prefixes() {
+    // root + h,e + s,h,e + r,s = 8 states
+    TEST_ASSERT_EQUAL_size_t(3, tt->build("he\nshe\nhers\n"));
+    TEST_ASSERT_EQUAL_size_t(8, tt->getStateCount());
+}
+
+void test_overlapping_patterns_match() {
+    tt->build("he\nshe\nhers\n");
+    // "ushers": "she"+"he" end on the same byte, "hers" on the last
+    TEST_ASSERT_EQUAL_UINT32(2, scanStr("ushers"));
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("xyz"));
+    TEST_ASSERT_EQUAL_UINT32(1, scanStr("the"));
+}
+
+void test_failure_links_recover_partial_match() {
+    tt->build("abcd\nbc\n");
+    // "abc" fails on 'x' but "bc" inside it must still match
+    TEST_ASSERT_EQUAL_UINT32(1, scanStr("abcx"));
+    TEST_ASSERT_EQUAL_UINT32(2, scanStr("aabcd"));
+}
+
+void test_match_split_across_chunks() {
+    tt->build("PreArm: | log\n");
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("noise Pre"));
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("Ar"));
+    TEST_ASSERT_EQUAL_UINT32(1, scanStr("m: Compass not calibrated\n"));
+}
+
+void test_bytes_outside_alphabet_reset_state() {
+    tt->build("ARMED\n");
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("ARM"));
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("\x01" "ED"));
+    TEST_ASSERT_EQUAL_UINT32(1, scanStr("ARMED"));
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("armed"));
+}
+
+void test_rebuild_resets_state() {
+    tt->build("abc\n");
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("ab"));
+    tt->build("abc\n");
+    // Partial match from the old automaton must not carry over
+    TEST_ASSERT_EQUAL_UINT32(0, scanStr("c"));
+}
+
+void test_counts_scanned_bytes() {
+    tt->build("x\n");
+    uint32_t before = tt->getBytesScanned();
+    scanStr("12345");
+    TEST_ASSERT_EQUAL_UINT32(before + 5, tt->getBytesScanned());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_spec_is_inactive);
+    RUN_TEST(test_parses_lines_comments_and_actions);
+    RUN_TEST(test_rejects_overlong_pattern);
+    RUN_TEST(test_limits_trigger_count);
+    RUN_TEST(test_trie_shares_prefixes);
+    RUN_TEST(test_overlapping_patterns_match);
+    RUN_TEST(test_failure_links_recover_partial_match);
+    RUN_TEST(test_match_split_across_chunks);
+    RUN_TEST(test_bytes_outside_alphabet_reset_state);
+    RUN_TEST(test_rebuild_resets_state);
+    RUN_TEST(test_counts_scanned_bytes);
+    return UNITY_END();
+}